@@ -88,5 +88,8 @@ typedef enum {
     DEBUG_SMITH_PREDICTOR,
     DEBUG_AUTOTRIM,
     DEBUG_AUTOTUNE,
+    DEBUG_RX_LATENCY,
+    DEBUG_FRSKY_OSD,
+    DEBUG_SPI_BUS,
     DEBUG_COUNT
 } debugType_e;
@@ -150,6 +150,107 @@ displayPort_t *cmsDisplayPortGetCurrent(void)
     return pCurrentDisplay;
 }
 
+// Characters the CMS has written to the display since it was last cleared.
+// Writes only send the part that differs from what's already shown, and
+// page changes draw the new page over the previous one instead of clearing
+// the screen, blanking whatever the new page didn't cover afterwards.
+#define CMS_SCREEN_MAX_ROWS 16
+#define CMS_SCREEN_MAX_COLS 32
+
+static struct {
+    displayPort_t *display;
+    uint8_t clearCount;
+    bool enabled;                                   // Display fits in the cache
+    bool pageChanged;                               // Cells not written since the page change are stale
+    char chars[CMS_SCREEN_MAX_ROWS][CMS_SCREEN_MAX_COLS];
+    uint32_t written[CMS_SCREEN_MAX_ROWS];          // Cells written since the page change
+} cmsScreen;
+
+// Returns true if the cache was reset because the display was cleared
+static bool cmsScreenSync(displayPort_t *pDisplay)
+{
+    if (cmsScreen.display == pDisplay && cmsScreen.clearCount == pDisplay->clearCount) {
+        return false;
+    }
+    cmsScreen.display = pDisplay;
+    cmsScreen.clearCount = pDisplay->clearCount;
+    cmsScreen.enabled = pDisplay->rows > 0 && pDisplay->rows <= CMS_SCREEN_MAX_ROWS &&
+        pDisplay->cols > 0 && pDisplay->cols <= CMS_SCREEN_MAX_COLS;
+    cmsScreen.pageChanged = false;
+    memset(cmsScreen.chars, ' ', sizeof(cmsScreen.chars));
+    return true;
+}
+
+static int cmsDisplayWrite(displayPort_t *pDisplay, uint8_t col, uint8_t row, const char *s)
+{
+    if (!cmsScreen.enabled || cmsScreen.display != pDisplay || row >= pDisplay->rows || col >= pDisplay->cols) {
+        return displayWrite(pDisplay, col, row, s);
+    }
+
+    const int len = MIN((int)strlen(s), pDisplay->cols - col);
+    if (len == 0) {
+        return 0;
+    }
+    cmsScreen.written[row] |= (len < 32 ? (1U << len) - 1 : 0xFFFFFFFF) << col;
+
+    char *cells = &cmsScreen.chars[row][col];
+    int first = 0;
+    while (first < len && cells[first] == s[first]) {
+        first++;
+    }
+    if (first == len) {
+        return 0;
+    }
+    int last = len - 1;
+    while (cells[last] == s[last]) {
+        last--;
+    }
+
+    char buf[CMS_SCREEN_MAX_COLS + 1];
+    const int count = last - first + 1;
+    memcpy(buf, s + first, count);
+    buf[count] = '\0';
+    memcpy(cells + first, buf, count);
+    return displayWrite(pDisplay, col + first, row, buf);
+}
+
+// Blanks what the previous page left outside of the cells written by the
+// current one. Returns false if it ran out of room and has to continue later.
+static bool cmsScreenBlankStale(displayPort_t *pDisplay, uint32_t *room)
+{
+    if (!cmsScreen.pageChanged || cmsScreen.display != pDisplay) {
+        return true;
+    }
+
+    char blanks[CMS_SCREEN_MAX_COLS + 1];
+    for (int row = 0; row < pDisplay->rows; row++) {
+        const uint32_t written = cmsScreen.written[row];
+        char *cells = cmsScreen.chars[row];
+        for (int col = 0; col < pDisplay->cols; col++) {
+            if ((written & (1U << col)) || cells[col] == ' ') {
+                continue;
+            }
+            int end = col + 1;
+            for (int ii = end; ii < pDisplay->cols && !(written & (1U << ii)); ii++) {
+                if (cells[ii] != ' ') {
+                    end = ii + 1;
+                }
+            }
+            const int count = end - col;
+            memset(blanks, ' ', count);
+            blanks[count] = '\0';
+            memset(cells + col, ' ', count);
+            *room -= displayWrite(pDisplay, col, row, blanks);
+            if (*room < 30) {
+                return false;
+            }
+            col = end;
+        }
+    }
+    cmsScreen.pageChanged = false;
+    return true;
+}
+
 #define CMS_UPDATE_INTERVAL_US  50000   // Interval of key scans (microsec)
 #define CMS_POLL_INTERVAL_US   100000   // Interval of polling dynamic values (microsec)
 
@@ -256,7 +357,16 @@ static void cmsPageSelect(displayPort_t *instance, int8_t newpage)
     currentCtx.page = (newpage + pageCount) % pageCount;
     pageTop = &currentCtx.menu->entries[currentCtx.page * maxMenuItems];
     cmsUpdateMaxRow(instance);
-    displayClearScreen(instance);
+    cmsScreenSync(instance);
+    if (cmsScreen.enabled) {
+        // Draw the new page over the old one, see cmsScreenBlankStale()
+        memset(entry_flags, PRINT_LABEL | PRINT_VALUE, sizeof(entry_flags));
+        memset(cmsScreen.written, 0, sizeof(cmsScreen.written));
+        cmsScreen.pageChanged = true;
+        instance->cursorRow = -1;
+    } else {
+        displayClearScreen(instance);
+    }
 }
 
 static void cmsPageNext(displayPort_t *instance)
@@ -333,7 +443,7 @@ static int cmsDrawMenuItemValue(displayPort_t *pDisplay, char *buff, uint8_t row
 
     cmsPadToSize(buff, maxSize);
     colpos = rightMenuColumn - maxSize;
-    cnt = displayWrite(pDisplay, colpos, row, buff);
+    cnt = cmsDisplayWrite(pDisplay, colpos, row, buff);
     return cnt;
 }
 
@@ -566,7 +676,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
                 }
             }
             if (text) {
-                cnt = displayWrite(pDisplay,
+                cnt = cmsDisplayWrite(pDisplay,
                         leftMenuColumn + 1 + (uint8_t) strlen(p->text), row, text);
             }
             CLR_PRINTVALUE(p, screenRow);
@@ -584,7 +694,7 @@ static int cmsDrawMenuEntry(displayPort_t *pDisplay, const OSD_Entry *p, uint8_t
     default:
 #ifdef CMS_MENU_DEBUG
         // Shouldn't happen. Notify creator of this menu content.
-        cnt = displayWrite(pDisplay, rightMenuColumn - 6), row, "BADENT");
+        cnt = cmsDisplayWrite(pDisplay, rightMenuColumn - 6), row, "BADENT");
 #endif
         break;
     }
@@ -613,7 +723,7 @@ static void cmsDrawMenu(displayPort_t *pDisplay, uint32_t currentTimeUs)
 
     uint32_t room = displayTxBytesFree(pDisplay);
 
-    if (pDisplay->cleared) {
+    if (cmsScreenSync(pDisplay) || pDisplay->cleared) {
         // Mark all labels and values for printing
         memset(entry_flags, PRINT_LABEL | PRINT_VALUE, sizeof(entry_flags));
         pDisplay->cleared = false;
@@ -632,14 +742,14 @@ static void cmsDrawMenu(displayPort_t *pDisplay, uint32_t currentTimeUs)
     cmsPageDebug();
 
     if (pDisplay->cursorRow >= 0 && currentCtx.cursorRow != pDisplay->cursorRow) {
-        room -= displayWrite(pDisplay, leftMenuColumn, top + pDisplay->cursorRow * linesPerMenuItem, " ");
+        room -= cmsDisplayWrite(pDisplay, leftMenuColumn, top + pDisplay->cursorRow * linesPerMenuItem, " ");
     }
 
     if (room < 30)
         return;
 
     if (pDisplay->cursorRow != currentCtx.cursorRow) {
-        room -= displayWrite(pDisplay, leftMenuColumn, top + currentCtx.cursorRow * linesPerMenuItem, ">");
+        room -= cmsDisplayWrite(pDisplay, leftMenuColumn, top + currentCtx.cursorRow * linesPerMenuItem, ">");
         pDisplay->cursorRow = currentCtx.cursorRow;
     }
 
@@ -651,7 +761,7 @@ static void cmsDrawMenu(displayPort_t *pDisplay, uint32_t currentTimeUs)
         if (IS_PRINTLABEL(p, i)) {
             uint8_t coloff = leftMenuColumn;
             coloff += cmsElementIsLabel(p->type) ? 0 : 1;
-            room -= displayWrite(pDisplay, coloff, top + i * linesPerMenuItem, p->text);
+            room -= cmsDisplayWrite(pDisplay, coloff, top + i * linesPerMenuItem, p->text);
             CLR_PRINTLABEL(p, i);
             if (room < 30) {
                 return;
@@ -676,6 +786,9 @@ static void cmsDrawMenu(displayPort_t *pDisplay, uint32_t currentTimeUs)
             break;
         }
     }
+
+    // Remove the leftovers from the previous page
+    cmsScreenBlankStale(pDisplay, &room);
 }
 
 static void cmsMenuCountPage(displayPort_t *pDisplay)
@@ -0,0 +1,105 @@
+/*
+ * This file is part of INAV Project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU General Public License Version 3, as described below:
+ *
+ * This file is free software: you may copy, redistribute and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+FILE_COMPILE_FOR_SPEED
+
+#include "common/maths.h"
+#include "common/median_filter.h"
+
+// Index of the first sorted element not less than value
+static uint8_t medianFilterLowerBound(const medianFilter_t *filter, int16_t value)
+{
+    uint8_t lo = 0;
+    uint8_t hi = filter->count;
+
+    while (lo < hi) {
+        const uint8_t mid = (lo + hi) / 2;
+        if (filter->sorted[mid] < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+static void medianFilterRemove(medianFilter_t *filter, int16_t value)
+{
+    const uint8_t pos = medianFilterLowerBound(filter, value);
+    memmove(&filter->sorted[pos], &filter->sorted[pos + 1], (filter->count - pos - 1) * sizeof(filter->sorted[0]));
+    filter->count--;
+}
+
+static void medianFilterInsert(medianFilter_t *filter, int16_t value)
+{
+    const uint8_t pos = medianFilterLowerBound(filter, value);
+    memmove(&filter->sorted[pos + 1], &filter->sorted[pos], (filter->count - pos) * sizeof(filter->sorted[0]));
+    filter->sorted[pos] = value;
+    filter->count++;
+}
+
+void medianFilterInit(medianFilter_t *filter, uint8_t windowSize)
+{
+    memset(filter, 0, sizeof(*filter));
+    filter->windowSize = MIN(windowSize | 1, MEDIAN_FILTER_MAX_WINDOW);
+}
+
+int16_t medianFilterApply(medianFilter_t *filter, int16_t sample)
+{
+    if (filter->windowSize < 3) {
+        return sample;
+    }
+
+    const uint8_t last = (filter->index + filter->windowSize - 1) % filter->windowSize;
+
+    if (filter->count > 0 && filter->samples[last] == sample) {
+        // Once the whole window holds the same value there is nothing left to update
+        if (filter->unchangedCount >= filter->windowSize) {
+            return sample;
+        }
+        filter->unchangedCount++;
+    } else {
+        filter->unchangedCount = 1;
+    }
+
+    if (filter->count == filter->windowSize) {
+        medianFilterRemove(filter, filter->samples[filter->index]);
+    }
+
+    filter->samples[filter->index] = sample;
+    filter->index = (filter->index + 1) % filter->windowSize;
+    medianFilterInsert(filter, sample);
+
+    if (filter->count < filter->windowSize) {
+        return sample;
+    }
+
+    return filter->sorted[filter->windowSize / 2];
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is part of INAV Project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU General Public License Version 3, as described below:
+ *
+ * This file is free software: you may copy, redistribute and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MEDIAN_FILTER_MAX_WINDOW    9
+
+/*
+ * Sliding window median. Samples are kept twice: in arrival order to know
+ * which one drops out of the window and sorted to read the median directly.
+ * Each update is a binary search for removal and insertion plus a short
+ * memmove, instead of re-sorting the whole window.
+ */
+typedef struct medianFilter_s {
+    int16_t samples[MEDIAN_FILTER_MAX_WINDOW];  // ring buffer, arrival order
+    int16_t sorted[MEDIAN_FILTER_MAX_WINDOW];
+    uint8_t windowSize;
+    uint8_t count;
+    uint8_t index;
+    uint8_t unchangedCount;                     // consecutive samples equal to the latest one
+} medianFilter_t;
+
+// Even window sizes are rounded up, window sizes below 3 disable filtering
+void medianFilterInit(medianFilter_t *filter, uint8_t windowSize);
+// Returns the input until the window is full, the window median afterwards
+int16_t medianFilterApply(medianFilter_t *filter, int16_t sample);
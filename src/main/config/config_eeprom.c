@@ -25,6 +25,7 @@
 #include "build/build_config.h"
 
 #include "common/crc.h"
+#include "common/maths.h"
 
 #include "config/config_eeprom.h"
 #include "config/config_streamer.h"
@@ -34,7 +35,21 @@
 
 #include "fc/config.h"
 
-static uint16_t eepromConfigSize;
+static uint16_t eepromConfigSize;      // base image plus the valid part of the update log
+static uint16_t eepromBaseSize;        // header, records, footer and checksum
+static uint16_t eepromLogEnd;          // offset of the next update block, 0 if a full rewrite is needed
+
+typedef enum {
+    CONFIG_IMPORT_IDLE = 0,
+    CONFIG_IMPORT_HEADER,
+    CONFIG_IMPORT_RECORD_SIZE,
+    CONFIG_IMPORT_RECORD_HEADER,
+    CONFIG_IMPORT_RECORD_DATA,
+    CONFIG_IMPORT_CHECKSUM,
+    CONFIG_IMPORT_LOG_PADDING,
+    CONFIG_IMPORT_LOG_HEADER,
+    CONFIG_IMPORT_ERROR,
+} configImportState_e;
 
 typedef enum {
     CR_CLASSICATION_SYSTEM   = 0,
@@ -70,6 +85,48 @@ typedef struct {
 } PG_PACKED configFooter_t;
 // checksum is appended just after footer. It is not included in footer to make checksum calculation consistent
 
+// Saving only appends the records of PGs that differ from the stored ones
+// as an update block after the base image, the newest record of a PG wins
+// when loading. Blocks start at CONFIG_LOG_ALIGNMENT boundaries so they
+// never share a flash word with previous data. Once the log is full (or
+// broken by an interrupted write) the whole config is rewritten from scratch.
+#define CONFIG_LOG_ALIGNMENT    32
+#define CONFIG_LOG_ALIGN(offset) (((offset) + CONFIG_LOG_ALIGNMENT - 1) & ~(CONFIG_LOG_ALIGNMENT - 1))
+#define CONFIG_LOG_ERASED       0xFFFF
+
+// Header for each update block, followed by size bytes of records
+typedef struct {
+    uint16_t size;
+    uint16_t crc;   // CRC of the records only
+} PG_PACKED configLogHeader_t;
+
+// State of an image being received through importEEPROMConfigStore(). The
+// image is parsed on the fly and its records are loaded straight into the
+// PGs in RAM, so no buffer for the whole image is needed.
+typedef struct {
+    configImportState_e state;
+    uint32_t size;              // announced image size
+    uint32_t received;          // bytes consumed so far
+    uint16_t crc;               // running CRC of the base image or of the current update block
+    uint16_t remaining;         // bytes left in the current field or record payload
+    uint16_t blockRemaining;    // bytes left in the current update block
+    uint16_t blockCrc;          // expected CRC of the current update block
+    bool inLog;                 // parsing update blocks after the base image
+    uint8_t at;                 // bytes collected into the current field
+    union {
+        configHeader_t header;
+        configRecord_t record;
+        configFooter_t footer;
+        configLogHeader_t logHeader;
+        uint16_t checkSum;
+        uint8_t b[sizeof(configRecord_t)];
+    } field;
+    uint8_t *pgTarget;          // where the current record payload goes, NULL to skip it
+    uint16_t pgTargetSize;
+} configImport_t;
+
+static configImport_t configImport;
+
 // Used to check the compiler packing at build time.
 typedef struct {
     uint8_t byte;
@@ -86,17 +143,66 @@ void initEEPROM(void)
     BUILD_BUG_ON(sizeof(configHeader_t) != 1);
     BUILD_BUG_ON(sizeof(configFooter_t) != 2);
     BUILD_BUG_ON(sizeof(configRecord_t) != 6);
+    BUILD_BUG_ON(sizeof(configLogHeader_t) != 4);
+    BUILD_BUG_ON(CONFIG_LOG_ALIGNMENT % CONFIG_STREAMER_BUFFER_SIZE != 0);
+}
+
+// Update blocks can only be appended within the page holding the start of
+// the config, the streamer would erase the next one.
+static const uint8_t *configLogLimit(void)
+{
+    const uint32_t pageSize = config_streamer_page_size();
+    return MIN(&__config_end, &__config_start + pageSize);
 }
 
-static uint16_t updateCRC(uint16_t crc, const void *data, uint32_t length)
+// Checks that records fill [p, end) exactly
+static bool configRecordsValid(const uint8_t *p, const uint8_t *end)
 {
-    const uint8_t *p = (const uint8_t *)data;
-    const uint8_t *pend = p + length;
+    while (p < end) {
+        const configRecord_t *record = (const configRecord_t *)p;
+        if (p + sizeof(*record) > end || record->size < sizeof(*record) || p + record->size > end) {
+            return false;
+        }
+        p += record->size;
+    }
+    return true;
+}
+
+// Walk the update blocks following the base image. Stops at erased flash or
+// at the first broken block, which would be left by an interrupted save.
+static void scanEEPROMLog(void)
+{
+    const uint8_t *logLimit = configLogLimit();
+    uint32_t offset = CONFIG_LOG_ALIGN(eepromConfigSize);
+
+    for (;;) {
+        const uint8_t *p = &__config_start + offset;
+        const configLogHeader_t *header = (const configLogHeader_t *)p;
+
+        if (p + sizeof(*header) > logLimit) {
+            // Log is full
+            eepromLogEnd = 0;
+            return;
+        }
 
-    for (; p != pend; p++) {
-        crc = crc16_ccitt(crc, *p);
+        if (header->size == CONFIG_LOG_ERASED && header->crc == CONFIG_LOG_ERASED) {
+            // End of log
+            eepromLogEnd = offset;
+            return;
+        }
+
+        const uint8_t *records = p + sizeof(*header);
+        if (header->size == 0 || records + header->size > logLimit ||
+            crc16_ccitt_update(0, records, header->size) != header->crc ||
+            !configRecordsValid(records, records + header->size)) {
+            // Broken block, ignore it and anything after it. Next save rewrites everything.
+            eepromLogEnd = 0;
+            return;
+        }
+
+        eepromConfigSize = (records + header->size) - &__config_start;
+        offset = CONFIG_LOG_ALIGN(eepromConfigSize);
     }
-    return crc;
 }
 
 // Scan the EEPROM config. Returns true if the config is valid.
@@ -105,10 +211,14 @@ bool isEEPROMContentValid(void)
     const uint8_t *p = &__config_start;
     const configHeader_t *header = (const configHeader_t *)p;
 
+    eepromBaseSize = 0;
+    eepromConfigSize = 0;
+    eepromLogEnd = 0;
+
     if (header->format != EEPROM_CONF_VERSION) {
         return false;
     }
-    uint16_t crc = updateCRC(0, header, sizeof(*header));
+    uint16_t crc = crc16_ccitt_update(0, header, sizeof(*header));
     p += sizeof(*header);
 
     for (;;) {
@@ -129,18 +239,24 @@ bool isEEPROMContentValid(void)
             return false;
         }
 
-        crc = updateCRC(crc, p, record->size);
+        crc = crc16_ccitt_update(crc, p, record->size);
 
         p += record->size;
     }
 
     const configFooter_t *footer = (const configFooter_t *)p;
-    crc = updateCRC(crc, footer, sizeof(*footer));
+    crc = crc16_ccitt_update(crc, footer, sizeof(*footer));
     p += sizeof(*footer);
     const uint16_t checkSum = *(uint16_t *)p;
     p += sizeof(checkSum);
-    eepromConfigSize = p - &__config_start;
-    return crc == checkSum;
+    eepromBaseSize = p - &__config_start;
+    eepromConfigSize = eepromBaseSize;
+    if (crc != checkSum) {
+        return false;
+    }
+
+    scanEEPROMLog();
+    return true;
 }
 
 uint16_t getEEPROMConfigSize(void)
@@ -148,34 +264,68 @@ uint16_t getEEPROMConfigSize(void)
     return eepromConfigSize;
 }
 
-// find config record for reg + classification (profile info) in EEPROM
-// return NULL when record is not found
-// this function assumes that EEPROM content is valid
-static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFlags_e classification)
+const uint8_t *getEEPROMConfigImage(void)
 {
-    const uint8_t *p = &__config_start;
-    p += sizeof(configHeader_t);             // skip header
-    while (true) {
+    return &__config_start;
+}
+
+// Returns a CRC of the whole image including update blocks. Only meaningful
+// when isEEPROMContentValid() returned true.
+uint16_t getEEPROMConfigChecksum(void)
+{
+    return crc16_ccitt_update(0, &__config_start, eepromConfigSize);
+}
+
+static const configRecord_t *findRecord(const uint8_t *p, const uint8_t *end, const pgRegistry_t *reg, configRecordFlags_e classification)
+{
+    const configRecord_t *found = NULL;
+
+    while (p < end) {
         const configRecord_t *record = (const configRecord_t *)p;
         // Ensure that the record header fits into config memory, otherwise accessing size and flags may cause a hardfault.
-        if (p + sizeof(*record) >= &__config_end) {
+        if (p + sizeof(*record) > end) {
             break;
         }
 
         // Check that record header makes sense
-        if (record->size == 0 || p + record->size >= &__config_end || record->size < sizeof(*record)) {
+        if (record->size == 0 || p + record->size > end || record->size < sizeof(*record)) {
             break;
         }
 
         // Check if this is the record we're looking for (check for size)
         if (pgN(reg) == record->pgn && (record->flags & CR_CLASSIFICATION_MASK) == classification) {
-            return record;
+            found = record;
         }
 
         p += record->size;
     }
-    // record not found
-    return NULL;
+
+    return found;
+}
+
+// find the newest config record for reg + classification (profile info) in EEPROM
+// return NULL when record is not found
+// this function assumes that EEPROM content is valid
+static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFlags_e classification)
+{
+    const uint8_t *baseEnd = &__config_start + eepromBaseSize;
+    const uint8_t *configEnd = &__config_start + eepromConfigSize;
+
+    // Base image, scanning stops at the footer
+    const configRecord_t *found = findRecord(&__config_start + sizeof(configHeader_t), baseEnd, reg, classification);
+
+    // Update blocks, later ones override earlier ones
+    for (const uint8_t *p = &__config_start + CONFIG_LOG_ALIGN(eepromBaseSize); p < configEnd; ) {
+        const configLogHeader_t *header = (const configLogHeader_t *)p;
+        const uint8_t *records = p + sizeof(*header);
+        const configRecord_t *record = findRecord(records, records + header->size, reg, classification);
+        if (record) {
+            found = record;
+        }
+        p = &__config_start + CONFIG_LOG_ALIGN(records + header->size - &__config_start);
+    }
+
+    return found;
 }
 
 // Initialize all PG records from EEPROM.
@@ -218,7 +368,7 @@ static bool writeSettingsToEEPROM(void)
     };
 
     config_streamer_write(&streamer, (uint8_t *)&header, sizeof(header));
-    uint16_t crc = updateCRC(0, (uint8_t *)&header, sizeof(header));
+    uint16_t crc = crc16_ccitt_update(0, (uint8_t *)&header, sizeof(header));
     PG_FOREACH(reg) {
         const uint16_t regSize = pgSize(reg);
         configRecord_t record = {
@@ -232,9 +382,9 @@ static bool writeSettingsToEEPROM(void)
             // write the only instance
             record.flags |= CR_CLASSICATION_SYSTEM;
             config_streamer_write(&streamer, (uint8_t *)&record, sizeof(record));
-            crc = updateCRC(crc, (uint8_t *)&record, sizeof(record));
+            crc = crc16_ccitt_update(crc, (uint8_t *)&record, sizeof(record));
             config_streamer_write(&streamer, reg->address, regSize);
-            crc = updateCRC(crc, reg->address, regSize);
+            crc = crc16_ccitt_update(crc, reg->address, regSize);
         } else {
             // write one instance for each profile
             for (uint8_t profileIndex = 0; profileIndex < MAX_PROFILE_COUNT; profileIndex++) {
@@ -242,10 +392,10 @@ static bool writeSettingsToEEPROM(void)
 
                 record.flags |= ((profileIndex + 1) & CR_CLASSIFICATION_MASK);
                 config_streamer_write(&streamer, (uint8_t *)&record, sizeof(record));
-                crc = updateCRC(crc, (uint8_t *)&record, sizeof(record));
+                crc = crc16_ccitt_update(crc, (uint8_t *)&record, sizeof(record));
                 const uint8_t *address = reg->address + (regSize * profileIndex);
                 config_streamer_write(&streamer, address, regSize);
-                crc = updateCRC(crc, address, regSize);
+                crc = crc16_ccitt_update(crc, address, regSize);
             }
         }
     }
@@ -255,7 +405,7 @@ static bool writeSettingsToEEPROM(void)
     };
 
     config_streamer_write(&streamer, (uint8_t *)&footer, sizeof(footer));
-    crc = updateCRC(crc, (uint8_t *)&footer, sizeof(footer));
+    crc = crc16_ccitt_update(crc, (uint8_t *)&footer, sizeof(footer));
 
     // append checksum now
     config_streamer_write(&streamer, (uint8_t *)&crc, sizeof(crc));
@@ -267,9 +417,96 @@ static bool writeSettingsToEEPROM(void)
     return success;
 }
 
+// Writes (or with streamer == NULL only measures) the records of all PG
+// instances that differ from what loadEEPROM() would read back.
+static uint16_t writeChangedSettings(config_streamer_t *streamer, uint16_t *crc)
+{
+    uint16_t size = 0;
+
+    PG_FOREACH(reg) {
+        const uint16_t regSize = pgSize(reg);
+        const int instanceCount = pgIsSystem(reg) ? 1 : MAX_PROFILE_COUNT;
+
+        for (int profileIndex = 0; profileIndex < instanceCount; profileIndex++) {
+            const configRecordFlags_e classification = pgIsSystem(reg) ? CR_CLASSICATION_SYSTEM : ((profileIndex + 1) & CR_CLASSIFICATION_MASK);
+            const uint8_t *address = reg->address + (regSize * profileIndex);
+            const configRecord_t *stored = findEEPROM(reg, classification);
+
+            if (stored && stored->version == pgVersion(reg) && stored->size == sizeof(configRecord_t) + regSize &&
+                memcmp(stored->pg, address, regSize) == 0) {
+                continue;
+            }
+
+            configRecord_t record = {
+                .size = sizeof(configRecord_t) + regSize,
+                .pgn = pgN(reg),
+                .version = pgVersion(reg),
+                .flags = classification,
+            };
+
+            *crc = crc16_ccitt_update(*crc, (uint8_t *)&record, sizeof(record));
+            *crc = crc16_ccitt_update(*crc, address, regSize);
+            if (streamer) {
+                config_streamer_write(streamer, (uint8_t *)&record, sizeof(record));
+                config_streamer_write(streamer, address, regSize);
+            }
+            size += record.size;
+        }
+    }
+
+    return size;
+}
+
+// Appends the changed PGs as an update block. Returns false if there's no
+// room left in the log, the caller has to rewrite the whole config then.
+static bool appendSettingsToEEPROM(void)
+{
+    if (eepromLogEnd == 0) {
+        return false;
+    }
+
+    uint16_t crc = 0;
+    const uint16_t size = writeChangedSettings(NULL, &crc);
+    if (size == 0) {
+        // Nothing changed
+        return true;
+    }
+
+    const uint8_t *logLimit = configLogLimit();
+    uint8_t *blockStart = &__config_start + eepromLogEnd;
+    if (blockStart + sizeof(configLogHeader_t) + size > logLimit) {
+        return false;
+    }
+
+    config_streamer_t streamer;
+    config_streamer_init(&streamer);
+
+    config_streamer_start(&streamer, (uintptr_t)blockStart, logLimit - blockStart);
+
+    configLogHeader_t header = {
+        .size = size,
+        .crc = crc,
+    };
+    config_streamer_write(&streamer, (uint8_t *)&header, sizeof(header));
+
+    crc = 0;
+    writeChangedSettings(&streamer, &crc);
+
+    config_streamer_flush(&streamer);
+
+    return config_streamer_finish(&streamer) == 0;
+}
+
 void writeConfigToEEPROM(void)
 {
     bool success = false;
+
+    // Appending only costs a fraction of a full rewrite, fall back to the
+    // latter when the log is full or the append failed
+    if (isEEPROMContentValid() && appendSettingsToEEPROM() && isEEPROMContentValid()) {
+        return;
+    }
+
     // write it
     for (int attempt = 0; attempt < 3 && !success; attempt++) {
         if (writeSettingsToEEPROM()) {
@@ -284,3 +521,212 @@ void writeConfigToEEPROM(void)
     // Flash write failed - just die now
     failureMode(FAILURE_FLASH_WRITE_FAILED);
 }
+
+// Starts importing a config image of the given size. All PGs are reset to
+// defaults, so PGs missing from the image end up with their default values,
+// like loadEEPROM() does. The caller must persist the result with
+// writeConfigToEEPROM() after importEEPROMConfigFinish() succeeds and must
+// reload the stored config (e.g. via readEEPROM()) on any failure.
+bool importEEPROMConfigPrepare(uint32_t size)
+{
+    const uint32_t minSize = sizeof(configHeader_t) + sizeof(configFooter_t) + sizeof(uint16_t);
+
+    if (size < minSize || size > (uint32_t)(&__config_end - &__config_start)) {
+        configImport.state = CONFIG_IMPORT_IDLE;
+        return false;
+    }
+
+    memset(&configImport, 0, sizeof(configImport));
+    configImport.state = CONFIG_IMPORT_HEADER;
+    configImport.size = size;
+    configImport.remaining = sizeof(configHeader_t);
+
+    pgResetAll(MAX_PROFILE_COUNT);
+
+    return true;
+}
+
+static void importEEPROMConfigRecordStart(void)
+{
+    const configRecord_t *record = &configImport.field.record;
+    const pgRegistry_t *reg = pgFind(record->pgn);
+    const configRecordFlags_e classification = record->flags & CR_CLASSIFICATION_MASK;
+
+    configImport.pgTarget = NULL;
+    configImport.pgTargetSize = 0;
+    configImport.remaining = record->size - sizeof(configRecord_t);
+
+    // Same rules as pgLoad(): unknown PGs and version mismatches keep
+    // the defaults set up by importEEPROMConfigPrepare().
+    if (!reg || record->version != pgVersion(reg)) {
+        return;
+    }
+
+    int profileIndex;
+    if (pgIsSystem(reg)) {
+        if (classification != CR_CLASSICATION_SYSTEM) {
+            return;
+        }
+        profileIndex = 0;
+    } else {
+        if (classification < CR_CLASSICATION_PROFILE1) {
+            return;
+        }
+        profileIndex = classification - CR_CLASSICATION_PROFILE1;
+    }
+
+    pgReset(reg, profileIndex);
+    configImport.pgTarget = reg->address + (pgIsSystem(reg) ? 0 : pgSize(reg) * profileIndex);
+    configImport.pgTargetSize = pgSize(reg);
+}
+
+static void importEEPROMConfigRecordDone(void)
+{
+    configImport.state = CONFIG_IMPORT_RECORD_SIZE;
+    configImport.remaining = sizeof(uint16_t);
+
+    if (configImport.inLog && configImport.blockRemaining == 0) {
+        configImport.state = (configImport.crc == configImport.blockCrc) ? CONFIG_IMPORT_LOG_PADDING : CONFIG_IMPORT_ERROR;
+    }
+}
+
+static void importEEPROMConfigFieldComplete(void)
+{
+    configImport.at = 0;
+
+    switch (configImport.state) {
+    case CONFIG_IMPORT_HEADER:
+        if (configImport.field.header.format != EEPROM_CONF_VERSION) {
+            configImport.state = CONFIG_IMPORT_ERROR;
+            return;
+        }
+        configImport.state = CONFIG_IMPORT_RECORD_SIZE;
+        configImport.remaining = sizeof(uint16_t);
+        break;
+
+    case CONFIG_IMPORT_RECORD_SIZE:
+        if (configImport.field.record.size == 0 && !configImport.inLog) {
+            // This was the footer, the checksum follows
+            configImport.state = CONFIG_IMPORT_CHECKSUM;
+            configImport.remaining = sizeof(uint16_t);
+        } else if (configImport.field.record.size < sizeof(configRecord_t) ||
+                   (configImport.inLog && configImport.field.record.size - sizeof(uint16_t) > configImport.blockRemaining)) {
+            configImport.state = CONFIG_IMPORT_ERROR;
+        } else {
+            configImport.state = CONFIG_IMPORT_RECORD_HEADER;
+            configImport.remaining = sizeof(configRecord_t) - sizeof(uint16_t);
+            // Keep the size we already have
+            configImport.at = sizeof(uint16_t);
+        }
+        break;
+
+    case CONFIG_IMPORT_RECORD_HEADER:
+        importEEPROMConfigRecordStart();
+        if (configImport.remaining == 0) {
+            importEEPROMConfigRecordDone();
+        } else {
+            configImport.state = CONFIG_IMPORT_RECORD_DATA;
+        }
+        break;
+
+    case CONFIG_IMPORT_CHECKSUM:
+        // Base image done, update blocks may follow
+        configImport.state = (configImport.field.checkSum == configImport.crc) ? CONFIG_IMPORT_LOG_PADDING : CONFIG_IMPORT_ERROR;
+        break;
+
+    case CONFIG_IMPORT_LOG_HEADER:
+        if (configImport.field.logHeader.size == 0 || configImport.field.logHeader.size == CONFIG_LOG_ERASED) {
+            configImport.state = CONFIG_IMPORT_ERROR;
+            return;
+        }
+        configImport.inLog = true;
+        configImport.blockRemaining = configImport.field.logHeader.size;
+        configImport.blockCrc = configImport.field.logHeader.crc;
+        configImport.crc = 0;
+        configImport.state = CONFIG_IMPORT_RECORD_SIZE;
+        configImport.remaining = sizeof(uint16_t);
+        break;
+
+    default:
+        configImport.state = CONFIG_IMPORT_ERROR;
+        break;
+    }
+}
+
+// Feeds the next chunk of the image. Chunks must be sent in order, offset
+// is used to detect lost or repeated chunks.
+bool importEEPROMConfigStore(uint32_t offset, const uint8_t *data, uint16_t length)
+{
+    if (configImport.state == CONFIG_IMPORT_IDLE || configImport.state == CONFIG_IMPORT_ERROR) {
+        return false;
+    }
+
+    if (offset != configImport.received || configImport.received + length > configImport.size) {
+        configImport.state = CONFIG_IMPORT_ERROR;
+        return false;
+    }
+
+    const uint8_t *p = data;
+    const uint8_t *pend = data + length;
+
+    while (p != pend) {
+        if (configImport.state == CONFIG_IMPORT_LOG_PADDING) {
+            // Update blocks start at aligned offsets, skip the padding in between
+            const uint32_t position = configImport.received + (p - data);
+            if (position != CONFIG_LOG_ALIGN(position)) {
+                p++;
+                continue;
+            }
+            configImport.state = CONFIG_IMPORT_LOG_HEADER;
+            configImport.remaining = sizeof(configLogHeader_t);
+        }
+
+        if (configImport.state == CONFIG_IMPORT_RECORD_DATA) {
+            const uint16_t count = MIN(configImport.remaining, (uint16_t)(pend - p));
+            const uint16_t recordOffset = configImport.field.record.size - sizeof(configRecord_t) - configImport.remaining;
+
+            if (configImport.pgTarget && recordOffset < configImport.pgTargetSize) {
+                memcpy(configImport.pgTarget + recordOffset, p, MIN(count, configImport.pgTargetSize - recordOffset));
+            }
+            configImport.crc = crc16_ccitt_update(configImport.crc, p, count);
+            configImport.remaining -= count;
+            if (configImport.inLog) {
+                configImport.blockRemaining -= count;
+            }
+            p += count;
+
+            if (configImport.remaining == 0) {
+                importEEPROMConfigRecordDone();
+                if (configImport.state == CONFIG_IMPORT_ERROR) {
+                    return false;
+                }
+            }
+            continue;
+        }
+
+        if (configImport.state != CONFIG_IMPORT_CHECKSUM && configImport.state != CONFIG_IMPORT_LOG_HEADER) {
+            configImport.crc = crc16_ccitt_update(configImport.crc, p, 1);
+            if (configImport.inLog) {
+                configImport.blockRemaining--;
+            }
+        }
+        configImport.field.b[configImport.at++] = *p++;
+        if (--configImport.remaining == 0) {
+            importEEPROMConfigFieldComplete();
+            if (configImport.state == CONFIG_IMPORT_ERROR) {
+                return false;
+            }
+        }
+    }
+
+    configImport.received += length;
+    return true;
+}
+
+// Returns true if a complete image with valid checksums has been received
+bool importEEPROMConfigFinish(void)
+{
+    const bool success = configImport.state == CONFIG_IMPORT_LOG_PADDING && configImport.received == configImport.size;
+    configImport.state = CONFIG_IMPORT_IDLE;
+    return success;
+}
@@ -21,9 +21,15 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#define EEPROM_CONF_VERSION 126
+#define EEPROM_CONF_VERSION 127
 
 bool isEEPROMContentValid(void);
 bool loadEEPROM(void);
 void writeConfigToEEPROM(void);
 uint16_t getEEPROMConfigSize(void);
+const uint8_t *getEEPROMConfigImage(void);
+uint16_t getEEPROMConfigChecksum(void);
+
+bool importEEPROMConfigPrepare(uint32_t size);
+bool importEEPROMConfigStore(uint32_t offset, const uint8_t *data, uint16_t length);
+bool importEEPROMConfigFinish(void);
@@ -24,6 +24,7 @@
 extern void config_streamer_impl_unlock(void);
 extern void config_streamer_impl_lock(void);
 extern int config_streamer_impl_write_word(config_streamer_t *c, config_streamer_buffer_align_type_t *buffer);
+extern uint32_t config_streamer_impl_page_size(void);
 
 void config_streamer_init(config_streamer_t *c)
 {
@@ -70,6 +71,13 @@ int config_streamer_flush(config_streamer_t *c)
     return c-> err;
 }
 
+// Writes starting at a multiple of the page size erase the page first,
+// so data can only be appended without an erase within the same page.
+uint32_t config_streamer_page_size(void)
+{
+    return config_streamer_impl_page_size();
+}
+
 int config_streamer_finish(config_streamer_t *c)
 {
     if (c->unlocked) {
@@ -30,6 +30,11 @@ void config_streamer_impl_unlock(void)
     FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR);
 }
 
+uint32_t config_streamer_impl_page_size(void)
+{
+    return FLASH_PAGE_SIZE;
+}
+
 void config_streamer_impl_lock(void)
 {
     FLASH_Lock();
@@ -76,6 +76,11 @@ void config_streamer_impl_unlock(void)
     FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR | FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
 }
 
+uint32_t config_streamer_impl_page_size(void)
+{
+    return FLASH_PAGE_SIZE;
+}
+
 void config_streamer_impl_lock(void)
 {
     FLASH_Lock();
@@ -54,6 +54,8 @@ STATIC_UNIT_TESTED bmp280_calib_param_t bmp280_cal;
 int32_t bmp280_up = 0;
 int32_t bmp280_ut = 0;
 
+static busDeferredRead_t bmp280_data_read;
+
 static bool bmp280_start_ut(baroDev_t * baro)
 {
     UNUSED(baro);
@@ -82,8 +84,8 @@ static bool bmp280_get_up(baroDev_t * baro)
     static int32_t bmp280_up_valid;
     static int32_t bmp280_ut_valid;
 
-    //read data from sensor
-    bool ack = busReadBuf(baro->busDev, BMP280_PRESSURE_MSB_REG, data, BMP280_DATA_FRAME_SIZE);
+    //read data from sensor, over I2C it's the reading queued by the previous call
+    bool ack = busReadBufDeferred(&bmp280_data_read, baro->busDev, BMP280_PRESSURE_MSB_REG, data, BMP280_DATA_FRAME_SIZE) == BUS_READ_DONE;
 
     //check if pressure and temperature readings are valid, otherwise use previous measurements from the moment
     if (ack) {
@@ -158,6 +158,7 @@ static bmp388_calib_param_t bmp388_cal;
 static uint32_t bmp388_up = 0;
 static uint32_t bmp388_ut = 0;
 static uint8_t sensor_data[BMP388_DATA_FRAME_SIZE+1];
+static busDeferredRead_t sensor_data_read;
 
 static int64_t t_lin = 0;
 
@@ -197,7 +198,10 @@ static bool bmp388StartUP(baroDev_t *baro)
 
 static bool bmp388GetUP(baroDev_t *baro)
 {
-    busReadBuf(baro->busDev, BMP388_DATA_0_REG, sensor_data, BMP388_DATA_FRAME_SIZE + 1);
+    // Over I2C it's the reading queued by the previous call, nothing is new until it arrives
+    if (busReadBufDeferred(&sensor_data_read, baro->busDev, BMP388_DATA_0_REG, sensor_data, BMP388_DATA_FRAME_SIZE + 1) != BUS_READ_DONE) {
+        return false;
+    }
 
     bmp388_up = sensor_data[1] << 0 | sensor_data[2] << 8 | sensor_data[3] << 16;
     bmp388_ut = sensor_data[4] << 0 | sensor_data[5] << 8 | sensor_data[6] << 16;
@@ -202,6 +202,36 @@ void busSetSpeed(const busDevice_t * dev, busSpeed_e speed)
     }
 }
 
+void busSetPriority(busDevice_t * dev, busPriority_e priority, timeDelta_t periodUs)
+{
+    switch (dev->busType) {
+        case BUSTYPE_SPI:
+#ifdef USE_SPI
+            spiBusSetPriority(dev, priority, periodUs);
+#endif
+            break;
+        default:
+            // Only SPI arbitrates between devices, I2C transactions carry their own priority
+            UNUSED(priority);
+            UNUSED(periodUs);
+            break;
+    }
+}
+
+int32_t busGetTransferBudget(const busDevice_t * dev)
+{
+    switch (dev->busType) {
+        case BUSTYPE_SPI:
+#ifdef USE_SPI
+            return spiBusGetTransferBudget(dev);
+#else
+            return BUS_TRANSFER_BUDGET_UNLIMITED;
+#endif
+        default:
+            return BUS_TRANSFER_BUDGET_UNLIMITED;
+    }
+}
+
 uint32_t busDeviceReadScratchpad(const busDevice_t * dev)
 {
     uint32_t * mem = busDeviceGetScratchpadMemory(dev);
@@ -337,6 +367,23 @@ bool busReadBuf(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t le
     }
 }
 
+busReadStatus_e busReadBufDeferred(busDeferredRead_t * read, const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t length)
+{
+    switch (dev->busType) {
+        case BUSTYPE_I2C:
+#ifdef USE_I2C
+            return i2cBusReadBufferDeferred(read, dev, reg, data, length);
+#else
+            UNUSED(read);
+            return BUS_READ_FAILED;
+#endif
+
+        default:
+            UNUSED(read);
+            return busReadBuf(dev, reg, data, length) ? BUS_READ_DONE : BUS_READ_FAILED;
+    }
+}
+
 bool busRead(const busDevice_t * dev, uint8_t reg, uint8_t * data)
 {
     switch (dev->busType) {
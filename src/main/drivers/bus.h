@@ -29,6 +29,8 @@
 
 #include "platform.h"
 
+#include "common/time.h"
+
 #include "drivers/resource.h"
 #include "drivers/bus_i2c.h"
 #include "drivers/bus_spi.h"
@@ -187,11 +189,17 @@ typedef struct busDeviceDescriptor_s {
     ioTag_t irqPin;
 } busDeviceDescriptor_t;
 
+typedef enum {
+    BUS_PRIORITY_NORMAL = 0,
+    BUS_PRIORITY_HIGH,              // Periodic reads which other devices on the bus keep out of the way of (gyro)
+} busPriority_e;
+
 typedef struct busDevice_s {
     const busDeviceDescriptor_t * descriptorPtr;
     busType_e busType;              // Copy of busType to avoid additional pointer dereferencing
     uint32_t flags;                 // Copy of flags
     uint32_t param;                 // Copy of param
+    busPriority_e priority;
     union {
 #ifdef USE_SPI
         struct {
@@ -289,11 +297,69 @@ typedef struct busTransferDescriptor_s {
     uint32_t        length;
 } busTransferDescriptor_t;
 
+typedef enum {
+    I2C_TXN_IDLE = 0,
+    I2C_TXN_QUEUED,
+    I2C_TXN_ACTIVE,
+    I2C_TXN_DONE,
+    I2C_TXN_FAILED,         // NACK or bus error
+    I2C_TXN_EXPIRED,        // Not started before its timeout
+} i2cTransactionState_e;
+
+/* Asynchronous I2C transaction, owned by the caller until it completes */
+typedef struct busI2CTransaction_s {
+    const busDevice_t * dev;
+    uint8_t             reg;
+    bool                read;
+    uint8_t *           buf;
+    uint8_t             length;
+    uint8_t             priority;       // Higher priority transactions are started first
+    timeDelta_t         timeoutUs;      // Fail if not started within this time, 0 to wait forever
+    void (*callback)(struct busI2CTransaction_s * txn);    // Optional, called once completed. Can submit the next transaction
+
+    /* Managed by the bus */
+    i2cTransactionState_e       state;
+    timeUs_t                    deadline;
+    struct busI2CTransaction_s *next;
+} busI2CTransaction_t;
+
+typedef enum {
+    BUS_READ_DONE = 0,      // The data holds a new reading
+    BUS_READ_PENDING,       // Still waiting for the bus, the data is left untouched
+    BUS_READ_FAILED,
+} busReadStatus_e;
+
+#define BUS_DEFERRED_READ_MAX_LENGTH    8
+
+/* Register read that doesn't wait for a busy I2C bus, one per polled register. Each call returns
+ * the reading queued by the previous one and queues the next, so the data is one call old.
+ * SPI devices and the emulated I2C buses are read right away. */
+typedef struct busDeferredRead_s {
+    busI2CTransaction_t txn;
+    uint8_t             buf[BUS_DEFERRED_READ_MAX_LENGTH];
+} busDeferredRead_t;
+
+typedef struct i2cBusStats_s {
+    uint32_t transfers;     // Finished transfers, including the failed ones
+    uint32_t bytes;         // Payload of the successful transfers
+    uint32_t nacks;
+    uint32_t errors;        // Timeouts and bus errors
+    uint32_t expired;       // Queued transactions dropped after their timeout
+    uint64_t busyTimeUs;    // Time spent with a transfer in flight
+    uint8_t queued;
+    uint8_t maxQueued;
+} i2cBusStats_t;
+
 /* Internal abstraction function */
 bool i2cBusWriteBuffer(const busDevice_t * dev, uint8_t reg, const uint8_t * data, uint8_t length);
 bool i2cBusWriteRegister(const busDevice_t * dev, uint8_t reg, uint8_t data);
 bool i2cBusReadBuffer(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t length);
 bool i2cBusReadRegister(const busDevice_t * dev, uint8_t reg, uint8_t * data);
+busReadStatus_e i2cBusReadBufferDeferred(busDeferredRead_t * read, const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t length);
+bool i2cBusSubmit(busI2CTransaction_t * txn);
+bool i2cBusIsTransactionPending(const busI2CTransaction_t * txn);
+void i2cBusProcessQueues(timeUs_t currentTimeUs);
+bool i2cBusGetStats(I2CDevice bus, i2cBusStats_t * stats);
 
 bool spiBusInitHost(const busDevice_t * dev);
 bool spiBusIsBusy(const busDevice_t * dev);
@@ -306,6 +372,8 @@ bool spiBusReadBuffer(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint
 bool spiBusReadRegister(const busDevice_t * dev, uint8_t reg, uint8_t * data);
 void spiBusSelectDevice(const busDevice_t * dev);
 void spiBusDeselectDevice(const busDevice_t * dev);
+void spiBusSetPriority(busDevice_t * dev, busPriority_e priority, timeDelta_t periodUs);
+int32_t spiBusGetTransferBudget(const busDevice_t * dev);
 
 /* Pre-initialize all known device descriptors to make sure hardware state is consistent and known
  * Initialize bus hardware */
@@ -322,12 +390,19 @@ void * busDeviceGetScratchpadMemory(const busDevice_t * dev);
 
 void busSetSpeed(const busDevice_t * dev, busSpeed_e speed);
 
+/* High priority devices are read every periodUs. Transfers by other devices sharing the bus
+ * should be kept within busGetTransferBudget() bytes so they finish before the next read. */
+#define BUS_TRANSFER_BUDGET_UNLIMITED   INT32_MAX
+void busSetPriority(busDevice_t * dev, busPriority_e priority, timeDelta_t periodUs);
+int32_t busGetTransferBudget(const busDevice_t * dev);
+
 /* Select/Deselect device will allow code to do something during device transfer or do transfer in chunks over some time */
 void busSelectDevice(const busDevice_t * dev);
 void busDeselectDevice(const busDevice_t * dev);
 
 bool busWriteBuf(const busDevice_t * busdev, uint8_t reg, const uint8_t * data, uint8_t length);
 bool busReadBuf(const busDevice_t * busdev, uint8_t reg, uint8_t * data, uint8_t length);
+busReadStatus_e busReadBufDeferred(busDeferredRead_t * read, const busDevice_t * busdev, uint8_t reg, uint8_t * data, uint8_t length);
 bool busRead(const busDevice_t * busdev, uint8_t reg, uint8_t * data);
 bool busWrite(const busDevice_t * busdev, uint8_t reg, uint8_t data);
 
@@ -23,30 +23,245 @@
 
 #if defined(USE_I2C)
 
+#include "common/maths.h"
+#include "common/utils.h"
+
 #include "drivers/bus.h"
 #include "drivers/bus_i2c.h"
+#include "drivers/time.h"
 
-bool i2cBusWriteBuffer(const busDevice_t * dev, uint8_t reg, const uint8_t * data, uint8_t length)
+// Transactions waiting for each bus, highest priority first. Blocking
+// transfers go ahead of them, but wait for the one in flight to finish.
+typedef struct i2cBusQueue_s {
+    busI2CTransaction_t *   active;
+    busI2CTransaction_t *   head;
+    timeUs_t                activeSince;
+    i2cBusStats_t           stats;
+} i2cBusQueue_t;
+
+static i2cBusQueue_t i2cBusQueues[I2CDEV_COUNT];
+
+static bool i2cBusIsValid(I2CDevice bus)
+{
+    return bus >= 0 && bus < I2CDEV_COUNT;
+}
+
+static void i2cBusAccountTransfer(i2cBusQueue_t * queue, i2cTransferStatus_e status, uint8_t length, timeUs_t startedAt)
+{
+    queue->stats.transfers++;
+    queue->stats.busyTimeUs += micros() - startedAt;
+
+    switch (status) {
+        case I2C_TRANSFER_OK:
+            queue->stats.bytes += length;
+            break;
+        case I2C_TRANSFER_NACK:
+            queue->stats.nacks++;
+            break;
+        default:
+            queue->stats.errors++;
+            break;
+    }
+}
+
+static void i2cBusCompleteTransaction(busI2CTransaction_t * txn, i2cTransactionState_e state)
+{
+    txn->state = state;
+    if (txn->callback) {
+        txn->callback(txn);
+    }
+}
+
+// Finishes the transfer in flight if the hardware is done with it and,
+// if startNext is true, starts the next queued one
+static void i2cBusServiceQueue(I2CDevice bus, bool startNext)
+{
+    i2cBusQueue_t * queue = &i2cBusQueues[bus];
+
+    if (queue->active) {
+        const i2cTransferStatus_e status = i2cTransferPoll(bus);
+        if (status == I2C_TRANSFER_BUSY) {
+            return;
+        }
+        busI2CTransaction_t * txn = queue->active;
+        queue->active = NULL;
+        i2cBusAccountTransfer(queue, status, txn->length, queue->activeSince);
+        i2cBusCompleteTransaction(txn, status == I2C_TRANSFER_OK ? I2C_TXN_DONE : I2C_TXN_FAILED);
+    }
+
+    while (startNext && !queue->active && queue->head) {
+        busI2CTransaction_t * txn = queue->head;
+        queue->head = txn->next;
+        queue->stats.queued--;
+
+        if (txn->timeoutUs > 0 && cmpTimeUs(micros(), txn->deadline) > 0) {
+            queue->stats.expired++;
+            i2cBusCompleteTransaction(txn, I2C_TXN_EXPIRED);
+            continue;
+        }
+
+        const busDevice_t * dev = txn->dev;
+        const bool allowRawAccess = (dev->flags & DEVFLAGS_USE_RAW_REGISTERS);
+        txn->state = I2C_TXN_ACTIVE;
+        queue->activeSince = micros();
+        if (i2cTransferStart(bus, dev->busdev.i2c.address, txn->reg, txn->length, txn->buf, txn->read, allowRawAccess)) {
+            queue->active = txn;
+        } else {
+            queue->stats.errors++;
+            i2cBusCompleteTransaction(txn, I2C_TXN_FAILED);
+        }
+    }
+}
+
+static bool i2cBusTransfer(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t length, bool read)
 {
+    const I2CDevice bus = dev->busdev.i2c.i2cBus;
     const bool allowRawAccess = (dev->flags & DEVFLAGS_USE_RAW_REGISTERS);
-    return i2cWriteBuffer(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, length, data, allowRawAccess);
+
+    if (!i2cBusIsValid(bus)) {
+        if (read) {
+            return i2cRead(bus, dev->busdev.i2c.address, reg, length, data, allowRawAccess);
+        }
+        return i2cWriteBuffer(bus, dev->busdev.i2c.address, reg, length, data, allowRawAccess);
+    }
+
+    i2cBusQueue_t * queue = &i2cBusQueues[bus];
+    while (queue->active) {
+        i2cBusServiceQueue(bus, false);
+    }
+
+    const timeUs_t startedAt = micros();
+    if (!i2cTransferStart(bus, dev->busdev.i2c.address, reg, length, data, read, allowRawAccess)) {
+        queue->stats.errors++;
+        return false;
+    }
+
+    i2cTransferStatus_e status;
+    do {
+        status = i2cTransferPoll(bus);
+    } while (status == I2C_TRANSFER_BUSY);
+
+    i2cBusAccountTransfer(queue, status, length, startedAt);
+    return status == I2C_TRANSFER_OK;
+}
+
+bool i2cBusWriteBuffer(const busDevice_t * dev, uint8_t reg, const uint8_t * data, uint8_t length)
+{
+    return i2cBusTransfer(dev, reg, CONST_CAST(uint8_t *, data), length, false);
 }
 
 bool i2cBusWriteRegister(const busDevice_t * dev, uint8_t reg, uint8_t data)
 {
-    const bool allowRawAccess = (dev->flags & DEVFLAGS_USE_RAW_REGISTERS);
-    return i2cWrite(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, data, allowRawAccess);
+    return i2cBusTransfer(dev, reg, &data, 1, false);
 }
 
 bool i2cBusReadBuffer(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t length)
 {
-    const bool allowRawAccess = (dev->flags & DEVFLAGS_USE_RAW_REGISTERS);
-    return i2cRead(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, length, data, allowRawAccess);
+    return i2cBusTransfer(dev, reg, data, length, true);
 }
 
 bool i2cBusReadRegister(const busDevice_t * dev, uint8_t reg, uint8_t * data)
 {
-    const bool allowRawAccess = (dev->flags & DEVFLAGS_USE_RAW_REGISTERS);
-    return i2cRead(dev->busdev.i2c.i2cBus, dev->busdev.i2c.address, reg, 1, data, allowRawAccess);
+    return i2cBusTransfer(dev, reg, data, 1, true);
+}
+
+busReadStatus_e i2cBusReadBufferDeferred(busDeferredRead_t * read, const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t length)
+{
+    busI2CTransaction_t * txn = &read->txn;
+
+    if (!i2cBusIsValid(dev->busdev.i2c.i2cBus) || length > sizeof(read->buf)) {
+        return i2cBusReadBuffer(dev, reg, data, length) ? BUS_READ_DONE : BUS_READ_FAILED;
+    }
+
+    if (i2cBusIsTransactionPending(txn)) {
+        return BUS_READ_PENDING;
+    }
+
+    // Result of the read queued by the previous call, nothing on the first one
+    busReadStatus_e status = BUS_READ_PENDING;
+    if (txn->dev == dev && txn->reg == reg && txn->length == length) {
+        switch (txn->state) {
+            case I2C_TXN_DONE:
+                memcpy(data, read->buf, length);
+                status = BUS_READ_DONE;
+                break;
+            case I2C_TXN_FAILED:
+            case I2C_TXN_EXPIRED:
+                status = BUS_READ_FAILED;
+                break;
+            default:
+                break;
+        }
+    }
+
+    txn->dev = dev;
+    txn->reg = reg;
+    txn->read = true;
+    txn->buf = read->buf;
+    txn->length = length;
+    txn->priority = BUS_PRIORITY_NORMAL;
+    txn->timeoutUs = 0;
+    txn->callback = NULL;
+
+    if (!i2cBusSubmit(txn)) {
+        return BUS_READ_FAILED;
+    }
+    return status;
+}
+
+bool i2cBusSubmit(busI2CTransaction_t * txn)
+{
+    const busDevice_t * dev = txn->dev;
+    if (!dev || dev->busType != BUSTYPE_I2C || !i2cBusIsValid(dev->busdev.i2c.i2cBus) || i2cBusIsTransactionPending(txn)) {
+        return false;
+    }
+
+    const I2CDevice bus = dev->busdev.i2c.i2cBus;
+    i2cBusQueue_t * queue = &i2cBusQueues[bus];
+
+    txn->state = I2C_TXN_QUEUED;
+    txn->deadline = micros() + txn->timeoutUs;
+
+    // Goes after the queued transactions of the same or higher priority
+    busI2CTransaction_t ** pos = &queue->head;
+    while (*pos && (*pos)->priority >= txn->priority) {
+        pos = &(*pos)->next;
+    }
+    txn->next = *pos;
+    *pos = txn;
+
+    queue->stats.queued++;
+    queue->stats.maxQueued = MAX(queue->stats.maxQueued, queue->stats.queued);
+
+    // Start it right away if the bus is idle
+    i2cBusServiceQueue(bus, true);
+    return true;
+}
+
+bool i2cBusIsTransactionPending(const busI2CTransaction_t * txn)
+{
+    return txn->state == I2C_TXN_QUEUED || txn->state == I2C_TXN_ACTIVE;
+}
+
+// Called from the main loop, runs the queued transactions in the background
+void i2cBusProcessQueues(timeUs_t currentTimeUs)
+{
+    UNUSED(currentTimeUs);
+
+    for (int bus = 0; bus < I2CDEV_COUNT; bus++) {
+        if (i2cBusQueues[bus].active || i2cBusQueues[bus].head) {
+            i2cBusServiceQueue(bus, true);
+        }
+    }
+}
+
+bool i2cBusGetStats(I2CDevice bus, i2cBusStats_t * stats)
+{
+    if (!i2cBusIsValid(bus)) {
+        return false;
+    }
+
+    *stats = i2cBusQueues[bus].stats;
+    return true;
 }
 #endif
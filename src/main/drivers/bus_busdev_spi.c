@@ -24,11 +24,37 @@
 
 #if defined(USE_SPI)
 
+#include "common/maths.h"
+
 #include "drivers/io.h"
 #include "drivers/bus.h"
 #include "drivers/bus_spi.h"
 #include "drivers/time.h"
 
+#define SPI_BUS_GUARD_US                20      // Left free before the next high priority read
+#define SPI_BUS_MIN_BUDGET              32      // Other devices always make some progress
+#define SPI_BUS_DEFAULT_NS_PER_BYTE     1000    // Until measured, about 8MHz SCK
+#define SPI_BUS_MIN_SAMPLE_LENGTH       32      // Shorter transfers are too quick to time with micros()
+#define SPI_BUS_STATS_WINDOW_US         1000000
+
+// Transfers are blocking and the scheduler is cooperative, so a high priority
+// read can only be delayed by another device's transfer still running when the
+// read is due. busGetTransferBudget() tells the other devices how many bytes
+// fit before that.
+typedef struct spiBusArbiter_s {
+    timeDelta_t periodUs;               // How often the high priority device is read, 0 if there is none
+    timeUs_t    readStartedAt;          // Start of the last periodic read
+    uint16_t    nsPerByte;              // Measured cost of the other devices' transfers, 0 until known
+
+    // Reported through DEBUG_SPI_BUS
+    timeUs_t    windowStartedAt;
+    timeDelta_t maxLatencyUs;
+    timeDelta_t maxOtherTransferUs;
+    uint16_t    minimumBudgets;         // Times the budget didn't fit before the next read
+} spiBusArbiter_t;
+
+static spiBusArbiter_t spiBusArbiters[SPIDEV_COUNT];
+
 void spiChipSelectSetupDelay(void)
 {
     // CS->CLK delay, MPU6000 - 8ns
@@ -73,9 +99,92 @@ void spiBusSetSpeed(const busDevice_t * dev, busSpeed_e speed)
 }
 
 
+static void spiBusPeriodicReadDone(spiBusArbiter_t * arbiter, timeUs_t startedAt, timeUs_t finishedAt, timeDelta_t durationUs)
+{
+    if (arbiter->readStartedAt) {
+        // From when the read was due until its data was available
+        const timeDelta_t latencyUs = MAX(cmpTimeUs(finishedAt, arbiter->readStartedAt + arbiter->periodUs), durationUs);
+        arbiter->maxLatencyUs = MAX(arbiter->maxLatencyUs, latencyUs);
+        DEBUG_SET(DEBUG_SPI_BUS, 0, latencyUs);
+    }
+    arbiter->readStartedAt = startedAt;
+
+    if (cmpTimeUs(finishedAt, arbiter->windowStartedAt) >= SPI_BUS_STATS_WINDOW_US) {
+        DEBUG_SET(DEBUG_SPI_BUS, 1, arbiter->maxLatencyUs);
+        DEBUG_SET(DEBUG_SPI_BUS, 2, arbiter->maxOtherTransferUs);
+        DEBUG_SET(DEBUG_SPI_BUS, 3, arbiter->minimumBudgets);
+        arbiter->windowStartedAt = finishedAt;
+        arbiter->maxLatencyUs = 0;
+        arbiter->maxOtherTransferUs = 0;
+        arbiter->minimumBudgets = 0;
+    }
+}
+
+static void spiBusTransferDone(const busDevice_t * dev, timeUs_t startedAt, int length)
+{
+    spiBusArbiter_t * arbiter = &spiBusArbiters[dev->busdev.spi.spiBus];
+
+    if (arbiter->periodUs == 0) {
+        // Nothing to keep out of the way of
+        return;
+    }
+
+    const timeUs_t finishedAt = micros();
+    const timeDelta_t durationUs = cmpTimeUs(finishedAt, startedAt);
+
+    if (dev->priority == BUS_PRIORITY_HIGH) {
+        // Other reads from the same chip (e.g. the accelerometer) happen in between
+        if (cmpTimeUs(startedAt, arbiter->readStartedAt) >= arbiter->periodUs / 2) {
+            spiBusPeriodicReadDone(arbiter, startedAt, finishedAt, durationUs);
+        }
+    } else {
+        arbiter->maxOtherTransferUs = MAX(arbiter->maxOtherTransferUs, durationUs);
+        if (length >= SPI_BUS_MIN_SAMPLE_LENGTH) {
+            const uint16_t nsPerByte = MIN(durationUs * 1000 / length, UINT16_MAX);
+            arbiter->nsPerByte = arbiter->nsPerByte ? (arbiter->nsPerByte * 3 + nsPerByte) / 4 : nsPerByte;
+        }
+    }
+}
+
+void spiBusSetPriority(busDevice_t * dev, busPriority_e priority, timeDelta_t periodUs)
+{
+    dev->priority = priority;
+
+    if (priority == BUS_PRIORITY_HIGH && periodUs > 0) {
+        spiBusArbiters[dev->busdev.spi.spiBus].periodUs = periodUs;
+    }
+}
+
+int32_t spiBusGetTransferBudget(const busDevice_t * dev)
+{
+    spiBusArbiter_t * arbiter = &spiBusArbiters[dev->busdev.spi.spiBus];
+
+    if (dev->priority == BUS_PRIORITY_HIGH || arbiter->periodUs == 0 || arbiter->readStartedAt == 0) {
+        return BUS_TRANSFER_BUDGET_UNLIMITED;
+    }
+
+    const timeDelta_t sinceReadUs = cmpTimeUs(micros(), arbiter->readStartedAt);
+    if (sinceReadUs > 2 * arbiter->periodUs) {
+        // Not being read at the moment, e.g. while in the CLI
+        return BUS_TRANSFER_BUDGET_UNLIMITED;
+    }
+
+    const timeDelta_t untilNextReadUs = arbiter->periodUs - sinceReadUs - SPI_BUS_GUARD_US;
+    const int32_t nsPerByte = arbiter->nsPerByte ? arbiter->nsPerByte : SPI_BUS_DEFAULT_NS_PER_BYTE;
+    const int32_t budget = untilNextReadUs > 0 ? untilNextReadUs * 1000 / nsPerByte : 0;
+
+    if (budget < SPI_BUS_MIN_BUDGET) {
+        arbiter->minimumBudgets++;
+        return SPI_BUS_MIN_BUDGET;
+    }
+
+    return budget;
+}
+
 bool spiBusTransfer(const busDevice_t * dev, uint8_t * rxBuf, const uint8_t * txBuf, int length)
 {
     SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    const timeUs_t startedAt = micros();
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         spiBusSelectDevice(dev);
@@ -87,31 +196,39 @@ bool spiBusTransfer(const busDevice_t * dev, uint8_t * rxBuf, const uint8_t * tx
         spiBusDeselectDevice(dev);
     }
 
+    spiBusTransferDone(dev, startedAt, length);
+
     return true;
 }
 
 bool spiBusTransferMultiple(const busDevice_t * dev, busTransferDescriptor_t * dsc, int count)
 {
     SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    const timeUs_t startedAt = micros();
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         spiBusSelectDevice(dev);
     }
 
+    int length = 0;
     for (int n = 0; n < count; n++) {
         spiTransfer(instance, dsc[n].rxBuf, dsc[n].txBuf, dsc[n].length);
+        length += dsc[n].length;
     }
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         spiBusDeselectDevice(dev);
     }
 
+    spiBusTransferDone(dev, startedAt, length);
+
     return true;
 }
 
 bool spiBusWriteRegister(const busDevice_t * dev, uint8_t reg, uint8_t data)
 {
     SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    const timeUs_t startedAt = micros();
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         spiBusSelectDevice(dev);
@@ -124,12 +241,15 @@ bool spiBusWriteRegister(const busDevice_t * dev, uint8_t reg, uint8_t data)
         spiBusDeselectDevice(dev);
     }
 
+    spiBusTransferDone(dev, startedAt, 2);
+
     return true;
 }
 
 bool spiBusWriteBuffer(const busDevice_t * dev, uint8_t reg, const uint8_t * data, uint8_t length)
 {
     SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    const timeUs_t startedAt = micros();
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         spiBusSelectDevice(dev);
@@ -142,12 +262,15 @@ bool spiBusWriteBuffer(const busDevice_t * dev, uint8_t reg, const uint8_t * dat
         spiBusDeselectDevice(dev);
     }
 
+    spiBusTransferDone(dev, startedAt, length + 1);
+
     return true;
 }
 
 bool spiBusReadBuffer(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint8_t length)
 {
     SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    const timeUs_t startedAt = micros();
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         spiBusSelectDevice(dev);
@@ -160,12 +283,15 @@ bool spiBusReadBuffer(const busDevice_t * dev, uint8_t reg, uint8_t * data, uint
         spiBusDeselectDevice(dev);
     }
 
+    spiBusTransferDone(dev, startedAt, length + 1);
+
     return true;
 }
 
 bool spiBusReadRegister(const busDevice_t * dev, uint8_t reg, uint8_t * data)
 {
     SPI_TypeDef * instance = spiInstanceByDevice(dev->busdev.spi.spiBus);
+    const timeUs_t startedAt = micros();
 
     if (!(dev->flags & DEVFLAGS_USE_MANUAL_DEVICE_SELECT)) {
         spiBusSelectDevice(dev);
@@ -178,6 +304,8 @@ bool spiBusReadRegister(const busDevice_t * dev, uint8_t reg, uint8_t * data)
         spiBusDeselectDevice(dev);
     }
 
+    spiBusTransferDone(dev, startedAt, 2);
+
     return true;
 }
 
@@ -59,10 +59,22 @@ typedef struct i2cDevice_s {
 #endif
 } i2cDevice_t;
 
+typedef enum {
+    I2C_TRANSFER_BUSY = 0,
+    I2C_TRANSFER_OK,
+    I2C_TRANSFER_NACK,
+    I2C_TRANSFER_ERROR,
+} i2cTransferStatus_e;
+
 void i2cSetSpeed(uint8_t speed);
 void i2cInit(I2CDevice device);
 bool i2cWriteBuffer(I2CDevice device, uint8_t addr_, uint8_t reg_, uint8_t len_, const uint8_t *data, bool allowRawAccess);
 bool i2cWrite(I2CDevice device, uint8_t addr_, uint8_t reg, uint8_t data, bool allowRawAccess);
 bool i2cRead(I2CDevice device, uint8_t addr_, uint8_t reg, uint8_t len, uint8_t* buf, bool allowRawAccess);
 
+// Non-blocking transfers, used by the transaction queues in bus_busdev_i2c.c.
+// Drivers which can't do them finish the transfer in i2cTransferStart().
+bool i2cTransferStart(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *buf, bool read, bool allowRawAccess);
+i2cTransferStatus_e i2cTransferPoll(I2CDevice device);
+
 uint16_t i2cGetErrorCounter(void);
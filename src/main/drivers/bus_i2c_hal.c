@@ -217,6 +217,25 @@ bool i2cRead(I2CDevice device, uint8_t addr_, uint8_t reg_, uint8_t len, uint8_t
     return true;
 }
 
+// HAL transfers are blocking, they're finished by the time i2cTransferStart() returns
+static i2cTransferStatus_e i2cTransferStatus[I2CDEV_COUNT];
+
+bool i2cTransferStart(I2CDevice device, uint8_t addr_, uint8_t reg_, uint8_t len, uint8_t *buf, bool read, bool allowRawAccess)
+{
+    if (device == I2CINVALID)
+        return false;
+
+    const bool ok = read ? i2cRead(device, addr_, reg_, len, buf, allowRawAccess) : i2cWriteBuffer(device, addr_, reg_, len, buf, allowRawAccess);
+    i2cTransferStatus[device] = ok ? I2C_TRANSFER_OK : I2C_TRANSFER_ERROR;
+
+    return true;
+}
+
+i2cTransferStatus_e i2cTransferPoll(I2CDevice device)
+{
+    return i2cTransferStatus[device];
+}
+
 /*
  * Compute SCLDEL, SDADEL, SCLH and SCLL for TIMINGR register according to reference manuals.
  */
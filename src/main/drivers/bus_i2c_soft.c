@@ -290,6 +290,22 @@ bool i2cRead(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *
     return true;
 }
 
+// Bit-banged transfers are blocking, they're finished by the time i2cTransferStart() returns
+static i2cTransferStatus_e i2cTransferStatus;
+
+bool i2cTransferStart(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *buf, bool read, bool allowRawAccess)
+{
+    const bool ok = read ? i2cRead(device, addr, reg, len, buf, allowRawAccess) : i2cWriteBuffer(device, addr, reg, len, buf, allowRawAccess);
+    i2cTransferStatus = ok ? I2C_TRANSFER_OK : I2C_TRANSFER_ERROR;
+    return true;
+}
+
+i2cTransferStatus_e i2cTransferPoll(I2CDevice device)
+{
+    UNUSED(device);
+    return i2cTransferStatus;
+}
+
 uint16_t i2cGetErrorCounter(void)
 {
     return i2cErrorCount;
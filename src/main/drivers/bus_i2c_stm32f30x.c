@@ -97,6 +97,7 @@ typedef struct i2cBusState_s {
     uint32_t                    len;    // buffer length
     uint8_t                    *buf;    // buffer
     bool                        txnOk;
+    bool                        txnNack;    // failed because the device didn't acknowledge
 } i2cBusState_t;
 
 static volatile uint16_t i2cErrorCount = 0;
@@ -315,6 +316,7 @@ static void i2cStateMachine(i2cBusState_t * i2cBusState, const timeUs_t currentT
             break;
 
         case I2C_STATE_NACK:
+            i2cBusState->txnNack = true;
             I2C_TransferHandling(I2Cx, i2cBusState->addr, 0, I2C_AutoEnd_Mode, I2C_Generate_Stop);
             I2C_ClearFlag(I2Cx, I2C_FLAG_NACKF);
             i2cBusState->state = I2C_STATE_STOPPING;
@@ -396,61 +398,78 @@ uint16_t i2cGetErrorCounter(void)
     return i2cErrorCount;
 }
 
-static void i2cWaitForCompletion(I2CDevice device)
+bool i2cTransferStart(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, uint8_t * buf, bool read, bool allowRawAccess)
 {
-    do {
-        i2cStateMachine(&busState[device], micros());
-    } while (busState[device].state != I2C_STATE_STOPPED);
-}
-
-bool i2cWriteBuffer(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, const uint8_t * data, bool allowRawAccess)
-{
-    // Don't try to access the non-initialized device
-    if (!busState[device].initialized)
+    // Don't try to access the non-initialized or busy device
+    if (!busState[device].initialized || busState[device].state != I2C_STATE_STOPPED)
         return false;
 
-    // Set up write transaction
+    // Set up transaction
     busState[device].addr = addr << 1;
     busState[device].reg = reg;
-    busState[device].rw = I2C_TXN_WRITE;
+    busState[device].rw = read ? I2C_TXN_READ : I2C_TXN_WRITE;
     busState[device].len = len;
-    busState[device].buf = CONST_CAST(uint8_t *, data);
+    busState[device].buf = buf;
     busState[device].txnOk = false;
+    busState[device].txnNack = false;
     busState[device].state = I2C_STATE_STARTING;
     busState[device].allowRawAccess = allowRawAccess;
 
     // Inject I2C_EVENT_START
-    i2cWaitForCompletion(device);
+    i2cStateMachine(&busState[device], micros());
 
-    return busState[device].txnOk;
+    return true;
 }
 
-bool i2cWrite(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t data, bool allowRawAccess)
+i2cTransferStatus_e i2cTransferPoll(I2CDevice device)
 {
-    return i2cWriteBuffer(device, addr, reg, 1, &data, allowRawAccess);
-}
+    i2cBusState_t * i2cBusState = &busState[device];
+    i2cState_t previousState;
+
+    // Advance for as long as the hardware doesn't make us wait
+    do {
+        previousState = i2cBusState->state;
+        i2cStateMachine(i2cBusState, micros());
+    } while (i2cBusState->state != previousState && i2cBusState->state != I2C_STATE_STOPPED);
 
+    if (i2cBusState->state != I2C_STATE_STOPPED) {
+        return I2C_TRANSFER_BUSY;
+    }
 
-bool i2cRead(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, uint8_t* buf, bool allowRawAccess)
+    if (i2cBusState->txnOk) {
+        return I2C_TRANSFER_OK;
+    }
+
+    return i2cBusState->txnNack ? I2C_TRANSFER_NACK : I2C_TRANSFER_ERROR;
+}
+
+static bool i2cTransfer(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, uint8_t * buf, bool read, bool allowRawAccess)
 {
-    // Don't try to access the non-initialized device
-    if (!busState[device].initialized)
+    if (!i2cTransferStart(device, addr, reg, len, buf, read, allowRawAccess)) {
         return false;
+    }
 
-    // Set up read transaction
-    busState[device].addr = addr << 1;
-    busState[device].reg = reg;
-    busState[device].rw = I2C_TXN_READ;
-    busState[device].len = len;
-    busState[device].buf = buf;
-    busState[device].txnOk = false;
-    busState[device].state = I2C_STATE_STARTING;
-    busState[device].allowRawAccess = allowRawAccess;
+    i2cTransferStatus_e status;
+    do {
+        status = i2cTransferPoll(device);
+    } while (status == I2C_TRANSFER_BUSY);
 
-    // Inject I2C_EVENT_START
-    i2cWaitForCompletion(device);
+    return status == I2C_TRANSFER_OK;
+}
 
-    return busState[device].txnOk;
+bool i2cWriteBuffer(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, const uint8_t * data, bool allowRawAccess)
+{
+    return i2cTransfer(device, addr, reg, len, CONST_CAST(uint8_t *, data), false, allowRawAccess);
+}
+
+bool i2cWrite(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t data, bool allowRawAccess)
+{
+    return i2cWriteBuffer(device, addr, reg, 1, &data, allowRawAccess);
+}
+
+bool i2cRead(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, uint8_t* buf, bool allowRawAccess)
+{
+    return i2cTransfer(device, addr, reg, len, buf, true, allowRawAccess);
 }
 
 #endif
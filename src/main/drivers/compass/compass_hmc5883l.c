@@ -112,19 +112,26 @@
 #define HMC_POS_BIAS 1
 #define HMC_NEG_BIAS 2
 
+static busDeferredRead_t hmc5883lDataRead;
+
 static bool hmc5883lRead(magDev_t * mag)
 {
     uint8_t buf[6];
-    bool ack;
+    busReadStatus_e status;
 
     if (mag->busDev->busType == BUSTYPE_SPI) {
-        ack = busReadBuf(mag->busDev, MAG_DATA_REGISTER_SPI, buf, 6);
+        status = busReadBufDeferred(&hmc5883lDataRead, mag->busDev, MAG_DATA_REGISTER_SPI, buf, 6);
     }
     else {
-        ack = busReadBuf(mag->busDev, MAG_DATA_REGISTER, buf, 6);
+        status = busReadBufDeferred(&hmc5883lDataRead, mag->busDev, MAG_DATA_REGISTER, buf, 6);
+    }
+
+    // Over I2C it's the reading queued by the previous call, keep the last one until it arrives
+    if (status == BUS_READ_PENDING) {
+        return true;
     }
 
-    if (!ack) {
+    if (status != BUS_READ_DONE) {
         mag->magADCRaw[X] = 0;
         mag->magADCRaw[Y] = 0;
         mag->magADCRaw[Z] = 0;
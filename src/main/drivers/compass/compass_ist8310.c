@@ -125,18 +125,24 @@ static bool ist8310Init(magDev_t * mag)
     return true;
 }
 
+static busDeferredRead_t ist8310DataRead;
+
 static bool ist8310Read(magDev_t * mag)
 {
     uint8_t buf[6];
     uint8_t LSB2FSV = 3; // 3mG - 14 bit
 
-    // set magData to zero for case of failed read
-    mag->magADCRaw[X] = 0;
-    mag->magADCRaw[Y] = 0;
-    mag->magADCRaw[Z] = 0;
+    // Over I2C it's the reading queued by the previous call, keep the last one until it arrives
+    const busReadStatus_e status = busReadBufDeferred(&ist8310DataRead, mag->busDev, IST8310_REG_DATA, buf, 6);
+    if (status == BUS_READ_PENDING) {
+        return true;
+    }
 
-    bool ack = busReadBuf(mag->busDev, IST8310_REG_DATA, buf, 6);
-    if (!ack) {
+    if (status != BUS_READ_DONE) {
+        // set magData to zero for case of failed read
+        mag->magADCRaw[X] = 0;
+        mag->magADCRaw[Y] = 0;
+        mag->magADCRaw[Z] = 0;
         return false;
     }
 
@@ -80,6 +80,8 @@
 #define QMC5883L_REG_ID 0x0D
 #define QMC5883_ID_VAL 0xFF
 
+static busDeferredRead_t qmc5883DataRead;
+
 static bool qmc5883Init(magDev_t * mag)
 {
     bool ack = true;
@@ -94,22 +96,22 @@ static bool qmc5883Init(magDev_t * mag)
 
 static bool qmc5883Read(magDev_t * mag)
 {
-    uint8_t status;
     uint8_t buf[6];
 
-    // set magData to zero for case of failed read
-    mag->magADCRaw[X] = 0;
-    mag->magADCRaw[Y] = 0;
-    mag->magADCRaw[Z] = 0;
-
-    bool ack = busRead(mag->busDev, QMC5883L_REG_STATUS, &status);
-    if (!ack || (status & 0x04) == 0) {
-        return false;
-    }
-
-    ack = busReadBuf(mag->busDev, QMC5883L_REG_DATA_OUTPUT_X, buf, 6);
-    if (!ack) {
-        return false;
+    // In continuous mode at 200Hz there's always a new sample, no need to check
+    // the status first. Over I2C it's the reading queued by the previous call.
+    switch (busReadBufDeferred(&qmc5883DataRead, mag->busDev, QMC5883L_REG_DATA_OUTPUT_X, buf, 6)) {
+        case BUS_READ_DONE:
+            break;
+        case BUS_READ_PENDING:
+            // keep the last reading until the next one arrives
+            return true;
+        default:
+            // set magData to zero for case of failed read
+            mag->magADCRaw[X] = 0;
+            mag->magADCRaw[Y] = 0;
+            mag->magADCRaw[Z] = 0;
+            return false;
     }
 
     mag->magADCRaw[X] = (int16_t)(buf[1] << 8 | buf[0]);
@@ -60,12 +60,11 @@ static bool displayEmulateTextAttributes(displayPort_t *instance,
                                         char *buf, size_t length,
                                         textAttributes_t *attr)
 {
-    UNUSED(instance);
-
     // We only emulate blink for now, so there's no need to test
     // for it again.
     TEXT_ATTRIBUTES_REMOVE_BLINK(*attr);
-    if ((millis() / SW_BLINK_CYCLE_MS) % 2) {
+    instance->emulatedBlinkCount++;
+    if (displayEmulatedBlinkPhase()) {
         memset(buf, ' ', length);
         buf[length] = '\0';
         // Tell the caller to use buf
@@ -88,11 +87,18 @@ static void displayUpdateMaxChar(displayPort_t *instance)
     }
 }
 
+// Returns true while software blinked text is hidden
+bool displayEmulatedBlinkPhase(void)
+{
+    return (millis() / SW_BLINK_CYCLE_MS) % 2;
+}
+
 void displayClearScreen(displayPort_t *instance)
 {
     instance->vTable->clearScreen(instance);
     instance->cleared = true;
     instance->cursorRow = -1;
+    instance->clearCount++;
 }
 
 void displayDrawScreen(displayPort_t *instance)
@@ -113,6 +119,7 @@ void displayGrab(displayPort_t *instance)
 {
     instance->vTable->grab(instance);
     instance->vTable->clearScreen(instance);
+    instance->clearCount++;
     ++instance->grabCount;
 }
 
@@ -122,6 +129,7 @@ void displayRelease(displayPort_t *instance)
     // displayPort_t is changing owner. Clear it, since
     // the new owner might expect a clear canvas.
     instance->vTable->clearScreen(instance);
+    instance->clearCount++;
     --instance->grabCount;
 }
 
@@ -305,6 +313,7 @@ void displayInit(displayPort_t *instance, const displayPortVTable_t *vTable)
     instance->vTable->clearScreen(instance);
     instance->useFullscreen = false;
     instance->cleared = true;
+    instance->clearCount++;
     instance->grabCount = 0;
     instance->cursorRow = -1;
     instance->cachedSupportedTextAttributes = TEXT_ATTRIBUTES_NONE;
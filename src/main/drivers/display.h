@@ -81,6 +81,10 @@ typedef struct displayPort_s {
     int8_t grabCount;
     textAttributes_t cachedSupportedTextAttributes;
     uint16_t maxChar;
+
+    // Change tracking for clients which only redraw what changed
+    uint8_t clearCount;             // Incremented each time the screen is cleared
+    uint8_t emulatedBlinkCount;     // Incremented on each write using software blink
 } displayPort_t;
 
 typedef struct displayPortVTable_s {
@@ -118,6 +122,7 @@ void displayRelease(displayPort_t *instance);
 void displayReleaseAll(displayPort_t *instance);
 bool displayIsGrabbed(const displayPort_t *instance);
 void displayClearScreen(displayPort_t *instance);
+bool displayEmulatedBlinkPhase(void);
 void displayDrawScreen(displayPort_t *instance);
 int displayScreenSize(const displayPort_t *instance);
 void displaySetXY(displayPort_t *instance, uint8_t x, uint8_t y);
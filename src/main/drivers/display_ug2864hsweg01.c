@@ -24,6 +24,8 @@
 
 #ifdef USE_OLED_UG2864
 
+#include "common/maths.h"
+
 #include "drivers/bus.h"
 #include "drivers/bus_i2c.h"
 #include "drivers/time.h"
@@ -174,8 +176,33 @@ static const uint8_t multiWiiFont[][5] = { // Refer to "Times New Roman" Font Da
 
 // #define OLED_address   0x3C     // OLED at address 0x3C in 7bit
 
+#define OLED_PAGE_COUNT (SCREEN_HEIGHT / 8)
+
 static busDevice_t *busDev = NULL;
 
+// Copy of the display RAM. Drawing only updates this and marks the changed
+// columns of each page, i2c_OLED_update() then sends them a page at a time
+// so the bus shared with the other I2C sensors is never held for longer.
+static uint8_t frameBuffer[OLED_PAGE_COUNT][SCREEN_WIDTH];
+static uint8_t dirtyStart[OLED_PAGE_COUNT];     // Columns [dirtyStart, dirtyEnd) need to be sent
+static uint8_t dirtyEnd[OLED_PAGE_COUNT];
+static uint8_t nextFlushPage;
+
+#ifdef USE_I2C
+// The page span being sent in the background by i2c_OLED_update()
+static uint8_t pageAddress[3];
+static busI2CTransaction_t pageAddressTxn;
+static busI2CTransaction_t pageDataTxn;
+static uint8_t sentPage;
+static uint8_t sentStart;
+static uint8_t sentEnd;
+#endif
+
+// Position of the next i2c_OLED_send_byte(), advancing like the display's
+// horizontal addressing mode
+static uint8_t cursorPage;
+static uint8_t cursorColumn;
+
 static bool i2c_OLED_send_cmd(uint8_t command)
 {
     if (!busDev) {
@@ -185,13 +212,167 @@ static bool i2c_OLED_send_cmd(uint8_t command)
     return busWrite(busDev, 0x80, command);
 }
 
+static void i2c_OLED_mark_dirty(uint8_t page, uint8_t startColumn, uint8_t endColumn)
+{
+    dirtyStart[page] = MIN(dirtyStart[page], startColumn);
+    dirtyEnd[page] = MAX(dirtyEnd[page], endColumn);
+}
+
+void i2c_OLED_invalidate(void)
+{
+    for (int page = 0; page < OLED_PAGE_COUNT; page++) {
+        i2c_OLED_mark_dirty(page, 0, SCREEN_WIDTH);
+    }
+}
+
 bool i2c_OLED_send_byte(uint8_t val)
 {
     if (!busDev) {
         return false;
     }
 
-    return busWrite(busDev, 0x40, val);
+    if (frameBuffer[cursorPage][cursorColumn] != val) {
+        frameBuffer[cursorPage][cursorColumn] = val;
+        i2c_OLED_mark_dirty(cursorPage, cursorColumn, cursorColumn + 1);
+    }
+
+    if (++cursorColumn == SCREEN_WIDTH) {
+        cursorColumn = 0;
+        cursorPage = (cursorPage + 1) % OLED_PAGE_COUNT;
+    }
+
+    return true;
+}
+
+static int i2c_OLED_next_dirty_page(void)
+{
+    for (int ii = 0; ii < OLED_PAGE_COUNT; ii++) {
+        const uint8_t page = (nextFlushPage + ii) % OLED_PAGE_COUNT;
+        if (dirtyStart[page] < dirtyEnd[page]) {
+            return page;
+        }
+    }
+    return -1;
+}
+
+static void i2c_OLED_set_page_address(uint8_t *address, uint8_t page, uint8_t column)
+{
+    address[0] = 0xb0 + page;                // set page address
+    address[1] = 0x00 + (column & 0x0f);     // set low col address
+    address[2] = 0x10 + (column >> 4);       // set high col address
+}
+
+static void i2c_OLED_clear_page_dirty(uint8_t page)
+{
+    dirtyStart[page] = SCREEN_WIDTH;
+    dirtyEnd[page] = 0;
+    nextFlushPage = (page + 1) % OLED_PAGE_COUNT;
+}
+
+// Sends a dirty page span, waiting for the bus. Used during init and on
+// buses without a transaction queue.
+static bool i2c_OLED_flush_page_blocking(void)
+{
+    const int page = i2c_OLED_next_dirty_page();
+    if (page < 0) {
+        return false;
+    }
+
+    const uint8_t start = dirtyStart[page];
+    uint8_t address[3];
+    i2c_OLED_set_page_address(address, page, start);
+    // Control byte 0x00 is followed by commands, 0x40 by display data
+    if (!busWriteBuf(busDev, 0x00, address, sizeof(address)) ||
+        !busWriteBuf(busDev, 0x40, &frameBuffer[page][start], dirtyEnd[page] - start)) {
+        return false;
+    }
+
+    i2c_OLED_clear_page_dirty(page);
+    return true;
+}
+
+#ifdef USE_I2C
+static void i2c_OLED_data_done(busI2CTransaction_t * txn)
+{
+    // The span is in an unknown state, send it again
+    if (txn->state != I2C_TXN_DONE) {
+        i2c_OLED_mark_dirty(sentPage, sentStart, sentEnd);
+    }
+}
+
+static void i2c_OLED_address_done(busI2CTransaction_t * txn)
+{
+    // The data goes to wherever the address points, only send it once that's set
+    if (txn->state != I2C_TXN_DONE || !i2cBusSubmit(&pageDataTxn)) {
+        i2c_OLED_mark_dirty(sentPage, sentStart, sentEnd);
+    }
+}
+
+bool i2c_OLED_update(void)
+{
+    if (!busDev || i2cBusIsTransactionPending(&pageAddressTxn) || i2cBusIsTransactionPending(&pageDataTxn)) {
+        return false;
+    }
+
+    const int page = i2c_OLED_next_dirty_page();
+    if (page < 0) {
+        return false;
+    }
+
+    sentPage = page;
+    sentStart = dirtyStart[page];
+    sentEnd = dirtyEnd[page];
+    i2c_OLED_set_page_address(pageAddress, sentPage, sentStart);
+
+    // Queued behind the sensors, the bus is only polled from the main loop.
+    // The data is submitted once the address has been written.
+    pageAddressTxn = (busI2CTransaction_t) {
+        .dev = busDev, .reg = 0x00, .buf = pageAddress, .length = sizeof(pageAddress),
+        .callback = i2c_OLED_address_done,
+    };
+    pageDataTxn = (busI2CTransaction_t) {
+        .dev = busDev, .reg = 0x40, .buf = &frameBuffer[sentPage][sentStart], .length = sentEnd - sentStart,
+        .callback = i2c_OLED_data_done,
+    };
+
+    // Drawing after this point marks the page dirty again. Cleared before
+    // submitting, the address might complete (and fail) right away.
+    i2c_OLED_clear_page_dirty(sentPage);
+
+    if (!i2cBusSubmit(&pageAddressTxn)) {
+        // Bus without a transaction queue, send the same page right away
+        i2c_OLED_mark_dirty(sentPage, sentStart, sentEnd);
+        nextFlushPage = sentPage;
+        return i2c_OLED_flush_page_blocking();
+    }
+
+    return true;
+}
+#else
+bool i2c_OLED_update(void)
+{
+    if (!busDev) {
+        return false;
+    }
+
+    return i2c_OLED_flush_page_blocking();
+}
+#endif
+
+bool i2c_OLED_is_dirty(void)
+{
+#ifdef USE_I2C
+    if (i2cBusIsTransactionPending(&pageAddressTxn) || i2cBusIsTransactionPending(&pageDataTxn)) {
+        return true;
+    }
+#endif
+
+    for (int page = 0; page < OLED_PAGE_COUNT; page++) {
+        if (dirtyStart[page] < dirtyEnd[page]) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void i2c_OLED_clear_display(void)
@@ -200,13 +381,17 @@ void i2c_OLED_clear_display(void)
     i2c_OLED_send_cmd(0xae);              // Display OFF
     i2c_OLED_send_cmd(0x20);              // Set Memory Addressing Mode
     i2c_OLED_send_cmd(0x00);              // Set Memory Addressing Mode to Horizontal addressing mode
-    i2c_OLED_send_cmd(0xb0);              // set page address to 0
     i2c_OLED_send_cmd(0x40);              // Display start line register to 0
-    i2c_OLED_send_cmd(0);                 // Set low col address to 0
-    i2c_OLED_send_cmd(0x10);              // Set high col address to 0
-    for (uint16_t i = 0; i < 1024; i++) {  // fill the display's RAM with graphic... 128*64 pixel picture
-        i2c_OLED_send_byte(0x00);  // clear
+
+    // The display RAM contents are unknown, send all of it before turning it on
+    memset(frameBuffer, 0, sizeof(frameBuffer));
+    i2c_OLED_invalidate();
+    for (int page = 0; page < OLED_PAGE_COUNT; page++) {
+        if (!i2c_OLED_flush_page_blocking()) {
+            break;
+        }
     }
+
     i2c_OLED_send_cmd(0x81);              // Setup CONTRAST CONTROL, following byte is the contrast Value... always a 2 byte instruction
     i2c_OLED_send_cmd(200);               // Here you can set the brightness 1 = dull, 255 is very bright
     i2c_OLED_send_cmd(0xaf);              // display on
@@ -214,10 +399,7 @@ void i2c_OLED_clear_display(void)
 
 void i2c_OLED_clear_display_quick(void)
 {
-    i2c_OLED_send_cmd(0xb0);              // set page address to 0
-    i2c_OLED_send_cmd(0x40);              // Display start line register to 0
-    i2c_OLED_send_cmd(0);                 // Set low col address to 0
-    i2c_OLED_send_cmd(0x10);              // Set high col address to 0
+    i2c_OLED_set_line(0);
     for (uint16_t i = 0; i < 1024; i++) {      // fill the display's RAM with graphic... 128*64 pixel picture
         i2c_OLED_send_byte(0x00);  // clear
     }
@@ -225,16 +407,14 @@ void i2c_OLED_clear_display_quick(void)
 
 void i2c_OLED_set_xy(uint8_t col, uint8_t row)
 {
-    i2c_OLED_send_cmd(0xb0 + row);                      //set page address
-    i2c_OLED_send_cmd(0x00 + ((CHARACTER_WIDTH_TOTAL * col) & 0x0f));         //set low col address
-    i2c_OLED_send_cmd(0x10 + (((CHARACTER_WIDTH_TOTAL * col) >> 4) & 0x0f));  //set high col address
+    cursorPage = row % OLED_PAGE_COUNT;
+    cursorColumn = (CHARACTER_WIDTH_TOTAL * col) % SCREEN_WIDTH;
 }
 
 void i2c_OLED_set_line(uint8_t row)
 {
-    i2c_OLED_send_cmd(0xb0 + row); //set page address
-    i2c_OLED_send_cmd(0);          //set low col address
-    i2c_OLED_send_cmd(0x10);       //set high col address
+    cursorPage = row % OLED_PAGE_COUNT;
+    cursorColumn = 0;
 }
 
 void i2c_OLED_send_char(unsigned char ascii)
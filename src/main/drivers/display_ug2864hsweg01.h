@@ -43,4 +43,7 @@ void i2c_OLED_send_string(const char *string);
 bool i2c_OLED_send_byte(uint8_t val);
 void i2c_OLED_clear_display(void);
 void i2c_OLED_clear_display_quick(void);
+void i2c_OLED_invalidate(void);
+bool i2c_OLED_update(void);
+bool i2c_OLED_is_dirty(void);
 
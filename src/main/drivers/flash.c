@@ -76,6 +76,14 @@ bool flashWaitForReady(timeMs_t timeoutMillis)
     return false;
 }
 
+int flashGetProgramBudget(void)
+{
+#ifdef USE_FLASH_M25P16
+    return m25p16_getProgramBudget();
+#endif
+    return 0;
+}
+
 void flashEraseSector(uint32_t address)
 {
 #ifdef USE_FLASH_M25P16
@@ -40,6 +40,7 @@ bool flashInit(void);
 
 bool flashIsReady(void);
 bool flashWaitForReady(timeMs_t timeoutMillis);
+int flashGetProgramBudget(void);
 void flashEraseSector(uint32_t address);
 void flashEraseCompletely(void);
 #if 0
@@ -22,6 +22,8 @@
 
 #ifdef USE_FLASH_M25P16
 
+#include "common/maths.h"
+
 #include "flash_m25p16.h"
 #include "drivers/io.h"
 #include "drivers/bus.h"
@@ -126,6 +128,17 @@ bool m25p16_waitForReady(uint32_t timeoutMillis)
     return true;
 }
 
+/**
+ * The number of bytes which can be programmed now without delaying a more important device sharing the SPI bus.
+ */
+int m25p16_getProgramBudget(void)
+{
+    // Write enable and page program commands are sent too
+    const int overhead = 1 + (isLargeFlash ? 5 : 4);
+
+    return MAX(busGetTransferBudget(busDev) - overhead, 0);
+}
+
 /**
  * Read chip identification and geometry information (into global `geometry`).
  *
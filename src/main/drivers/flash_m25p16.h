@@ -34,5 +34,6 @@ int m25p16_readBytes(uint32_t address, uint8_t *buffer, int length);
 
 bool m25p16_isReady(void);
 bool m25p16_waitForReady(uint32_t timeoutMillis);
+int m25p16_getProgramBudget(void);
 
 const flashGeometry_t* m25p16_getGeometry(void);
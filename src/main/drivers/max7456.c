@@ -36,6 +36,7 @@ FILE_COMPILE_FOR_SPEED
 #include "build/debug.h"
 
 #include "common/bitarray.h"
+#include "common/maths.h"
 #include "common/printf.h"
 #include "common/utils.h"
 
@@ -192,9 +193,21 @@ FILE_COMPILE_FOR_SPEED
 // is faster than redrawing the whole screen on each frame.
 static BITARRAY_DECLARE(screenIsDirty, MAX7456_BUFFER_CHARS_PAL);
 
-//max chars to update in one idle
+//max SPI bytes to send in one idle, enough for 10 individually addressed chars
 #define MAX_CHARS2UPDATE        10
 #define BYTES_PER_CHAR2UPDATE   (7 * 2) // SPI regs + values for them
+#define MAX_BYTES2UPDATE        (MAX_CHARS2UPDATE * BYTES_PER_CHAR2UPDATE)
+
+// Consecutive dirty chars with the same attributes are sent in auto-increment
+// mode: the start address once, then only DMDI writes. A run costs
+// RUN_OVERHEAD + 2 bytes per char (twice that for extended chars, which need
+// an attribute and a character pass) versus 6 (12) bytes per char otherwise.
+// Writing END_STRING to DMDI leaves auto-increment mode, so that character
+// can't be part of a run and is always sent on its own.
+#define RUN_MIN_LENGTH          3   // Shorter runs are cheaper with per char addressing
+#define RUN_MAX_GAP             4   // Clean chars rewritten to join two runs, cheaper than restarting
+#define RUN_OVERHEAD            (5 * 2) // DMM, DMAH, DMAL, DMDI end marker, DMM restore
+#define RUN_EXT_OVERHEAD        (9 * 2) // DMM, DMAH, DMAL, end marker, twice, and DMM restore
 
 typedef struct max7456Registers_s {
     uint8_t vm0;
@@ -485,19 +498,122 @@ void max7456Write(uint8_t x, uint8_t y, const char *buff, uint8_t mode)
     }
 }
 
+// Returns the number of chars starting at pos that can be sent as a single
+// auto-increment run: same attributes, no END_STRING chars and at
+// most RUN_MAX_GAP clean chars between dirty ones. The run ends on a dirty char.
+static unsigned max7456FindRun(unsigned pos)
+{
+    const uint16_t first = osdCharacterGridBuffer[pos];
+    unsigned length = 1;
+
+    if (CHAR_BYTE(first) == END_STRING) {
+        return 1;
+    }
+
+    for (unsigned ii = pos + 1; ii < ARRAYLEN(osdCharacterGridBuffer); ii++) {
+        const uint16_t val = osdCharacterGridBuffer[ii];
+        if (MODE_BYTE(val) != MODE_BYTE(first) || CHAR_BYTE(val) == END_STRING) {
+            break;
+        }
+        if (bitArrayGet(screenIsDirty, ii)) {
+            length = ii - pos + 1;
+        } else if (ii - (pos + length) >= RUN_MAX_GAP) {
+            break;
+        }
+    }
+
+    return length;
+}
+
+static int max7456PrepareChar(uint8_t * buf, size_t bufsize, int bufPtr, unsigned pos)
+{
+    const uint8_t ph = pos >> 8;
+    const uint8_t pl = pos & 0xff;
+    const uint8_t charMode = MODE_BYTE(osdCharacterGridBuffer[pos]);
+    const uint8_t chr = CHAR_BYTE(osdCharacterGridBuffer[pos]);
+
+    if (CHAR_MODE_IS_EXT(charMode)) {
+        if (!DMM_IS_8BIT_MODE(state.registers.dmm)) {
+            state.registers.dmm |= DMM_8BIT_MODE;
+            bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMM, state.registers.dmm);
+        }
+
+        bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMAH, ph | DMAH_8_BIT_DMDI_IS_CHAR_ATTR);
+        bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMAL, pl);
+        // Attribute bit positions on DMDI are 2 bits up relative to DMM.
+        // DMM uses [5:3] while DMDI uses [7:4] - one bit more for referencing
+        // characters in the [256, 511] range (which is not possible via DMM).
+        // Since we write mostly to DMM, the internal representation uses
+        // the format of the former and we shift it up here.
+        bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMDI, charMode << 2);
+
+        bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMAH, ph);
+        bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMAL, pl);
+        bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMDI, chr);
+
+    } else {
+        if (DMM_IS_8BIT_MODE(state.registers.dmm) || (DMM_CHAR_MODE_MASK & state.registers.dmm) != charMode) {
+            state.registers.dmm &= ~DMM_8BIT_MODE;
+            state.registers.dmm = (state.registers.dmm & ~DMM_CHAR_MODE_MASK) | charMode;
+            // Send the attributes for the character run. They
+            // will be applied to all characters until we change
+            // the DMM register.
+            bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMM, state.registers.dmm);
+        }
+
+        bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMAH, ph);
+        bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMAL, pl);
+        bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMDI, chr);
+    }
+
+    return bufPtr;
+}
+
+static int max7456PrepareRunPass(uint8_t * buf, size_t bufsize, int bufPtr, unsigned pos, unsigned length, uint8_t dmah, bool attributes)
+{
+    bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMM, state.registers.dmm | DMM_AUTOINCREMENT);
+    bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMAH, (pos >> 8) | dmah);
+    bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMAL, pos & 0xff);
+
+    for (unsigned ii = pos; ii < pos + length; ii++) {
+        const uint16_t val = osdCharacterGridBuffer[ii];
+        // See max7456PrepareChar() for the attribute shift
+        bufPtr = max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMDI, attributes ? MODE_BYTE(val) << 2 : CHAR_BYTE(val));
+    }
+
+    return max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMDI, END_STRING);
+}
+
+static int max7456PrepareRun(uint8_t * buf, size_t bufsize, int bufPtr, unsigned pos, unsigned length)
+{
+    const uint8_t charMode = MODE_BYTE(osdCharacterGridBuffer[pos]);
+
+    if (CHAR_MODE_IS_EXT(charMode)) {
+        state.registers.dmm |= DMM_8BIT_MODE;
+        bufPtr = max7456PrepareRunPass(buf, bufsize, bufPtr, pos, length, DMAH_8_BIT_DMDI_IS_CHAR_ATTR, true);
+        bufPtr = max7456PrepareRunPass(buf, bufsize, bufPtr, pos, length, 0, false);
+    } else {
+        state.registers.dmm = (state.registers.dmm & ~(DMM_8BIT_MODE | DMM_CHAR_MODE_MASK)) | charMode;
+        bufPtr = max7456PrepareRunPass(buf, bufsize, bufPtr, pos, length, 0, false);
+    }
+
+    // Leave auto-increment mode with the run's attributes selected
+    return max7456PrepareBuffer(buf, bufsize, bufPtr, MAX7456ADD_DMM, state.registers.dmm);
+}
+
 // Must be called with the lock held. Returns whether any new characters
 // were drawn.
 static bool max7456DrawScreenPartial(void)
 {
-    uint8_t spiBuff[MAX_CHARS2UPDATE * BYTES_PER_CHAR2UPDATE];
+    uint8_t spiBuff[MAX_BYTES2UPDATE];
     int bufPtr = 0;
-    size_t pos;
-    uint_fast16_t updatedCharCount;
-    uint8_t charMode;
-    int next;
+    unsigned pos = 0;
+
+    // Send less when the next gyro read on a shared bus is close
+    const int bufSize = MIN((int32_t)sizeof(spiBuff), busGetTransferBudget(state.dev));
 
-    for (pos = 0, updatedCharCount = 0; pos < ARRAYLEN(osdCharacterGridBuffer);) {
-        next = BITARRAY_FIND_FIRST_SET(screenIsDirty, pos);
+    while (pos < ARRAYLEN(osdCharacterGridBuffer)) {
+        int next = BITARRAY_FIND_FIRST_SET(screenIsDirty, pos);
         if (next < 0) {
             // No more dirty chars.
             break;
@@ -505,54 +621,31 @@ static bool max7456DrawScreenPartial(void)
         pos = next;
         if (pos >= ARRAYLEN(osdCharacterGridBuffer)) {
             BOUNDS_CHECK_FAILED();
+            break;
         }
 
-        // Found one dirty character to send
-        uint8_t ph = pos >> 8;
-        uint8_t pl = pos & 0xff;
-
-        charMode = MODE_BYTE(osdCharacterGridBuffer[pos]);
-        uint8_t chr = CHAR_BYTE(osdCharacterGridBuffer[pos]);
-        if (CHAR_MODE_IS_EXT(charMode)) {
-            if (!DMM_IS_8BIT_MODE(state.registers.dmm)) {
-                state.registers.dmm |= DMM_8BIT_MODE;
-                bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMM, state.registers.dmm);
-            }
+        const bool isExt = CHAR_MODE_IS_EXT(MODE_BYTE(osdCharacterGridBuffer[pos]));
+        const unsigned bytesPerChar = isExt ? 4 : 2;
+        const int overhead = isExt ? RUN_EXT_OVERHEAD : RUN_OVERHEAD;
+        const int available = bufSize - bufPtr;
 
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAH, ph | DMAH_8_BIT_DMDI_IS_CHAR_ATTR);
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAL, pl);
-            // Attribute bit positions on DMDI are 2 bits up relative to DMM.
-            // DMM uses [5:3] while DMDI uses [7:4] - one bit more for referencing
-            // characters in the [256, 511] range (which is not possible via DMM).
-            // Since we write mostly to DMM, the internal representation uses
-            // the format of the former and we shift it up here.
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, charMode << 2);
-
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAH, ph);
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAL, pl);
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, chr);
+        // Clip the run to the space left in this update, the rest is sent next time
+        unsigned length = MIN(max7456FindRun(pos), (unsigned)MAX(available - overhead, 0) / bytesPerChar);
 
+        if (length >= RUN_MIN_LENGTH) {
+            bufPtr = max7456PrepareRun(spiBuff, bufSize, bufPtr, pos, length);
+        } else if (available >= (isExt ? 7 : 4) * 2) {
+            // Single char, including a possible DMM change
+            length = 1;
+            bufPtr = max7456PrepareChar(spiBuff, bufSize, bufPtr, pos);
         } else {
-            if (DMM_IS_8BIT_MODE(state.registers.dmm) || (DMM_CHAR_MODE_MASK & state.registers.dmm) != charMode) {
-                state.registers.dmm &= ~DMM_8BIT_MODE;
-                state.registers.dmm = (state.registers.dmm & ~DMM_CHAR_MODE_MASK) | charMode;
-                // Send the attributes for the character run. They
-                // will be applied to all characters until we change
-                // the DMM register.
-                bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMM, state.registers.dmm);
-            }
-
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAH, ph);
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMAL, pl);
-            bufPtr = max7456PrepareBuffer(spiBuff, sizeof(spiBuff), bufPtr, MAX7456ADD_DMDI, chr);
+            break;
         }
 
-        bitArrayClr(screenIsDirty, pos);
-        if (++updatedCharCount == MAX_CHARS2UPDATE) {
-            break;
+        for (unsigned ii = pos; ii < pos + length; ii++) {
+            bitArrayClr(screenIsDirty, ii);
         }
-        // Start next search at next bit
-        pos++;
+        pos += length;
     }
 
     if (bufPtr) {
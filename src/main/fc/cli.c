@@ -3224,6 +3224,17 @@ static void cliStatus(char *cmdline)
 
     cliPrintLinef("I2C Errors: %d, config size: %d, max available config: %d", i2cErrorCounter, getEEPROMConfigSize(), &__config_end - &__config_start);
 
+#ifdef USE_I2C
+    for (int bus = 0; bus < I2CDEV_COUNT; bus++) {
+        i2cBusStats_t stats;
+        if (i2cBusGetStats(bus, &stats) && stats.transfers > 0) {
+            cliPrintLinef("I2C%d: transfers: %u, NACKs: %u, errors: %u, expired: %u, busy: %u%%, max queued: %u",
+                bus + 1, stats.transfers, stats.nacks, stats.errors, stats.expired,
+                (unsigned)(stats.busyTimeUs / (10 * millis())), stats.maxQueued);
+        }
+    }
+#endif
+
 #ifdef USE_ADC
     static char * adcFunctions[] = { "BATTERY", "RSSI", "CURRENT", "AIRSPEED" };
     cliPrintLine("ADC channel usage:");
@@ -3254,6 +3265,7 @@ static void cliStatus(char *cmdline)
     const int rxRate = getTaskDeltaTime(TASK_RX) == 0 ? 0 : (int)(1000000.0f / ((float)getTaskDeltaTime(TASK_RX)));
     const int systemRate = getTaskDeltaTime(TASK_SYSTEM) == 0 ? 0 : (int)(1000000.0f / ((float)getTaskDeltaTime(TASK_SYSTEM)));
     cliPrintLinef(", cycle time: %d, PID rate: %d, RX rate: %d, System rate: %d",  (uint16_t)cycleTime, pidRate, rxRate, systemRate);
+    cliPrintLinef("RX frame interval: %d us, frame to output latency: %d us", (int)rxGetFrameDeltaUs(), (int)rxGetFrameLatencyUs());
 #if !defined(CLI_MINIMAL_VERBOSITY)
     cliPrint("Arming disabled flags:");
     uint32_t flags = armingFlags & ARMING_DISABLED_ALL_FLAGS;
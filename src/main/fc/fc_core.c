@@ -33,6 +33,7 @@ FILE_COMPILE_FOR_SPEED
 #include "common/utils.h"
 #include "common/filter.h"
 
+#include "drivers/bus.h"
 #include "drivers/light_led.h"
 #include "drivers/serial.h"
 #include "drivers/time.h"
@@ -57,6 +58,7 @@ FILE_COMPILE_FOR_SPEED
 #include "fc/cli.h"
 #include "fc/config.h"
 #include "fc/controlrate_profile.h"
+#include "fc/fc_msp.h"
 #include "fc/rc_adjustments.h"
 #include "fc/rc_smoothing.h"
 #include "fc/rc_controls.h"
@@ -930,6 +932,12 @@ void taskMainPidLoop(timeUs_t currentTimeUs)
         writeMotors();
     }
 
+    rxUpdateFrameLatency(micros());
+
+    if (!cliMode) {
+        mspFcStateStreamUpdate(currentTimeUs);
+    }
+
 #ifdef USE_BLACKBOX
     if (!cliMode && feature(FEATURE_BLACKBOX)) {
         blackboxUpdate(micros());
@@ -947,6 +955,10 @@ void taskRunRealtimeCallbacks(timeUs_t currentTimeUs)
     afatfs_poll();
 #endif
 
+#ifdef USE_I2C
+    i2cBusProcessQueues(currentTimeUs);
+#endif
+
 #ifdef USE_DSHOT
     pwmCompleteMotorUpdate();
 #endif
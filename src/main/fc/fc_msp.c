@@ -59,6 +59,7 @@
 #include "drivers/vtx_common.h"
 
 #include "fc/fc_core.h"
+#include "fc/cli.h"
 #include "fc/config.h"
 #include "fc/controlrate_profile.h"
 #include "fc/fc_msp.h"
@@ -94,6 +95,7 @@
 
 #include "msp/msp.h"
 #include "msp/msp_protocol.h"
+#include "msp/msp_protocol_v2_sensor_msg.h"
 #include "msp/msp_serial.h"
 
 #include "navigation/navigation.h"
@@ -334,6 +336,46 @@ static void serializeDataflashReadReply(sbuf_t *dst, uint32_t address, uint16_t
 }
 #endif
 
+#define MSP_STATE_MOTOR_COUNT 8
+
+/*
+ * Compact fixed layout vehicle state for companion computers, see MSP2_INAV_STATE.
+ * Attitude and rates are from the current PID loop iteration, position and
+ * velocity are the latest navigation estimate (NEU, cm and cm/s) and the
+ * motors are the values just written.
+ */
+static void mspFcWriteState(sbuf_t *dst, timeUs_t currentTimeUs)
+{
+    sbufWriteU32(dst, currentTimeUs);
+
+    sbufWriteU16(dst, (int16_t)lrintf(orientation.q0 * INT16_MAX));
+    sbufWriteU16(dst, (int16_t)lrintf(orientation.q1 * INT16_MAX));
+    sbufWriteU16(dst, (int16_t)lrintf(orientation.q2 * INT16_MAX));
+    sbufWriteU16(dst, (int16_t)lrintf(orientation.q3 * INT16_MAX));
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        sbufWriteU16(dst, (int16_t)constrainf(gyro.gyroADCf[axis] * 10, INT16_MIN, INT16_MAX)); // 0.1 deg/s
+    }
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        sbufWriteU32(dst, (int32_t)lrintf(getEstimatedActualPosition(axis)));
+    }
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        sbufWriteU16(dst, (int16_t)constrainf(getEstimatedActualVelocity(axis), INT16_MIN, INT16_MAX));
+    }
+
+    const int motorCount = getMotorCount();
+    for (int i = 0; i < MSP_STATE_MOTOR_COUNT; i++) {
+        sbufWriteU16(dst, i < motorCount ? motor[i] : 0);
+    }
+}
+
+void mspFcStateStreamUpdate(timeUs_t currentTimeUs)
+{
+    mspSerialProcessStateStream(currentTimeUs, mspFcWriteState);
+}
+
 /*
  * Returns true if the command was processd, false otherwise.
  * May set mspPostProcessFunc to a function to be called once the command has been processed
@@ -858,6 +900,10 @@ static bool mspFcProcessOutCommand(uint16_t cmdMSP, sbuf_t *dst, mspPostProcessF
         sbufWriteU8(dst, currentBatteryProfile->capacity.unit);
         break;
 
+    case MSP2_INAV_STATE:
+        mspFcWriteState(dst, micros());
+        break;
+
     case MSP2_INAV_MISC2:
         // Timers
         sbufWriteU32(dst, micros() / 1000000); // On time (seconds)
@@ -1105,6 +1151,22 @@ static bool mspFcProcessOutCommand(uint16_t cmdMSP, sbuf_t *dst, mspPostProcessF
         }
         break;
 
+    case MSP2_COMMON_MSP_PORT_STATS:
+        for (int i = 0; i < MAX_MSP_PORT_COUNT; i++) {
+            const mspPort_t *mspPort = mspSerialGetPort(i);
+            if (!mspPort->port) {
+                continue;
+            }
+            sbufWriteU8(dst, mspPort->port->identifier);
+            sbufWriteU32(dst, mspPort->stats.commands);
+            sbufWriteU32(dst, mspPort->stats.deferred);
+            sbufWriteU16(dst, mspPort->stats.rxQueueDepth);
+            sbufWriteU16(dst, mspPort->stats.rxQueueDepthMax);
+            sbufWriteU32(dst, mspPort->stats.latencyUs);
+            sbufWriteU32(dst, mspPort->stats.latencyMaxUs);
+        }
+        break;
+
 #ifdef USE_LED_STRIP
     case MSP_LED_COLORS:
         for (int i = 0; i < LED_CONFIGURABLE_COLOR_COUNT; i++) {
@@ -1660,6 +1722,55 @@ static void mspFcDataFlashReadCommand(sbuf_t *dst, sbuf_t *src)
 }
 #endif
 
+static mspResult_e mspFcConfigExportCommand(sbuf_t *dst, sbuf_t *src)
+{
+    // The whole-image CRC is computed once when a transfer starts (offset 0)
+    // and reused for the following blocks
+    static uint16_t exportImageSize;
+    static uint16_t exportChecksum;
+
+    uint32_t offset;
+    uint16_t readLength;
+
+    // Request payload:
+    //  uint32_t    - offset into the stored config image
+    //  uint16_t    - size of block to read (optional)
+    if (!sbufReadU32Safe(&offset, src)) {
+        return MSP_RESULT_ERROR;
+    }
+    if (!sbufReadU16Safe(&readLength, src)) {
+        readLength = 128;
+    }
+
+    const uint16_t imageSize = getEEPROMConfigSize();
+    if (imageSize == 0 || offset > imageSize) {
+        return MSP_RESULT_ERROR;
+    }
+
+    if (offset == 0 || exportImageSize != imageSize) {
+        exportImageSize = imageSize;
+        exportChecksum = getEEPROMConfigChecksum();
+    }
+
+    // Reply payload:
+    //  uint8_t     - image format (EEPROM_CONF_VERSION)
+    //  uint16_t    - total image size
+    //  uint16_t    - CRC16-CCITT of the whole image
+    //  uint32_t    - offset of the data that follows
+    //  uint8_t[]   - image data
+    const int headerSize = sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint32_t);
+    readLength = MIN(readLength, imageSize - offset);
+    readLength = MIN(readLength, sbufBytesRemaining(dst) - headerSize);
+
+    sbufWriteU8(dst, EEPROM_CONF_VERSION);
+    sbufWriteU16(dst, imageSize);
+    sbufWriteU16(dst, exportChecksum);
+    sbufWriteU32(dst, offset);
+    sbufWriteData(dst, getEEPROMConfigImage() + offset, readLength);
+
+    return MSP_RESULT_ACK;
+}
+
 static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
 {
     uint8_t tmp_u8;
@@ -3057,6 +3168,54 @@ static mspResult_e mspFcProcessInCommand(uint16_t cmdMSP, sbuf_t *src)
         return MSP_RESULT_ERROR; // will only be reached if the rollback is not ready
         break;
 #endif
+    // The imported image is loaded into RAM as it arrives and only written
+    // to EEPROM once it is complete and its checksum matches. Arming stays
+    // disabled while the RAM config is partially imported. The flag is shared
+    // with the CLI, so it's left alone while the CLI is active on another port.
+    case MSP2_INAV_CONFIG_IMPORT_PREPARE:
+        if (ARMING_FLAG(ARMED) || dataSize != sizeof(uint32_t)) {
+            return MSP_RESULT_ERROR;
+        }
+        ENABLE_ARMING_FLAG(ARMING_DISABLED_CLI);
+        if (!importEEPROMConfigPrepare(sbufReadU32(src))) {
+            readEEPROM();
+            if (!cliMode) {
+                DISABLE_ARMING_FLAG(ARMING_DISABLED_CLI);
+            }
+            return MSP_RESULT_ERROR;
+        }
+        break;
+
+    case MSP2_INAV_CONFIG_IMPORT_STORE:
+        if (ARMING_FLAG(ARMED) || dataSize < sizeof(uint32_t)) {
+            return MSP_RESULT_ERROR;
+        } else {
+            const uint32_t offset = sbufReadU32(src);
+            if (!importEEPROMConfigStore(offset, sbufPtr(src), sbufBytesRemaining(src))) {
+                return MSP_RESULT_ERROR;
+            }
+        }
+        break;
+
+    case MSP2_INAV_CONFIG_IMPORT_EXEC:
+        if (ARMING_FLAG(ARMED)) {
+            return MSP_RESULT_ERROR;
+        } else {
+            const bool imported = importEEPROMConfigFinish();
+            if (imported) {
+                writeEEPROM();
+            }
+            // Reload from EEPROM, this also restores the previous config if the import failed
+            readEEPROM();
+            if (!cliMode) {
+                DISABLE_ARMING_FLAG(ARMING_DISABLED_CLI);
+            }
+            if (!imported) {
+                return MSP_RESULT_ERROR;
+            }
+        }
+        break;
+
     case MSP2_INAV_SET_SAFEHOME:
         if (dataSize == 10) {
              uint8_t i;
@@ -3377,6 +3536,10 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
          *ret = mspFcSafeHomeOutCommand(dst, src);
          break;
 
+    case MSP2_INAV_CONFIG_EXPORT:
+        *ret = mspFcConfigExportCommand(dst, src);
+        break;
+
     default:
         // Not handled
         return false;
@@ -3384,6 +3547,21 @@ bool mspFCProcessInOutCommand(uint16_t cmdMSP, sbuf_t *dst, sbuf_t *src, mspResu
     return true;
 }
 
+#if defined(USE_NAV)
+static void mspExternalPoseReceiveNewData(sbuf_t *src)
+{
+    if (sbufBytesRemaining(src) < sizeof(mspSensorExternalPoseDataMessage_t)) {
+        return;
+    }
+
+    const mspSensorExternalPoseDataMessage_t * pkt = (const mspSensorExternalPoseDataMessage_t *)sbufPtr(src);
+    const fpVector3_t pos = { .v = { pkt->posNorth, pkt->posEast, pkt->posUp } };
+    const fpVector3_t vel = { .v = { pkt->velNorth, pkt->velEast, pkt->velUp } };
+
+    updatePositionEstimator_ExternalPoseTopic(pkt->timeUs, &pos, (pkt->flags & MSP_EXTERNAL_POSE_FLAG_VEL_VALID) ? &vel : NULL, pkt->posStd);
+}
+#endif
+
 static mspResult_e mspProcessSensorCommand(uint16_t cmdMSP, sbuf_t *src)
 {
     UNUSED(src);
@@ -3424,6 +3602,12 @@ static mspResult_e mspProcessSensorCommand(uint16_t cmdMSP, sbuf_t *src)
             mspPitotmeterReceiveNewData(sbufPtr(src));
             break;
 #endif
+
+#if defined(USE_NAV)
+        case MSP2_SENSOR_EXTERNAL_POSE:
+            mspExternalPoseReceiveNewData(src);
+            break;
+#endif
     }
 
     return MSP_RESULT_NO_REPLY;
@@ -3441,7 +3625,10 @@ mspResult_e mspFcProcessCommand(mspPacket_t *cmd, mspPacket_t *reply, mspPostPro
     // initialize reply by default
     reply->cmd = cmd->cmd;
 
-    if (MSP2_IS_SENSOR_MESSAGE(cmdMSP)) {
+    if (cmd->flags & MSP_FLAG_STREAMED) {
+        // Streamed requests carry no payload and must not change anything
+        ret = mspFcProcessOutCommand(cmdMSP, dst, mspPostProcessFn) ? MSP_RESULT_ACK : MSP_RESULT_ERROR;
+    } else if (MSP2_IS_SENSOR_MESSAGE(cmdMSP)) {
         ret = mspProcessSensorCommand(cmdMSP, src);
     } else if (mspFcProcessOutCommand(cmdMSP, dst, mspPostProcessFn)) {
         ret = MSP_RESULT_ACK;
@@ -17,7 +17,10 @@
 
 #pragma once
 
+#include "common/time.h"
+
 #include "msp/msp.h"
 
 void mspFcInit(void);
 mspResult_e mspFcProcessCommand(mspPacket_t *cmd, mspPacket_t *reply, mspPostProcessFnPtr *mspPostProcessFn);
+void mspFcStateStreamUpdate(timeUs_t currentTimeUs);
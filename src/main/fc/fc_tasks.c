@@ -521,7 +521,7 @@ cfTask_t cfTasks[TASK_COUNT] = {
     [TASK_DASHBOARD] = {
         .taskName = "DASHBOARD",
         .taskFunc = taskDashboardUpdate,
-        .desiredPeriod = TASK_PERIOD_HZ(10),
+        .desiredPeriod = TASK_PERIOD_HZ(50),      // Sends at most one display page per run
         .staticPriority = TASK_PRIORITY_LOW,
     },
 #endif
@@ -25,6 +25,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <math.h>
 
 #include "platform.h"
 
@@ -47,14 +48,34 @@
 
 #include "flight/mixer.h"
 
+#define RC_FRAME_DELTA_FILTER_TAU   0.5f
+
 static biquadFilter_t rcSmoothFilter[4];
 static float rcStickUnfiltered[4];
+static pt1Filter_t rcFrameDeltaFilter;
+static uint16_t rcFilterCutoff;
 
 static void rcInterpolationInit(int rcFilterFreqency)
 {
     for (int stick = 0; stick < 4; stick++) {
         biquadFilterInitLPF(&rcSmoothFilter[stick], rcFilterFreqency, getLooptime());
     }
+    rcFilterCutoff = rcFilterFreqency;
+}
+
+// Cutoffs above half of the measured RX frame rate would only pass the frame to frame steps through
+static uint16_t rcInterpolationCutoff(timeDelta_t frameDeltaUs)
+{
+    const uint16_t configuredCutoff = rxConfig()->rcFilterFrequency;
+
+    if (frameDeltaUs <= 0) {
+        return configuredCutoff;
+    }
+
+    const float averageFrameDeltaUs = pt1FilterApply3(&rcFrameDeltaFilter, frameDeltaUs, frameDeltaUs * 1e-6f);
+    const uint16_t nyquistCutoff = MAX(1, lrintf(500000.0f / averageFrameDeltaUs));
+
+    return MIN(configuredCutoff, nyquistCutoff);
 }
 
 void rcInterpolationApply(bool isRXDataNew)
@@ -64,9 +85,20 @@ void rcInterpolationApply(bool isRXDataNew)
 
     if (isRXDataNew) {
         if (!initDone || (initFilterFreqency != rxConfig()->rcFilterFrequency)) {
-            rcInterpolationInit(rxConfig()->rcFilterFrequency);
+            pt1FilterInitRC(&rcFrameDeltaFilter, RC_FRAME_DELTA_FILTER_TAU, 0);
+            pt1FilterReset(&rcFrameDeltaFilter, rxGetFrameDeltaUs());
+            rcInterpolationInit(rcInterpolationCutoff(rxGetFrameDeltaUs()));
             initFilterFreqency = rxConfig()->rcFilterFrequency;
             initDone = true;
+        } else {
+            // Follow the measured frame rate without disturbing the filter state
+            const uint16_t cutoff = rcInterpolationCutoff(rxGetFrameDeltaUs());
+            if (cutoff != rcFilterCutoff) {
+                for (int stick = 0; stick < 4; stick++) {
+                    biquadFilterUpdate(&rcSmoothFilter[stick], cutoff, getLooptime(), BIQUAD_Q, FILTER_LPF);
+                }
+                rcFilterCutoff = cutoff;
+            }
         }
 
         for (int stick = 0; stick < 4; stick++) {
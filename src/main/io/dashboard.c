@@ -425,6 +425,12 @@ void dashboardUpdate(timeUs_t currentTimeUs)
     static uint8_t previousArmedState = 0;
     bool pageChanging;
 
+    // Send one page of whatever changed since the last call, the CMS
+    // draws through the same framebuffer while it has the display
+    if (displayPresent) {
+        i2c_OLED_update();
+    }
+
 #ifdef USE_CMS
     static bool wasGrabbed = false;
     if (displayIsGrabbed(displayPort)) {
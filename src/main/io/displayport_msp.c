@@ -30,6 +30,7 @@
 #include "config/parameter_group_ids.h"
 
 #include "drivers/display.h"
+#include "drivers/time.h"
 
 #include "fc/fc_msp.h"
 
@@ -38,8 +39,40 @@
 #include "msp/msp_protocol.h"
 #include "msp/msp_serial.h"
 
+#define MSP_DISPLAYPORT_ROWS        13
+#define MSP_DISPLAYPORT_COLS        30
+#define MSP_OSD_MAX_STRING_LENGTH   30 // FIXME move this
+
+// Bytes on the wire for the MSPv1 frame around a payload ($M> size cmd ... crc)
+#define MSP_FRAME_OVERHEAD          6
+// A writeString is sent with a 4 byte header (subcmd, row, col, attr). Cells
+// which didn't change but sit between changed ones are sent again when that's
+// cheaper than starting a new writeString.
+#define MSP_SPAN_OVERHEAD           (MSP_FRAME_OVERHEAD + 4)
+#define MSP_SUBCMD_COST             (MSP_FRAME_OVERHEAD + 1)
+
+// Every MSP_ROW_REFRESH_MS one row is sent again even if it didn't change,
+// so a display which connected late or lost a frame catches up.
+#define MSP_ROW_REFRESH_MS          250
+#define MSP_HEARTBEAT_INTERVAL_MS   500
+
 static displayPort_t mspDisplayPort;
 
+// The OSD draws into screen and drawScreen() sends the cells which differ
+// from remote, our copy of what the display shows.
+static struct {
+    uint8_t screen[MSP_DISPLAYPORT_ROWS][MSP_DISPLAYPORT_COLS];
+    uint8_t remote[MSP_DISPLAYPORT_ROWS][MSP_DISPLAYPORT_COLS];
+    uint16_t staleRows;         // Rows to send in full, regardless of remote
+    bool clearRemote;           // Send a clear before the next update
+    bool screenCleared;         // screen was cleared since the last update
+    uint8_t refreshRow;
+    timeMs_t nextRowRefreshMs;
+    timeMs_t nextHeartbeatMs;
+} mspScreen;
+
+static uint8_t blankRow[MSP_DISPLAYPORT_COLS];
+
 extern uint8_t cliMode;
 
 static int output(displayPort_t *displayPort, uint8_t cmd, uint8_t *buf, int len)
@@ -53,19 +86,30 @@ static int output(displayPort_t *displayPort, uint8_t cmd, uint8_t *buf, int len
     return mspSerialPush(cmd, buf, len);
 }
 
-static int heartbeat(displayPort_t *displayPort)
+static int sendHeartbeat(displayPort_t *displayPort)
 {
     uint8_t subcmd[] = { 0 };
 
+    mspScreen.nextHeartbeatMs = millis() + MSP_HEARTBEAT_INTERVAL_MS;
+    return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
+}
+
+static int heartbeat(displayPort_t *displayPort)
+{
     // heartbeat is used to:
     // a) ensure display is not released by MW OSD software
     // b) prevent OSD Slave boards from displaying a 'disconnected' status.
-    return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
+    // The OSD calls this on every refresh, the remote side times out
+    // after 1s so there's no need to send it that often.
+    if (millis() < mspScreen.nextHeartbeatMs) {
+        return 0;
+    }
+    return sendHeartbeat(displayPort);
 }
 
 static int grab(displayPort_t *displayPort)
 {
-    return heartbeat(displayPort);
+    return sendHeartbeat(displayPort);
 }
 
 static int release(displayPort_t *displayPort)
@@ -77,13 +121,151 @@ static int release(displayPort_t *displayPort)
 
 static int clearScreen(displayPort_t *displayPort)
 {
-    uint8_t subcmd[] = { 2 };
+    UNUSED(displayPort);
 
-    return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
+    // Only the local copy, drawScreen() decides if sending a clear is
+    // cheaper than blanking the cells which were drawn before
+    memset(mspScreen.screen, ' ', sizeof(mspScreen.screen));
+    mspScreen.screenCleared = true;
+    return 0;
+}
+
+// Finds the next span of cells in row which differ from ref, starting
+// at *end. Returns false when there are no more changes in the row.
+static bool findChangedSpan(const uint8_t *row, const uint8_t *ref, int *start, int *end)
+{
+    int col = *end;
+    while (col < MSP_DISPLAYPORT_COLS && row[col] == ref[col]) {
+        col++;
+    }
+    if (col == MSP_DISPLAYPORT_COLS) {
+        return false;
+    }
+
+    *start = col;
+    int last = col;
+    for (col++; col < MSP_DISPLAYPORT_COLS; col++) {
+        if (row[col] != ref[col]) {
+            if (col - last - 1 > MSP_SPAN_OVERHEAD) {
+                break;
+            }
+            last = col;
+        }
+    }
+    *end = last + 1;
+    return true;
+}
+
+// Bytes needed to bring a display showing ref (or remote, when ref is
+// NULL) up to date with screen
+static int updateCost(const uint8_t *ref)
+{
+    int cost = 0;
+    for (int row = 0; row < MSP_DISPLAYPORT_ROWS; row++) {
+        if (mspScreen.staleRows & (1 << row)) {
+            cost += MSP_DISPLAYPORT_COLS + MSP_SPAN_OVERHEAD;
+            continue;
+        }
+        const uint8_t *rowRef = ref ? ref : mspScreen.remote[row];
+        int start;
+        int end = 0;
+        while (findChangedSpan(mspScreen.screen[row], rowRef, &start, &end)) {
+            cost += end - start + MSP_SPAN_OVERHEAD;
+        }
+    }
+    return cost;
+}
+
+static int sendSpan(displayPort_t *displayPort, int row, int start, int end)
+{
+    uint8_t buf[MSP_OSD_MAX_STRING_LENGTH + 4];
+    const int len = end - start;
+
+    buf[0] = 3;
+    buf[1] = row;
+    buf[2] = start;
+    buf[3] = 0;
+    memcpy(&buf[4], &mspScreen.screen[row][start], len);
+    memcpy(&mspScreen.remote[row][start], &mspScreen.screen[row][start], len);
+
+    return output(displayPort, MSP_DISPLAYPORT, buf, len + 4);
+}
+
+// Sends the changes in a row while they fit in bytesFree, returns false
+// when some were left for the next update
+static bool sendRow(displayPort_t *displayPort, int row, uint32_t *bytesFree, bool *updated)
+{
+    if (mspScreen.staleRows & (1 << row)) {
+        if (*bytesFree < MSP_DISPLAYPORT_COLS + MSP_SPAN_OVERHEAD) {
+            return false;
+        }
+        sendSpan(displayPort, row, 0, MSP_DISPLAYPORT_COLS);
+        *bytesFree -= MSP_DISPLAYPORT_COLS + MSP_SPAN_OVERHEAD;
+        mspScreen.staleRows &= ~(1 << row);
+        *updated = true;
+        return true;
+    }
+
+    int start;
+    int end = 0;
+    while (findChangedSpan(mspScreen.screen[row], mspScreen.remote[row], &start, &end)) {
+        const uint32_t cost = end - start + MSP_SPAN_OVERHEAD;
+        if (*bytesFree < cost) {
+            return false;
+        }
+        sendSpan(displayPort, row, start, end);
+        *bytesFree -= cost;
+        *updated = true;
+    }
+    return true;
 }
 
 static int drawScreen(displayPort_t *displayPort)
 {
+    if (cliMode) {
+        return 0;
+    }
+
+    const timeMs_t currentTimeMs = millis();
+    if (currentTimeMs >= mspScreen.nextRowRefreshMs) {
+        mspScreen.staleRows |= 1 << mspScreen.refreshRow;
+        mspScreen.refreshRow = (mspScreen.refreshRow + 1) % MSP_DISPLAYPORT_ROWS;
+        mspScreen.nextRowRefreshMs = currentTimeMs + MSP_ROW_REFRESH_MS;
+    }
+
+    if (mspScreen.screenCleared && !mspScreen.clearRemote) {
+        mspScreen.clearRemote = updateCost(blankRow) + MSP_SUBCMD_COST < updateCost(NULL);
+    }
+    mspScreen.screenCleared = false;
+
+    // Don't fill the TX buffer, MSP replies and telemetry share the port.
+    // Whatever doesn't fit is sent on the next call.
+    uint32_t bytesFree = mspSerialTxBytesFree();
+    if (bytesFree < MSP_SUBCMD_COST * 2) {
+        return 0;
+    }
+    bytesFree -= MSP_SUBCMD_COST;
+
+    bool updated = false;
+    if (mspScreen.clearRemote) {
+        uint8_t subcmd[] = { 2 };
+        output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
+        bytesFree -= MSP_SUBCMD_COST;
+        memset(mspScreen.remote, ' ', sizeof(mspScreen.remote));
+        mspScreen.clearRemote = false;
+        mspScreen.staleRows = 0;
+        updated = true;
+    }
+
+    for (int row = 0; row < MSP_DISPLAYPORT_ROWS; row++) {
+        if (!sendRow(displayPort, row, &bytesFree, &updated)) {
+            break;
+        }
+    }
+
+    if (!updated) {
+        return 0;
+    }
     uint8_t subcmd[] = { 4 };
     return output(displayPort, MSP_DISPLAYPORT, subcmd, sizeof(subcmd));
 }
@@ -95,22 +277,16 @@ static int screenSize(const displayPort_t *displayPort)
 
 static int writeString(displayPort_t *displayPort, uint8_t col, uint8_t row, const char *string, textAttributes_t attr)
 {
+    UNUSED(displayPort);
     UNUSED(attr);
-#define MSP_OSD_MAX_STRING_LENGTH 30 // FIXME move this
-    uint8_t buf[MSP_OSD_MAX_STRING_LENGTH + 4];
 
-    int len = strlen(string);
-    if (len >= MSP_OSD_MAX_STRING_LENGTH) {
-        len = MSP_OSD_MAX_STRING_LENGTH;
+    if (row >= MSP_DISPLAYPORT_ROWS) {
+        return -1;
     }
-
-    buf[0] = 3;
-    buf[1] = row;
-    buf[2] = col;
-    buf[3] = 0;
-    memcpy(&buf[4], string, len);
-
-    return output(displayPort, MSP_DISPLAYPORT, buf, len + 4);
+    for (; *string && col < MSP_DISPLAYPORT_COLS; col++) {
+        mspScreen.screen[row][col] = *string++;
+    }
+    return 0;
 }
 
 static int writeChar(displayPort_t *displayPort, uint8_t col, uint8_t row, uint16_t c, textAttributes_t attr)
@@ -119,7 +295,7 @@ static int writeChar(displayPort_t *displayPort, uint8_t col, uint8_t row, uint1
 
     buf[0] = c;
     buf[1] = 0;
-    return writeString(displayPort, col, row, buf, attr); //!!TODO - check if there is a direct MSP command to do this
+    return writeString(displayPort, col, row, buf, attr);
 }
 
 static bool isTransferInProgress(const displayPort_t *displayPort)
@@ -130,8 +306,13 @@ static bool isTransferInProgress(const displayPort_t *displayPort)
 
 static void resync(displayPort_t *displayPort)
 {
-    displayPort->rows = 13;
-    displayPort->cols = 30;
+    displayPort->rows = MSP_DISPLAYPORT_ROWS;
+    displayPort->cols = MSP_DISPLAYPORT_COLS;
+
+    // We don't know what the display shows, start over from a clear one
+    memset(mspScreen.remote, ' ', sizeof(mspScreen.remote));
+    mspScreen.clearRemote = true;
+    mspScreen.staleRows = 0;
 }
 
 static uint32_t txBytesFree(const displayPort_t *displayPort)
@@ -158,6 +339,8 @@ static const displayPortVTable_t mspDisplayPortVTable = {
 
 displayPort_t *displayPortMspInit(void)
 {
+    memset(blankRow, ' ', sizeof(blankRow));
+    memset(mspScreen.screen, ' ', sizeof(mspScreen.screen));
     displayInit(&mspDisplayPort, &mspDisplayPortVTable);
     resync(&mspDisplayPort);
     return &mspDisplayPort;
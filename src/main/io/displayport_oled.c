@@ -78,7 +78,7 @@ static int oledWriteChar(displayPort_t *displayPort, uint8_t x, uint8_t y, uint1
 static bool oledIsTransferInProgress(const displayPort_t *displayPort)
 {
     UNUSED(displayPort);
-    return false;
+    return i2c_OLED_is_dirty();
 }
 
 static int oledHeartbeat(displayPort_t *displayPort)
@@ -90,6 +90,7 @@ static int oledHeartbeat(displayPort_t *displayPort)
 static void oledResync(displayPort_t *displayPort)
 {
     UNUSED(displayPort);
+    i2c_OLED_invalidate();
 }
 
 static uint32_t oledTxBytesFree(const displayPort_t *displayPort)
@@ -34,6 +34,8 @@
 
 #if defined(USE_FLASHFS)
 
+#include "common/maths.h"
+
 #include "drivers/flash.h"
 
 #include "io/flashfs.h"
@@ -192,6 +194,24 @@ static uint32_t flashfsWriteBuffers(uint8_t const **buffers, uint32_t *bufferSiz
             bytesTotalThisIteration = bytesTotalRemaining;
         }
 
+        if (!sync) {
+            /*
+             * Only program the first buffer, the flash would have to finish that before the next program could start.
+             * And only as much of it as can be sent before the next read of a more important device sharing the bus,
+             * the rest is written by the following calls.
+             */
+            i = 0;
+            while (bufferSizes[i] == 0) {
+                i++;
+            }
+
+            const uint32_t bytesAllowed = MIN(bufferSizes[i], (uint32_t)flashGetProgramBudget());
+            if (bytesAllowed == 0) {
+                break;
+            }
+            bytesTotalThisIteration = MIN(bytesTotalThisIteration, bytesAllowed);
+        }
+
         // Are we at EOF already? Abort.
         if (flashfsIsEOF()) {
             // May as well throw away any buffered data
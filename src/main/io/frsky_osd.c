@@ -6,6 +6,8 @@
 
 #if defined(USE_OSD) && defined(USE_FRSKYOSD)
 
+#include "build/debug.h"
+
 #include "common/crc.h"
 #include "common/log.h"
 #include "common/maths.h"
@@ -40,6 +42,9 @@
 
 #define FRSKY_OSD_CMD_RESPONSE_ERROR 0
 
+// Drawing state we haven't sent or can't know, e.g. after a context pop
+#define FRSKY_OSD_DRAWING_STATE_UNKNOWN 0xFF
+
 #define FRSKY_OSD_INFO_INTERVAL_MS 100
 #define FRSKY_OSD_INFO_READY_INTERVAL_MS 5000
 
@@ -237,7 +242,27 @@ typedef struct frskyOSDState_s {
     struct {
         uint8_t data[FRSKY_OSD_SEND_BUFFER_SIZE];
         uint8_t pos;
+        int16_t lastCmdPos;     // Start of the last command, -1 if it was already sent
     } sendBuffer;
+    struct {
+        // Last values sent to the OSD, to drop redundant changes
+        uint8_t strokeColor;
+        uint8_t fillColor;
+        uint8_t strokeWidth;
+        uint8_t outlineType;
+        uint8_t outlineColor;
+        uint8_t colorInversion;
+        // Pen position, only valid right after a move or a line
+        bool penValid;
+        int16_t penX;
+        int16_t penY;
+        // Start of the line stroked by the last command, if it was one
+        bool lineValid;
+        int16_t lineX;
+        int16_t lineY;
+    } drawing;
+    frskyOSDTransactionStats_t stats;
+    frskyOSDTransactionStats_t lastStats;
     struct {
         uint8_t state;
         uint8_t crc;
@@ -297,6 +322,31 @@ static void frskyOSDResetReceiveBuffer(void)
 static void frskyOSDResetSendBuffer(void)
 {
     state.sendBuffer.pos = 0;
+    state.sendBuffer.lastCmdPos = -1;
+}
+
+static void frskyOSDInvalidateDrawingState(void)
+{
+    state.drawing.strokeColor = FRSKY_OSD_DRAWING_STATE_UNKNOWN;
+    state.drawing.fillColor = FRSKY_OSD_DRAWING_STATE_UNKNOWN;
+    state.drawing.strokeWidth = FRSKY_OSD_DRAWING_STATE_UNKNOWN;
+    state.drawing.outlineType = FRSKY_OSD_DRAWING_STATE_UNKNOWN;
+    state.drawing.outlineColor = FRSKY_OSD_DRAWING_STATE_UNKNOWN;
+    state.drawing.colorInversion = FRSKY_OSD_DRAWING_STATE_UNKNOWN;
+    state.drawing.penValid = false;
+    state.drawing.lineValid = false;
+}
+
+// Returns true if the value was already sent. Otherwise it's recorded
+// and the caller has to send it.
+static bool frskyOSDDrawingStateIsCurrent(uint8_t *current, uint8_t value)
+{
+    if (*current == value) {
+        state.stats.elided++;
+        return true;
+    }
+    *current = value;
+    return false;
 }
 
 static void frskyOSDProcessCommandU8(uint8_t *crc, uint8_t c)
@@ -304,6 +354,7 @@ static void frskyOSDProcessCommandU8(uint8_t *crc, uint8_t c)
     while (serialTxBytesFree(state.port) == 0) {
     };
     serialWrite(state.port, c);
+    state.stats.bytes++;
     if (crc) {
         *crc = crc8_dvb_s2(*crc, c);
     }
@@ -317,7 +368,11 @@ static void frskyOSDSendCommand(uint8_t cmd, const void *payload, size_t size)
     if (rem < required) {
         frskyOSDFlushSendBuffer();
     }
+    state.sendBuffer.lastCmdPos = state.sendBuffer.pos;
     state.sendBuffer.data[state.sendBuffer.pos++] = cmd;
+    state.drawing.penValid = false;
+    state.drawing.lineValid = false;
+    state.stats.commands++;
     const uint8_t *ptr = payload;
     for (size_t ii = 0; ii < size; ii++, ptr++) {
         state.sendBuffer.data[state.sendBuffer.pos++] = *ptr;
@@ -328,6 +383,7 @@ static void frskyOSDStateReset(serialPort_t *port, baudRate_e baudrate)
 {
     frskyOSDResetReceiveBuffer();
     frskyOSDResetSendBuffer();
+    frskyOSDInvalidateDrawingState();
     state.info.grid.rows = 0;
     state.info.grid.columns = 0;
     state.info.viewport.width = 0;
@@ -676,6 +732,9 @@ void frskyOSDUpdate(void)
 
 void frskyOSDBeginTransaction(frskyOSDTransactionOptions_e opts)
 {
+    // Don't rely on state from previous frames, the OSD might have
+    // been reset in between
+    frskyOSDInvalidateDrawingState();
     if (opts & FRSKY_OSD_TRANSACTION_OPT_PROFILED) {
         frskyOSDPoint_t p = { .x = 0, .y = 10};
         frskyOSDSendAsyncCommand(OSD_CMD_TRANSACTION_BEGIN_PROFILED, &p, sizeof(p));
@@ -698,12 +757,25 @@ void frskyOSDCommitTransaction(void)
         if (state.sendBuffer.data[0] == OSD_CMD_TRANSACTION_BEGIN ||
             state.sendBuffer.data[0] == OSD_CMD_TRANSACTION_BEGIN_RESET_DRAWING) {
 
-            state.sendBuffer.pos = 0;
+            frskyOSDResetSendBuffer();
+            state.stats.commands--;
             return;
         }
     }
     frskyOSDSendAsyncCommand(OSD_CMD_TRANSACTION_COMMIT, NULL, 0);
     frskyOSDFlushSendBuffer();
+
+    state.lastStats = state.stats;
+    memset(&state.stats, 0, sizeof(state.stats));
+    DEBUG_SET(DEBUG_FRSKY_OSD, 0, state.lastStats.bytes);
+    DEBUG_SET(DEBUG_FRSKY_OSD, 1, state.lastStats.frames);
+    DEBUG_SET(DEBUG_FRSKY_OSD, 2, state.lastStats.commands);
+    DEBUG_SET(DEBUG_FRSKY_OSD, 3, state.lastStats.elided);
+}
+
+void frskyOSDGetTransactionStats(frskyOSDTransactionStats_t *stats)
+{
+    *stats = state.lastStats;
 }
 
 void frskyOSDFlushSendBuffer(void)
@@ -722,7 +794,8 @@ void frskyOSDFlushSendBuffer(void)
             frskyOSDProcessCommandU8(&crc, state.sendBuffer.data[ii]);
         }
         frskyOSDProcessCommandU8(NULL, crc);
-        state.sendBuffer.pos = 0;
+        frskyOSDResetSendBuffer();
+        state.stats.frames++;
     }
 }
 
@@ -940,24 +1013,43 @@ void frskyOSDClearScreen(void)
 void frskyOSDSetStrokeColor(frskyOSDColor_e color)
 {
     uint8_t c = color;
+    if (frskyOSDDrawingStateIsCurrent(&state.drawing.strokeColor, c)) {
+        return;
+    }
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_STROKE_COLOR, &c, sizeof(c));
 }
 
 void frskyOSDSetFillColor(frskyOSDColor_e color)
 {
     uint8_t c = color;
+    if (frskyOSDDrawingStateIsCurrent(&state.drawing.fillColor, c)) {
+        return;
+    }
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_FILL_COLOR, &c, sizeof(c));
 }
 
 void frskyOSDSetStrokeAndFillColor(frskyOSDColor_e color)
 {
     uint8_t c = color;
+    if (state.drawing.strokeColor == c) {
+        frskyOSDSetFillColor(color);
+        return;
+    }
+    if (state.drawing.fillColor == c) {
+        frskyOSDSetStrokeColor(color);
+        return;
+    }
+    state.drawing.strokeColor = c;
+    state.drawing.fillColor = c;
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_STROKE_AND_FILL_COLOR, &c, sizeof(c));
 }
 
 void frskyOSDSetColorInversion(bool inverted)
 {
     uint8_t c = inverted ? 1 : 0;
+    if (frskyOSDDrawingStateIsCurrent(&state.drawing.colorInversion, c)) {
+        return;
+    }
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_COLOR_INVERSION, &c, sizeof(c));
 }
 
@@ -982,18 +1074,27 @@ void frskyOSDSetPixelToFillColor(int x, int y)
 void frskyOSDSetStrokeWidth(unsigned width)
 {
     uint8_t w = width;
+    if (frskyOSDDrawingStateIsCurrent(&state.drawing.strokeWidth, w)) {
+        return;
+    }
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_STROKE_WIDTH, &w, sizeof(w));
 }
 
 void frskyOSDSetLineOutlineType(frskyOSDLineOutlineType_e outlineType)
 {
     uint8_t type = outlineType;
+    if (frskyOSDDrawingStateIsCurrent(&state.drawing.outlineType, type)) {
+        return;
+    }
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_LINE_OUTLINE_TYPE, &type, sizeof(type));
 }
 
 void frskyOSDSetLineOutlineColor(frskyOSDColor_e outlineColor)
 {
     uint8_t color = outlineColor;
+    if (frskyOSDDrawingStateIsCurrent(&state.drawing.outlineColor, color)) {
+        return;
+    }
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_SET_LINE_OUTLINE_COLOR, &color, sizeof(color));
 }
 
@@ -1012,6 +1113,7 @@ void frskyOSDClearRect(int x, int y, int w, int h)
 void frskyOSDResetDrawingState(void)
 {
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_RESET, NULL, 0);
+    frskyOSDInvalidateDrawingState();
 }
 
 void frskyOSDDrawCharacter(int x, int y, uint16_t chr, uint8_t opts)
@@ -1047,16 +1149,77 @@ void frskyOSDDrawStringMask(int x, int y, const char *s, frskyOSDColor_e color,
     frskyOSDSendAsyncBlobWithExplicitSizeCommand(OSD_CMD_DRAWING_DRAW_STRING_MASK, &cmd, sizeof(cmd), s, strlen(s) + 1);
 }
 
+// Returns the last command in the send buffer if it's cmd and
+// can still be modified, NULL otherwise
+static uint8_t *frskyOSDLastCommandPayload(uint8_t cmd)
+{
+    if (state.sendBuffer.lastCmdPos < 0 || state.sendBuffer.data[state.sendBuffer.lastCmdPos] != cmd) {
+        return NULL;
+    }
+    return &state.sendBuffer.data[state.sendBuffer.lastCmdPos + 1];
+}
+
+static void frskyOSDSetPen(int x, int y)
+{
+    state.drawing.penValid = true;
+    state.drawing.penX = x;
+    state.drawing.penY = y;
+}
+
 void frskyOSDMoveToPoint(int x, int y)
 {
     frskyOSDPoint_t p = { .x = x, .y = y};
-    frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_MOVE_TO_POINT, &p, sizeof(p));
+
+    if (state.drawing.penValid && state.drawing.penX == x && state.drawing.penY == y) {
+        // Already there
+        state.stats.elided++;
+        return;
+    }
+
+    uint8_t *lastMove = frskyOSDLastCommandPayload(OSD_CMD_DRAWING_MOVE_TO_POINT);
+    if (lastMove) {
+        // Moving twice in a row, only the last one matters
+        memcpy(lastMove, &p, sizeof(p));
+        state.stats.elided++;
+    } else {
+        frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_MOVE_TO_POINT, &p, sizeof(p));
+    }
+    frskyOSDSetPen(x, y);
 }
 
 void frskyOSDStrokeLineToPoint(int x, int y)
 {
     frskyOSDPoint_t p = { .x = x, .y = y};
+
+    const bool lineValid = state.drawing.lineValid;
+    const bool penValid = state.drawing.penValid;
+    const int penX = state.drawing.penX;
+    const int penY = state.drawing.penY;
+
+    uint8_t *lastLine = frskyOSDLastCommandPayload(OSD_CMD_DRAWING_STROKE_LINE_TO_POINT);
+    if (lastLine && lineValid) {
+        // Merge with the previous line if this one continues it in the
+        // same direction, the OSD then only strokes a single line.
+        const int dx1 = penX - state.drawing.lineX;
+        const int dy1 = penY - state.drawing.lineY;
+        const int dx2 = x - penX;
+        const int dy2 = y - penY;
+        if (dx1 * dy2 == dy1 * dx2 && dx1 * dx2 + dy1 * dy2 > 0) {
+            memcpy(lastLine, &p, sizeof(p));
+            state.stats.elided++;
+            frskyOSDSetPen(x, y);
+            state.drawing.lineValid = true;
+            return;
+        }
+    }
+
     frskyOSDSendAsyncCommand(OSD_CMD_DRAWING_STROKE_LINE_TO_POINT, &p, sizeof(p));
+    frskyOSDSetPen(x, y);
+    if (penValid) {
+        state.drawing.lineValid = true;
+        state.drawing.lineX = penX;
+        state.drawing.lineY = penY;
+    }
 }
 
 void frskyOSDStrokeTriangle(int x1, int y1, int x2, int y2, int x3, int y3)
@@ -1159,6 +1322,8 @@ void frskyOSDContextPush(void)
 void frskyOSDContextPop(void)
 {
     frskyOSDSendAsyncCommand(OSD_CMD_CONTEXT_POP, NULL, 0);
+    // The OSD restores the state from the push, which we don't track
+    frskyOSDInvalidateDrawingState();
 }
 
 bool frskyOSDSupportsWidgets(void)
@@ -53,6 +53,14 @@ typedef enum
     FRSKY_OSD_WIDGET_ID_CHARGAUGE_LAST = FRSKY_OSD_WIDGET_ID_CHARGAUGE_3,
 } frskyOSDWidgetID_e;
 
+// Traffic of the last committed transaction, for tuning the drawing code
+typedef struct frskyOSDTransactionStats_s {
+    uint16_t bytes;         // Bytes sent, including the framing
+    uint16_t frames;
+    uint16_t commands;
+    uint16_t elided;        // Commands dropped or merged into the previous one
+} frskyOSDTransactionStats_t;
+
 typedef struct frskyOSDPoint_s {
     int x : 12;
     int y : 12;
@@ -103,6 +111,7 @@ void frskyOSDUpdate(void);
 void frskyOSDBeginTransaction(frskyOSDTransactionOptions_e opts);
 void frskyOSDCommitTransaction(void);
 void frskyOSDFlushSendBuffer(void);
+void frskyOSDGetTransactionStats(frskyOSDTransactionStats_t *stats);
 bool frskyOSDReadFontCharacter(unsigned char_address, osdCharacter_t *chr);
 bool frskyOSDWriteFontCharacter(unsigned char_address, const osdCharacter_t *chr);
 
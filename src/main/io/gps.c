@@ -64,6 +64,7 @@ typedef struct {
     bool                isDriverBased;
     portMode_t          portMode;           // Port mode RX/TX (only for serial based)
     bool                hasCompass;         // Has a compass (NAZA)
+    uint16_t            fixDelayMs;         // Typical age of a solution when it arrives (ms)
     void                (*restart)(void);   // Restart protocol driver thread
     void                (*protocol)(void);  // Process protocol driver thread
 } gpsProviderDescriptor_t;
@@ -79,51 +80,51 @@ baudRate_e gpsToSerialBaudRate[GPS_BAUDRATE_COUNT] = { BAUD_115200, BAUD_57600,
 static gpsProviderDescriptor_t  gpsProviders[GPS_PROVIDER_COUNT] = {
     /* NMEA GPS */
 #ifdef USE_GPS_PROTO_NMEA
-    { false, MODE_RX, false, &gpsRestartNMEA_MTK, &gpsHandleNMEA },
+    { false, MODE_RX, false, 200, &gpsRestartNMEA_MTK, &gpsHandleNMEA },
 #else
-    { false, 0, false,  NULL, NULL },
+    { false, 0, false, 0, NULL, NULL },
 #endif
 
     /* UBLOX binary */
 #ifdef USE_GPS_PROTO_UBLOX
-    { false, MODE_RXTX, false, &gpsRestartUBLOX, &gpsHandleUBLOX },
+    { false, MODE_RXTX, false, 150, &gpsRestartUBLOX, &gpsHandleUBLOX },
 #else
-    { false, 0, false,  NULL, NULL },
+    { false, 0, false, 0, NULL, NULL },
 #endif
 
     /* Stub */
-    { false, 0, false,  NULL, NULL },
+    { false, 0, false, 0, NULL, NULL },
 
     /* NAZA GPS module */
 #ifdef USE_GPS_PROTO_NAZA
-    { false, MODE_RX, true, &gpsRestartNAZA, &gpsHandleNAZA },
+    { false, MODE_RX, true, 200, &gpsRestartNAZA, &gpsHandleNAZA },
 #else
-    { false, 0, false,  NULL, NULL },
+    { false, 0, false, 0, NULL, NULL },
 #endif
 
     /* UBLOX7PLUS binary */
 #ifdef USE_GPS_PROTO_UBLOX
-    { false, MODE_RXTX, false, &gpsRestartUBLOX, &gpsHandleUBLOX },
+    { false, MODE_RXTX, false, 100, &gpsRestartUBLOX, &gpsHandleUBLOX },
 #else
-    { false, 0, false,  NULL, NULL },
+    { false, 0, false, 0, NULL, NULL },
 #endif
 
     /* MTK GPS */
 #ifdef USE_GPS_PROTO_MTK
-    { false, MODE_RXTX, false, &gpsRestartNMEA_MTK, &gpsHandleMTK },
+    { false, MODE_RXTX, false, 200, &gpsRestartNMEA_MTK, &gpsHandleMTK },
 #else
-    { false, 0, false,  NULL, NULL },
+    { false, 0, false, 0, NULL, NULL },
 #endif
 
     /* MSP GPS */
 #ifdef USE_GPS_PROTO_MSP
-    { true, 0, false, &gpsRestartMSP, &gpsHandleMSP },
+    { true, 0, false, 100, &gpsRestartMSP, &gpsHandleMSP },
 #else
-    { false, 0, false,  NULL, NULL },
+    { false, 0, false, 0, NULL, NULL },
 #endif
 };
 
-PG_REGISTER_WITH_RESET_TEMPLATE(gpsConfig_t, gpsConfig, PG_GPS_CONFIG, 0);
+PG_REGISTER_WITH_RESET_TEMPLATE(gpsConfig_t, gpsConfig, PG_GPS_CONFIG, 1);
 
 PG_RESET_TEMPLATE(gpsConfig_t, gpsConfig,
     .provider = SETTING_GPS_PROVIDER_DEFAULT,
@@ -132,7 +133,8 @@ PG_RESET_TEMPLATE(gpsConfig_t, gpsConfig,
     .autoBaud = SETTING_GPS_AUTO_BAUD_DEFAULT,
     .dynModel = SETTING_GPS_DYN_MODEL_DEFAULT,
     .gpsMinSats = SETTING_GPS_MIN_SATS_DEFAULT,
-    .ubloxUseGalileo = SETTING_GPS_UBLOX_USE_GALILEO_DEFAULT
+    .ubloxUseGalileo = SETTING_GPS_UBLOX_USE_GALILEO_DEFAULT,
+    .fixDelayMs = SETTING_GPS_DELAY_MS_DEFAULT
 );
 
 void gpsSetState(gpsState_e state)
@@ -485,6 +487,19 @@ bool isGPSHealthy(void)
     return true;
 }
 
+/*
+ * Age of a GPS solution when it reaches the position estimator. Receivers output
+ * the fix well after the measurement epoch, the typical delay depends on the protocol.
+ */
+uint16_t gpsGetFixDelayMs(void)
+{
+    if (gpsConfig()->fixDelayMs >= 0) {
+        return gpsConfig()->fixDelayMs;
+    }
+
+    return gpsProviders[gpsConfig()->provider].fixDelayMs;
+}
+
 bool isGPSHeadingValid(void)
 {
     return sensors(SENSOR_GPS) && STATE(GPS_FIX) && gpsSol.numSat >= 6 && gpsSol.groundSpeed >= 300;
@@ -183,6 +183,19 @@ typedef struct osdMapData_s {
 
 static osdMapData_t osdMapData;
 
+#define OSD_ELEMENT_FULL_REFRESH_MS 1000    // Redraw unchanged elements at least this often
+
+// Per element record of what was last drawn, used to skip unchanged elements
+typedef struct osdElementState_s {
+    uint32_t inputs;        // Digest of the values the element was drawn from
+    uint8_t generation;     // osdElementGeneration when it was drawn
+    bool blinking;          // Drawn with software emulated blink
+    bool blinkPhase;        // Blink phase it was drawn in
+} osdElementState_t;
+
+static osdElementState_t osdElementStates[OSD_ITEM_COUNT];
+static uint8_t osdElementGeneration = 1;
+
 static displayPort_t *osdDisplayPort;
 static bool osdDisplayIsReady = false;
 #if defined(USE_CANVAS)
@@ -1064,17 +1077,33 @@ int osdGetHeadingAngle(int angle)
 
 #if defined(USE_GPS)
 
+// What a map element drew last time, to erase it when the POI moves
+typedef struct osdMapState_s {
+    uint32_t scale;         // Scale of the last drawing in m per row, 0 if none
+    uint16_t drawn;         // Position of the POI drawn, 0 if none
+    uint8_t clearCount;     // osdDisplayPort->clearCount at the last drawing
+} osdMapState_t;
+
+// Divides rounding to the nearest integer, also for negative values
+static int osdMapDivRound(int32_t value, uint32_t scale)
+{
+    if (value >= 0) {
+        return (value + (int32_t)(scale / 2)) / (int32_t)scale;
+    }
+    return -((-value + (int32_t)(scale / 2)) / (int32_t)scale);
+}
+
 /* Draws a map with the given symbol in the center and given point of interest
  * defined by its distance in meters and direction in degrees.
  * referenceHeading indicates the up direction in the map, in degrees, while
  * referenceSym (if non-zero) is drawn at the upper right corner below a small
- * arrow to indicate the map reference to the user. The drawn argument is an
- * in-out used to store the last position where the craft was drawn to avoid
- * erasing all screen on each redraw.
+ * arrow to indicate the map reference to the user. The state argument keeps
+ * what was drawn last time, the previous POI is only erased when it moves to
+ * another cell.
  */
 static void osdDrawMap(int referenceHeading, uint8_t referenceSym, uint8_t centerSym,
                        uint32_t poiDistance, int16_t poiDirection, uint8_t poiSymbol,
-                       uint16_t *drawn, uint32_t *usedScale)
+                       osdMapState_t *state)
 {
     // TODO: These need to be tested with several setups. We might
     // need to make them configurable.
@@ -1092,13 +1121,10 @@ static void osdDrawMap(int referenceHeading, uint8_t referenceSym, uint8_t cente
     uint8_t midX = osdDisplayPort->cols / 2;
     uint8_t midY = osdDisplayPort->rows / 2;
 
-    // Fixed marks
-    displayWriteChar(osdDisplayPort, midX, midY, centerSym);
-
-    // First, erase the previous drawing.
-    if (OSD_VISIBLE(*drawn)) {
-        displayWriteChar(osdDisplayPort, OSD_X(*drawn), OSD_Y(*drawn), SYM_BLANK);
-        *drawn = 0;
+    if (state->clearCount != osdDisplayPort->clearCount) {
+        // Screen was cleared, our previous drawing is gone
+        state->clearCount = osdDisplayPort->clearCount;
+        state->drawn = 0;
     }
 
     uint32_t initialScale;
@@ -1123,35 +1149,48 @@ static void osdDrawMap(int referenceHeading, uint8_t referenceSym, uint8_t cente
 
     // Try to keep the same scale when getting closer until we draw over the center point
     uint32_t scale = initialScale;
-    if (*usedScale) {
-        scale = *usedScale;
-        if (scale > initialScale && poiDistance < *usedScale * scaleReductionMultiplier) {
+    if (state->scale) {
+        scale = state->scale;
+        if (scale > initialScale && poiDistance < state->scale * scaleReductionMultiplier) {
             scale /= scaleMultiplier;
         }
     }
 
+    uint16_t drawn = 0;
+    uint16_t drawnSymbol = 0;
+
     if (STATE(GPS_FIX)) {
 
+        // Skip the scales where the POI is further away than the map
+        // corners, it can't be inside the map in any direction.
+        // Compares squared distances in pixels, multiplied by the scale.
+        const uint32_t cornerX = MAX(midX - minX, maxX - midX) * charWidth;
+        const uint32_t cornerY = MAX(midY - minY, maxY - midY) * charHeight;
+        const uint64_t cornerSq = (uint64_t)cornerX * cornerX + (uint64_t)cornerY * cornerY;
+        const uint64_t poiPixels = (uint64_t)poiDistance * charHeight;
+        int ii;
+        for (ii = 0; ii < 50 && poiPixels * poiPixels > cornerSq * scale * scale; ii++) {
+            scale *= scaleMultiplier;
+        }
+
+        // POI position relative to the center, in cells multiplied by
+        // the scale. Only the scale changes while searching, so the
+        // trigonometry is done once.
         int directionToPoi = osdGetHeadingAngle(poiDirection - referenceHeading);
         float poiAngle = DEGREES_TO_RADIANS(directionToPoi);
-        float poiSin = sin_approx(poiAngle);
-        float poiCos = cos_approx(poiAngle);
+        const int32_t poiOffsetX = lrintf(poiDistance * sin_approx(poiAngle) * charHeight / charWidth);
+        const int32_t poiOffsetY = lrintf(poiDistance * cos_approx(poiAngle));
 
         // Now start looking for a valid scale that lets us draw everything
-        int ii;
-        for (ii = 0; ii < 50; ii++) {
+        for (; ii < 50; ii++) {
             // Calculate location of the aircraft in map
-            int points = poiDistance / ((float)scale / charHeight);
-
-            float pointsX = points * poiSin;
-            int poiX = midX - roundf(pointsX / charWidth);
+            int poiX = midX - osdMapDivRound(poiOffsetX, scale);
             if (poiX < minX || poiX > maxX) {
                 scale *= scaleMultiplier;
                 continue;
             }
 
-            float pointsY = points * poiCos;
-            int poiY = midY + roundf(pointsY / charHeight);
+            int poiY = midY + osdMapDivRound(poiOffsetY, scale);
             if (poiY < minY || poiY > maxY) {
                 scale *= scaleMultiplier;
                 continue;
@@ -1164,12 +1203,13 @@ static void osdDrawMap(int referenceHeading, uint8_t referenceSym, uint8_t cente
                 if (centerSym != SYM_BLANK && OSD_ALTERNATING_CHOICES(1000, 2) == 0) {
                     break;
                 }
-            } else {
+            } else if (state->drawn != (OSD_POS(poiX, poiY) | OSD_VISIBLE_FLAG)) {
 
                 uint16_t c;
                 if (displayReadCharWithAttr(osdDisplayPort, poiX, poiY, &c, NULL) && c != SYM_BLANK) {
                     // Something else written here, increase scale. If the display doesn't support reading
-                    // back characters, we assume there's nothing.
+                    // back characters, we assume there's nothing. The cell we drew at last time
+                    // holds our own symbol, so it's not checked.
                     //
                     // If we're close to the center, decrease scale. Otherwise increase it.
                     uint8_t centerDeltaX = (maxX - minX) / (scaleMultiplier * 2);
@@ -1186,21 +1226,36 @@ static void osdDrawMap(int referenceHeading, uint8_t referenceSym, uint8_t cente
                 }
             }
 
-            // Draw the point on the map
             if (poiSymbol == SYM_ARROW_UP) {
                 // Drawing aircraft, rotate
                 int mapHeading = osdGetHeadingAngle(DECIDEGREES_TO_DEGREES(osdGetHeading()) - referenceHeading);
                 poiSymbol += mapHeading * 2 / 45;
             }
-            displayWriteChar(osdDisplayPort, poiX, poiY, poiSymbol);
-
-            // Update saved location
-            *drawn = OSD_POS(poiX, poiY) | OSD_VISIBLE_FLAG;
+            drawn = OSD_POS(poiX, poiY) | OSD_VISIBLE_FLAG;
+            drawnSymbol = poiSymbol;
             break;
         }
     }
 
-    *usedScale = scale;
+    // Fixed marks, unless the POI is drawn over it
+    const uint16_t center = OSD_POS(midX, midY) | OSD_VISIBLE_FLAG;
+    if (drawn != center) {
+        displayWriteChar(osdDisplayPort, midX, midY, centerSym);
+    }
+
+    // Erase the previous drawing if the POI moved to another cell
+    if (OSD_VISIBLE(state->drawn) && state->drawn != drawn && state->drawn != center) {
+        displayWriteChar(osdDisplayPort, OSD_X(state->drawn), OSD_Y(state->drawn), SYM_BLANK);
+    }
+
+    // Draw the point on the map on every call, another element might have drawn
+    // over it. The display drivers drop writes which don't change the screen.
+    if (OSD_VISIBLE(drawn)) {
+        displayWriteChar(osdDisplayPort, OSD_X(drawn), OSD_Y(drawn), drawnSymbol);
+    }
+    state->drawn = drawn;
+
+    state->scale = scale;
 
     // Update global map data for scale and reference
     osdMapData.scale = scale;
@@ -1210,19 +1265,19 @@ static void osdDrawMap(int referenceHeading, uint8_t referenceSym, uint8_t cente
 /* Draws a map with the home in the center and the craft moving around.
  * See osdDrawMap() for reference.
  */
-static void osdDrawHomeMap(int referenceHeading, uint8_t referenceSym, uint16_t *drawn, uint32_t *usedScale)
+static void osdDrawHomeMap(int referenceHeading, uint8_t referenceSym, osdMapState_t *state)
 {
-    osdDrawMap(referenceHeading, referenceSym, SYM_HOME, GPS_distanceToHome, GPS_directionToHome, SYM_ARROW_UP, drawn, usedScale);
+    osdDrawMap(referenceHeading, referenceSym, SYM_HOME, GPS_distanceToHome, GPS_directionToHome, SYM_ARROW_UP, state);
 }
 
 /* Draws a map with the aircraft in the center and the home moving around.
  * See osdDrawMap() for reference.
  */
-static void osdDrawRadar(uint16_t *drawn, uint32_t *usedScale)
+static void osdDrawRadar(osdMapState_t *state)
 {
     int16_t reference = DECIDEGREES_TO_DEGREES(osdGetHeading());
     int16_t poiDirection = osdGetHeadingAngle(GPS_directionToHome + 180);
-    osdDrawMap(reference, 0, SYM_ARROW_UP, GPS_distanceToHome, poiDirection, SYM_HOME, drawn, usedScale);
+    osdDrawMap(reference, 0, SYM_ARROW_UP, GPS_distanceToHome, poiDirection, SYM_HOME, state);
 }
 
 static uint16_t crc_accumulate(uint8_t data, uint16_t crcAccum)
@@ -1431,6 +1486,27 @@ int8_t getGeoWaypointNumber(int8_t waypointIndex)
     return geoWaypointIndex + 1;
 }
 
+static void osdGetHorizonAngles(float *rollAngle, float *pitchAngle)
+{
+#ifdef USE_SECONDARY_IMU
+    if (secondaryImuState.active && secondaryImuConfig()->useForOsdAHI) {
+        *rollAngle = DECIDEGREES_TO_RADIANS(secondaryImuState.eulerAngles.values.roll);
+        *pitchAngle = DECIDEGREES_TO_RADIANS(secondaryImuState.eulerAngles.values.pitch);
+    } else {
+        *rollAngle = DECIDEGREES_TO_RADIANS(attitude.values.roll);
+        *pitchAngle = DECIDEGREES_TO_RADIANS(attitude.values.pitch);
+    }
+#else
+    *rollAngle = DECIDEGREES_TO_RADIANS(attitude.values.roll);
+    *pitchAngle = DECIDEGREES_TO_RADIANS(attitude.values.pitch);
+#endif
+    *pitchAngle -= osdConfig()->ahi_camera_uptilt_comp ? DEGREES_TO_RADIANS(osdConfig()->camera_uptilt) : 0;
+    *pitchAngle += DEGREES_TO_RADIANS(getFixedWingLevelTrim());
+    if (osdConfig()->ahi_reverse_roll) {
+        *rollAngle = -*rollAngle;
+    }
+}
+
 static bool osdDrawSingleElement(uint8_t item)
 {
     uint16_t pos = osdLayoutsConfig()->item_pos[currentLayout][item];
@@ -1704,23 +1780,20 @@ static bool osdDrawSingleElement(uint8_t item)
 
     case OSD_MAP_NORTH:
         {
-            static uint16_t drawn = 0;
-            static uint32_t scale = 0;
-            osdDrawHomeMap(0, 'N', &drawn, &scale);
+            static osdMapState_t state;
+            osdDrawHomeMap(0, 'N', &state);
             return true;
         }
     case OSD_MAP_TAKEOFF:
         {
-            static uint16_t drawn = 0;
-            static uint32_t scale = 0;
-            osdDrawHomeMap(CENTIDEGREES_TO_DEGREES(navigationGetHomeHeading()), 'T', &drawn, &scale);
+            static osdMapState_t state;
+            osdDrawHomeMap(CENTIDEGREES_TO_DEGREES(navigationGetHomeHeading()), 'T', &state);
             return true;
         }
     case OSD_RADAR:
         {
-            static uint16_t drawn = 0;
-            static uint32_t scale = 0;
-            osdDrawRadar(&drawn, &scale);
+            static osdMapState_t state;
+            osdDrawRadar(&state);
             return true;
         }
 #endif // GPS
@@ -2094,23 +2167,7 @@ static bool osdDrawSingleElement(uint8_t item)
             float rollAngle;
             float pitchAngle;
 
-#ifdef USE_SECONDARY_IMU
-            if (secondaryImuState.active && secondaryImuConfig()->useForOsdAHI) {
-                rollAngle = DECIDEGREES_TO_RADIANS(secondaryImuState.eulerAngles.values.roll);
-                pitchAngle = DECIDEGREES_TO_RADIANS(secondaryImuState.eulerAngles.values.pitch);
-            } else {
-                rollAngle = DECIDEGREES_TO_RADIANS(attitude.values.roll);
-                pitchAngle = DECIDEGREES_TO_RADIANS(attitude.values.pitch);
-            }
-#else
-            rollAngle = DECIDEGREES_TO_RADIANS(attitude.values.roll);
-            pitchAngle = DECIDEGREES_TO_RADIANS(attitude.values.pitch);
-#endif
-            pitchAngle -= osdConfig()->ahi_camera_uptilt_comp ? DEGREES_TO_RADIANS(osdConfig()->camera_uptilt) : 0;
-            pitchAngle += DEGREES_TO_RADIANS(getFixedWingLevelTrim());
-            if (osdConfig()->ahi_reverse_roll) {
-                rollAngle = -rollAngle;
-            }
+            osdGetHorizonAngles(&rollAngle, &pitchAngle);
             osdDrawArtificialHorizon(osdDisplayPort, osdGetDisplayPortCanvas(),
                  OSD_DRAW_POINT_GRID(elemPosX, elemPosY), rollAngle, pitchAngle);
             osdDrawSingleElement(OSD_HORIZON_SIDEBARS);
@@ -2930,17 +2987,237 @@ static uint8_t osdIncElementIndex(uint8_t elementIndex)
     return elementIndex;
 }
 
+static uint32_t osdHashValue(uint32_t hash, int32_t value)
+{
+    return (hash ^ (uint32_t)value) * 16777619;
+}
+
+static uint32_t osdHashFloat(uint32_t hash, float value)
+{
+    int32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return osdHashValue(hash, bits);
+}
+
+static uint32_t osdHashBatteryAlarms(uint32_t hash)
+{
+    textAttributes_t attr = TEXT_ATTRIBUTES_NONE;
+    osdUpdateBatteryCapacityOrVoltageTextAttributes(&attr);
+    hash = osdHashValue(hash, attr);
+    hash = osdHashValue(hash, calculateBatteryPercentage());
+    return osdHashValue(hash, (getBatteryState() != BATTERY_NOT_PRESENT) && (getBatteryVoltage() <= getBatteryWarningVoltage()));
+}
+
+/*
+ * Computes a digest of the values an element is drawn from, including the
+ * ones deciding whether it blinks. Returns false for elements without a
+ * cheap change check, those are redrawn on each pass.
+ */
+static bool osdGetElementInputs(uint8_t item, uint32_t *inputs)
+{
+    uint32_t hash = 2166136261;
+
+    switch (item) {
+    case OSD_RSSI_VALUE:
+        hash = osdHashValue(hash, osdConvertRSSI());
+        break;
+
+    case OSD_MAIN_BATT_VOLTAGE:
+        hash = osdHashValue(osdHashBatteryAlarms(hash), getBatteryRawVoltage());
+        break;
+
+    case OSD_SAG_COMPENSATED_MAIN_BATT_VOLTAGE:
+        hash = osdHashValue(osdHashBatteryAlarms(hash), getBatterySagCompensatedVoltage());
+        break;
+
+    case OSD_MAIN_BATT_CELL_VOLTAGE:
+        hash = osdHashValue(osdHashBatteryAlarms(hash), getBatteryRawAverageCellVoltage());
+        break;
+
+    case OSD_MAIN_BATT_SAG_COMPENSATED_CELL_VOLTAGE:
+        hash = osdHashValue(osdHashBatteryAlarms(hash), getBatterySagCompensatedAverageCellVoltage());
+        break;
+
+    case OSD_CURRENT_DRAW:
+        hash = osdHashValue(hash, getAmperage());
+        break;
+
+    case OSD_POWER:
+        hash = osdHashValue(osdHashValue(hash, getPower()), getAmperage());
+        break;
+
+    case OSD_MAH_DRAWN:
+        hash = osdHashValue(osdHashBatteryAlarms(hash), getMAhDrawn());
+        break;
+
+    case OSD_WH_DRAWN:
+        hash = osdHashValue(osdHashBatteryAlarms(hash), getMWhDrawn() / 10);
+        break;
+
+    case OSD_BATTERY_REMAINING_PERCENT:
+        hash = osdHashBatteryAlarms(hash);
+        break;
+
+#ifdef USE_GPS
+    case OSD_GPS_SATS:
+        hash = osdHashValue(hash, gpsSol.numSat);
+        hash = osdHashValue(hash, STATE(GPS_FIX));
+        hash = osdHashValue(hash, getHwGPSStatus());
+        break;
+
+    case OSD_GPS_SPEED:
+        hash = osdHashValue(hash, gpsSol.groundSpeed);
+        break;
+
+    case OSD_GPS_LAT:
+        hash = osdHashValue(hash, gpsSol.llh.lat);
+        break;
+
+    case OSD_GPS_LON:
+        hash = osdHashValue(hash, gpsSol.llh.lon);
+        break;
+
+    case OSD_GPS_HDOP:
+        hash = osdHashValue(hash, gpsSol.hdop);
+        break;
+
+    case OSD_HOME_DIST:
+        hash = osdHashValue(hash, GPS_distanceToHome);
+        break;
+
+    case OSD_TRIP_DIST:
+        hash = osdHashValue(hash, getTotalTravelDistance());
+        break;
+#endif
+
+    case OSD_HEADING:
+        hash = osdHashValue(hash, osdIsHeadingValid());
+        hash = osdHashValue(hash, DECIDEGREES_TO_DEGREES(osdGetHeading()));
+        break;
+
+    case OSD_ALTITUDE:
+        hash = osdHashValue(hash, osdGetAltitude());
+        break;
+
+    case OSD_ALTITUDE_MSL:
+        hash = osdHashValue(hash, osdGetAltitudeMsl());
+        break;
+
+#if defined(USE_BARO) || defined(USE_GPS)
+    case OSD_VARIO_NUM:
+        hash = osdHashValue(hash, getEstimatedActualVelocity(Z));
+        break;
+#endif
+
+    case OSD_ONTIME:
+        hash = osdHashValue(hash, micros() / 1000000);
+        break;
+
+    case OSD_FLYTIME:
+        hash = osdHashValue(osdHashValue(hash, getFlightTime()), ARMING_FLAG(ARMED));
+        break;
+
+    case OSD_ONTIME_FLYTIME:
+        hash = osdHashValue(hash, ARMING_FLAG(ARMED) ? getFlightTime() : micros() / 1000000);
+        hash = osdHashValue(hash, ARMING_FLAG(ARMED));
+        break;
+
+    case OSD_THROTTLE_POS:
+        hash = osdHashValue(hash, getThrottlePercent());
+#ifdef USE_POWER_LIMITS
+        hash = osdHashValue(hash, powerLimiterIsLimiting());
+#endif
+        break;
+
+    case OSD_ATTITUDE_ROLL:
+        hash = osdHashValue(hash, attitude.values.roll);
+        break;
+
+    case OSD_ATTITUDE_PITCH:
+        hash = osdHashValue(hash, attitude.values.pitch);
+        break;
+
+    case OSD_ARTIFICIAL_HORIZON:
+        {
+            float rollAngle;
+            float pitchAngle;
+
+            osdGetHorizonAngles(&rollAngle, &pitchAngle);
+            hash = osdHashFloat(osdHashFloat(hash, rollAngle), pitchAngle);
+            break;
+        }
+
+    case OSD_CRAFT_NAME:
+        // Only changes with the configuration, covered by the periodic refresh
+        break;
+
+    default:
+        return false;
+    }
+
+    *inputs = hash;
+    return true;
+}
+
+static void osdUpdateElementGeneration(void)
+{
+    static uint8_t lastClearCount;
+    static timeMs_t lastFullRefreshMs;
+    const timeMs_t currentTimeMs = millis();
+
+    // Redraw everything after the screen was cleared, and from time to time
+    // to restore elements partially overwritten by others
+    if (osdDisplayPort->clearCount != lastClearCount || currentTimeMs - lastFullRefreshMs >= OSD_ELEMENT_FULL_REFRESH_MS) {
+        lastClearCount = osdDisplayPort->clearCount;
+        lastFullRefreshMs = currentTimeMs;
+        // Zero matches never drawn elements, skip it
+        if (++osdElementGeneration == 0) {
+            osdElementGeneration = 1;
+        }
+    }
+}
+
+// Draws the element if any of its inputs changed since it was last drawn.
+// Returns true iff the element was drawn.
+static bool osdRefreshElement(uint8_t item)
+{
+    osdElementState_t *elementState = &osdElementStates[item];
+    uint32_t inputs = 0;
+    const bool hasInputs = osdGetElementInputs(item, &inputs);
+    const bool blinkPhase = displayEmulatedBlinkPhase();
+
+    if (hasInputs && elementState->generation == osdElementGeneration && elementState->inputs == inputs &&
+        !(elementState->blinking && elementState->blinkPhase != blinkPhase)) {
+        return false;
+    }
+
+    const uint8_t emulatedBlinkCount = osdDisplayPort->emulatedBlinkCount;
+    if (!osdDrawSingleElement(item)) {
+        return false;
+    }
+
+    elementState->inputs = inputs;
+    elementState->generation = osdElementGeneration;
+    elementState->blinking = osdDisplayPort->emulatedBlinkCount != emulatedBlinkCount;
+    elementState->blinkPhase = blinkPhase;
+    return true;
+}
+
 void osdDrawNextElement(void)
 {
     static uint8_t elementIndex = 0;
-    // Prevent infinite loop when no elements are enabled
+
+    osdUpdateElementGeneration();
+
+    // Draw the next element which changed. Prevent infinite loop when no
+    // elements are enabled or none of them changed.
     uint8_t index = elementIndex;
     do {
         elementIndex = osdIncElementIndex(elementIndex);
-    } while(!osdDrawSingleElement(elementIndex) && index != elementIndex);
+    } while(!osdRefreshElement(elementIndex) && index != elementIndex);
 
     // Draw artificial horizon + tracking telemtry last
-    osdDrawSingleElement(OSD_ARTIFICIAL_HORIZON);
+    osdRefreshElement(OSD_ARTIFICIAL_HORIZON);
     if (osdConfig()->telemetry>0){
       osdDisplayTelemetry();
     }
@@ -109,6 +109,27 @@ static float osdGetAspectRatioCorrection(void)
     return osdDisplayIsPAL() ? 12.0f/15.0f : 12.0f/18.46f;
 }
 
+// Fractional bits used to step along the horizon line
+#define OSD_AHI_FP_SHIFT    16
+#define OSD_AHI_FP_ONE      (1 << OSD_AHI_FP_SHIFT)
+
+static void osdGridAhiCellPosition(uint8_t *x, uint8_t *y, uint8_t elemPosX, uint8_t elemPosY, int8_t orient, int index, int pos)
+{
+    int8_t dx = (orient ? pos : index) - OSD_AHI_PREV_SIZE / 2;
+    int8_t dy = (orient ? index : pos) - OSD_AHI_PREV_SIZE / 2;
+    *x = elemPosX + dx;
+    *y = elemPosY - dy;
+}
+
+// Erases a cell drawn by the AHI, unless another element drew over it since
+static void osdGridAhiEraseCell(displayPort_t *display, uint8_t x, uint8_t y, uint16_t drawn)
+{
+    uint16_t c;
+    if (!displayReadCharWithAttr(display, x, y, &c, NULL) || c == drawn) {
+        displayWriteChar(display, x, y, SYM_BLANK);
+    }
+}
+
 void osdGridDrawArtificialHorizon(displayPort_t *display, unsigned gx, unsigned gy, float pitchAngle, float rollAngle)
 {
     UNUSED(gx);
@@ -119,59 +140,99 @@ void osdGridDrawArtificialHorizon(displayPort_t *display, unsigned gx, unsigned
 
     osdCrosshairPosition(&elemPosX, &elemPosY);
 
-    // Store the positions we draw over to erase only these at the next iteration
+    // Store the positions and characters we draw, to only rewrite the
+    // ones that change at the next iteration. Indexed by column when the
+    // line is mostly horizontal, by row when it's mostly vertical.
     static int8_t previous_written[OSD_AHI_PREV_SIZE];
+    static uint16_t previous_chars[OSD_AHI_PREV_SIZE];
     static int8_t previous_orient = -1;
 
+    int8_t written[OSD_AHI_PREV_SIZE];
+    uint16_t chars[OSD_AHI_PREV_SIZE];
+
     const float pitch_rad_to_char = (float)(OSD_AHI_HEIGHT / 2 + 0.5) / DEGREES_TO_RADIANS(osdConfig()->ahi_max_pitch);
 
     const float ky = sin_approx(rollAngle);
     const float kx = cos_approx(rollAngle);
     const float ratio = osdGetAspectRatioCorrection();
+    const int8_t orient = fabsf(ky) < fabsf(kx) ? 0 : 1;
 
-    if (previous_orient != -1) {
-        for (int i = 0; i < OSD_AHI_PREV_SIZE; ++i) {
-            if (previous_written[i] > -1) {
-                int8_t dx = (previous_orient ? previous_written[i] : i) - OSD_AHI_PREV_SIZE / 2;
-                int8_t dy = (previous_orient ? i : previous_written[i]) - OSD_AHI_PREV_SIZE / 2;
-                displayWriteChar(display, elemPosX + dx, elemPosY - dy, SYM_BLANK);
-                previous_written[i] = -1;
-            }
-        }
+    // The line position is linear in the column (or row), so it's computed
+    // once per frame and stepped in fixed point for each cell
+    for (int i = 0; i < OSD_AHI_PREV_SIZE; i++) {
+        written[i] = -1;
     }
 
-    if (fabsf(ky) < fabsf(kx)) {
-
-        previous_orient = 0;
-
-        for (int8_t dx = -OSD_AHI_WIDTH / 2; dx <= OSD_AHI_WIDTH / 2; dx++) {
-            float fy = (ratio * dx) * (ky / kx) + pitchAngle * pitch_rad_to_char + 0.49f;
-            int8_t dy = floorf(fy);
-            const uint8_t chX = elemPosX + dx, chY = elemPosY - dy;
-            uint16_t c;
+    if (orient == 0) {
+        const int32_t step = lrintf(ratio * (ky / kx) * OSD_AHI_FP_ONE);
+        int32_t fy = lrintf((pitchAngle * pitch_rad_to_char + 0.49f) * OSD_AHI_FP_ONE) - step * (OSD_AHI_WIDTH / 2);
 
-            if ((dy >= -OSD_AHI_HEIGHT / 2) && (dy <= OSD_AHI_HEIGHT / 2) && displayReadCharWithAttr(display, chX, chY, &c, NULL) && (c == SYM_BLANK)) {
-                c = SYM_AH_H_START + ((OSD_AHI_H_SYM_COUNT - 1) - (uint8_t)((fy - dy) * OSD_AHI_H_SYM_COUNT));
-                displayWriteChar(display, elemPosX + dx, elemPosY - dy, c);
-                previous_written[dx + OSD_AHI_PREV_SIZE / 2] = dy + OSD_AHI_PREV_SIZE / 2;
+        for (int dx = -OSD_AHI_WIDTH / 2; dx <= OSD_AHI_WIDTH / 2; dx++, fy += step) {
+            const int32_t dy = fy >> OSD_AHI_FP_SHIFT;
+            if ((dy >= -OSD_AHI_HEIGHT / 2) && (dy <= OSD_AHI_HEIGHT / 2)) {
+                const int32_t frac = fy & (OSD_AHI_FP_ONE - 1);
+                written[dx + OSD_AHI_PREV_SIZE / 2] = dy + OSD_AHI_PREV_SIZE / 2;
+                chars[dx + OSD_AHI_PREV_SIZE / 2] = SYM_AH_H_START + ((OSD_AHI_H_SYM_COUNT - 1) - ((frac * OSD_AHI_H_SYM_COUNT) >> OSD_AHI_FP_SHIFT));
             }
         }
-
     } else {
+        const int32_t step = lrintf((kx / ky) / ratio * OSD_AHI_FP_ONE);
+        int32_t fx = lrintf((0.5f - pitchAngle * pitch_rad_to_char * (kx / ky)) * OSD_AHI_FP_ONE) - step * (OSD_AHI_HEIGHT / 2);
+
+        for (int dy = -OSD_AHI_HEIGHT / 2; dy <= OSD_AHI_HEIGHT / 2; dy++, fx += step) {
+            const int32_t dx = fx >> OSD_AHI_FP_SHIFT;
+            if ((dx >= -OSD_AHI_WIDTH / 2) && (dx <= OSD_AHI_WIDTH / 2)) {
+                const int32_t frac = fx & (OSD_AHI_FP_ONE - 1);
+                written[dy + OSD_AHI_PREV_SIZE / 2] = dx + OSD_AHI_PREV_SIZE / 2;
+                chars[dy + OSD_AHI_PREV_SIZE / 2] = SYM_AH_V_START + ((frac * OSD_AHI_V_SYM_COUNT) >> OSD_AHI_FP_SHIFT);
+            }
+        }
+    }
+
+    // Cells are only comparable between frames with the same orientation
+    if (previous_orient != orient) {
+        if (previous_orient != -1) {
+            for (int i = 0; i < OSD_AHI_PREV_SIZE; ++i) {
+                if (previous_written[i] > -1) {
+                    uint8_t x, y;
+                    osdGridAhiCellPosition(&x, &y, elemPosX, elemPosY, previous_orient, i, previous_written[i]);
+                    osdGridAhiEraseCell(display, x, y, previous_chars[i]);
+                }
+            }
+        }
+        for (int i = 0; i < OSD_AHI_PREV_SIZE; ++i) {
+            previous_written[i] = -1;
+        }
+        previous_orient = orient;
+    }
 
-        previous_orient = 1;
+    for (int i = 0; i < OSD_AHI_PREV_SIZE; ++i) {
+        uint8_t x, y;
+        uint16_t c;
 
-        for (int8_t dy = -OSD_AHI_HEIGHT / 2; dy <= OSD_AHI_HEIGHT / 2; dy++) {
-            const float fx = ((dy / ratio) - pitchAngle * pitch_rad_to_char) * (kx / ky) + 0.5f;
-            const int8_t dx = floorf(fx);
-            const uint8_t chX = elemPosX + dx, chY = elemPosY - dy;
-            uint16_t c;
+        if (previous_written[i] > -1 && previous_written[i] != written[i]) {
+            // Line moved away from this cell
+            osdGridAhiCellPosition(&x, &y, elemPosX, elemPosY, orient, i, previous_written[i]);
+            osdGridAhiEraseCell(display, x, y, previous_chars[i]);
+            previous_written[i] = -1;
+        }
 
-            if ((dx >= -OSD_AHI_WIDTH / 2) && (dx <= OSD_AHI_WIDTH / 2) && displayReadCharWithAttr(display, chX, chY, &c, NULL) && (c == SYM_BLANK)) {
-                c = SYM_AH_V_START + (fx - dx) * OSD_AHI_V_SYM_COUNT;
-                displayWriteChar(display, chX, chY, c);
-                previous_written[dy + OSD_AHI_PREV_SIZE / 2] = dx + OSD_AHI_PREV_SIZE / 2;
+        if (written[i] > -1) {
+            osdGridAhiCellPosition(&x, &y, elemPosX, elemPosY, orient, i, written[i]);
+            if (!displayReadCharWithAttr(display, x, y, &c, NULL)) {
+                continue;
+            }
+            if (c == chars[i]) {
+                // Already showing the right glyph
+            } else if (c == SYM_BLANK || (previous_written[i] > -1 && c == previous_chars[i])) {
+                displayWriteChar(display, x, y, chars[i]);
+            } else {
+                // Taken by another element
+                previous_written[i] = -1;
+                continue;
             }
+            previous_written[i] = written[i];
+            previous_chars[i] = chars[i];
         }
     }
 }
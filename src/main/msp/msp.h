@@ -46,6 +46,7 @@ typedef struct mspPacket_s {
 
 typedef enum {
     MSP_FLAG_DONT_REPLY           = (1 << 0),
+    MSP_FLAG_STREAMED             = (1 << 1),   // Request generated by a stream, only read-only commands are processed
 } mspFlags_e;
 
 struct serialPort_s;
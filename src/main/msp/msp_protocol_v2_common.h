@@ -33,3 +33,6 @@
 #define MSP2_COMMON_SET_RADAR_POS       0x100B //SET radar position information
 #define MSP2_COMMON_SET_RADAR_ITD       0x100C //SET radar information to display
 
+#define MSP2_COMMON_SET_STREAMS         0x100D //in/out message     Sets the messages pushed periodically on this port (args: [cmd(u16), interval ms(u16)]..., returns: count(u8))
+#define MSP2_COMMON_MSP_PORT_STATS      0x100E //out message        Per MSP port load statistics (returns: [identifier(u8), commands(u32), deferred(u32), rx queue(u16), rx queue max(u16), latency us(u32), latency max us(u32)]...)
+
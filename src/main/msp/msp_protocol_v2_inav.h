@@ -80,3 +80,11 @@
 #define MSP2_INAV_SET_SAFEHOME                  0x2039
 
 #define MSP2_INAV_MISC2                         0x203A
+
+#define MSP2_INAV_CONFIG_EXPORT                 0x203B
+#define MSP2_INAV_CONFIG_IMPORT_PREPARE         0x203C
+#define MSP2_INAV_CONFIG_IMPORT_STORE           0x203D
+#define MSP2_INAV_CONFIG_IMPORT_EXEC            0x203E
+
+#define MSP2_INAV_STATE                         0x203F  // out: time(u32) quaternion(4x i16) rates(3x i16) position(3x i32) velocity(3x i16) motors(8x u16)
+#define MSP2_INAV_SET_STATE_STREAM              0x2040  // in: rate Hz(u16), 0 stops. out: rate Hz(u16). MSP2_INAV_STATE pushed from the PID loop on this port
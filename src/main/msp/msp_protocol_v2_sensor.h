@@ -22,4 +22,5 @@
 #define MSP2_SENSOR_GPS             0x1F03
 #define MSP2_SENSOR_COMPASS         0x1F04
 #define MSP2_SENSOR_BAROMETER       0x1F05
-#define MSP2_SENSOR_AIRSPEED        0x1F06
\ No newline at end of file
+#define MSP2_SENSOR_AIRSPEED        0x1F06
+#define MSP2_SENSOR_EXTERNAL_POSE   0x1F07
\ No newline at end of file
@@ -82,3 +82,17 @@ typedef struct __attribute__((packed)) {
     int16_t  magY; // mGauss, right
     int16_t  magZ; // mGauss, down
 } mspSensorCompassDataMessage_t;
+
+#define MSP_EXTERNAL_POSE_FLAG_VEL_VALID    (1 << 0)
+
+typedef struct __attribute__((packed)) {
+    uint32_t timeUs;            // FC time (as reported by MSP2_INAV_STATE) the pose was valid at, 0 = now
+    uint8_t  flags;
+    int32_t  posNorth;          // cm, relative to the navigation origin
+    int32_t  posEast;
+    int32_t  posUp;
+    int16_t  velNorth;          // cm/s
+    int16_t  velEast;
+    int16_t  velUp;
+    uint16_t posStd;            // cm, position standard deviation, 0 if unknown
+} mspSensorExternalPoseDataMessage_t;
@@ -35,6 +35,7 @@
 #include "fc/cli.h"
 
 #include "msp/msp.h"
+#include "msp/msp_protocol.h"
 #include "msp/msp_serial.h"
 
 static mspPort_t mspPorts[MAX_MSP_PORT_COUNT];
@@ -266,6 +267,23 @@ static uint8_t mspSerialChecksumBuf(uint8_t checksum, const uint8_t *data, int l
 }
 
 #define JUMBO_FRAME_SIZE_LIMIT 255
+
+// Header and checksum bytes mspSerialEncode() adds around a payload of dataLen bytes
+static int mspSerialFrameOverhead(mspVersion_e mspVersion, int dataLen)
+{
+    switch (mspVersion) {
+    case MSP_V1:
+        return 3 + sizeof(mspHeaderV1_t) + (dataLen >= JUMBO_FRAME_SIZE_LIMIT ? sizeof(mspHeaderJUMBO_t) : 0) + 1;
+    case MSP_V2_OVER_V1:
+        dataLen += sizeof(mspHeaderV2_t) + 1;
+        return 3 + sizeof(mspHeaderV1_t) + sizeof(mspHeaderV2_t) + (dataLen >= JUMBO_FRAME_SIZE_LIMIT ? sizeof(mspHeaderJUMBO_t) : 0) + 2;
+    case MSP_V2_NATIVE:
+        return 3 + sizeof(mspHeaderV2_t) + 1;
+    default:
+        return 0;
+    }
+}
+
 static int mspSerialSendFrame(mspPort_t *msp, const uint8_t * hdr, int hdrLen, const uint8_t * data, int dataLen, const uint8_t * crc, int crcLen)
 {
     // MSP port might be turned into a CLI port, which will make
@@ -290,18 +308,26 @@ static int mspSerialSendFrame(mspPort_t *msp, const uint8_t * hdr, int hdrLen, c
     // Transmit frame
     serialBeginWrite(port);
     serialWriteBuf(port, hdr, hdrLen);
-    serialWriteBuf(port, data, dataLen);
-    serialWriteBuf(port, crc, crcLen);
+    if (dataLen > 0) {
+        serialWriteBuf(port, data, dataLen);
+    }
+    if (crcLen > 0) {
+        serialWriteBuf(port, crc, crcLen);
+    }
     serialEndWrite(port);
 
     return totalFrameLength;
 }
 
-static int mspSerialEncode(mspPort_t *msp, mspPacket_t *packet, mspVersion_e mspVersion)
+/*
+ * When inPlace is set the caller guarantees MSP_FRAME_HEADER_RESERVE bytes in
+ * front of the payload and MSP_FRAME_CHECKSUM_RESERVE bytes behind it.
+ */
+static int mspSerialEncode(mspPort_t *msp, mspPacket_t *packet, mspVersion_e mspVersion, bool inPlace)
 {
     static const uint8_t mspMagic[MSP_VERSION_COUNT] = MSP_VERSION_MAGIC_INITIALIZER;
     const int dataLen = sbufBytesRemaining(&packet->buf);
-    uint8_t hdrBuf[16] = { '$', mspMagic[mspVersion], packet->result == MSP_RESULT_ERROR ? '!' : '>'};
+    uint8_t hdrBuf[MSP_FRAME_HEADER_RESERVE] = { '$', mspMagic[mspVersion], packet->result == MSP_RESULT_ERROR ? '!' : '>'};
     uint8_t crcBuf[2];
     int hdrLen = 3;
     int crcLen = 0;
@@ -385,22 +411,109 @@ static int mspSerialEncode(mspPort_t *msp, mspPacket_t *packet, mspVersion_e msp
         return 0;
     }
 
+    uint8_t *data = sbufPtr(&packet->buf);
+
+    // Replies have room around the payload, complete the frame in place
+    if (inPlace) {
+        uint8_t *frame = data - hdrLen;
+        memcpy(frame, hdrBuf, hdrLen);
+        memcpy(data + dataLen, crcBuf, crcLen);
+        return mspSerialSendFrame(msp, frame, hdrLen + dataLen + crcLen, NULL, 0, NULL, 0);
+    }
+
     // Send the frame
-    return mspSerialSendFrame(msp, hdrBuf, hdrLen, sbufPtr(&packet->buf), dataLen, crcBuf, crcLen);
+    return mspSerialSendFrame(msp, hdrBuf, hdrLen, data, dataLen, crcBuf, crcLen);
 }
 
-static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+static mspResult_e mspSerialSetStreamsCommand(mspPort_t *msp, mspPacket_t *cmd, mspPacket_t *reply)
+{
+    sbuf_t *src = &cmd->buf;
+    mspStream_t streams[MSP_MAX_STREAMS];
+    uint8_t streamCount = 0;
+    uint16_t streamCmd;
+    uint16_t intervalMs;
+
+    // Each request replaces the whole set of streams, an empty one stops them.
+    // A request which isn't valid as a whole leaves the current set alone.
+    if (sbufBytesRemaining(src) % 4 != 0) {
+        return MSP_RESULT_ERROR;
+    }
+
+    while (sbufReadU16Safe(&streamCmd, src) && sbufReadU16Safe(&intervalMs, src)) {
+        if (streamCmd == MSP2_COMMON_SET_STREAMS || streamCount >= MSP_MAX_STREAMS) {
+            return MSP_RESULT_ERROR;
+        }
+        if (intervalMs == 0) {
+            continue;
+        }
+        mspStream_t *stream = &streams[streamCount++];
+        stream->cmd = streamCmd;
+        stream->intervalMs = intervalMs;
+        stream->lastSentMs = 0;
+        stream->lastFrameSize = 0;
+    }
+
+    memcpy(msp->streams, streams, streamCount * sizeof(mspStream_t));
+    msp->streamCount = streamCount;
+    msp->streamVersion = msp->mspVersion;
+
+    sbufWriteU8(&reply->buf, msp->streamCount);
+    reply->cmd = cmd->cmd;
+    return (cmd->flags & MSP_FLAG_DONT_REPLY) ? MSP_RESULT_NO_REPLY : MSP_RESULT_ACK;
+}
+
+static mspResult_e mspSerialSetStateStreamCommand(mspPort_t *msp, mspPacket_t *cmd, mspPacket_t *reply)
+{
+    uint16_t rateHz;
+
+    if (!sbufReadU16Safe(&rateHz, &cmd->buf)) {
+        return MSP_RESULT_ERROR;
+    }
+
+    rateHz = MIN(rateHz, MSP_STATE_STREAM_RATE_MAX);
+    msp->stateStreamIntervalUs = rateHz ? 1000000 / rateHz : 0;
+    msp->stateStreamNextUs = micros();
+    msp->stateStreamVersion = msp->mspVersion;
+
+    sbufWriteU16(&reply->buf, rateHz);
+    reply->cmd = cmd->cmd;
+    return (cmd->flags & MSP_FLAG_DONT_REPLY) ? MSP_RESULT_NO_REPLY : MSP_RESULT_ACK;
+}
+
+static mspResult_e mspSerialProcessCommand(mspPort_t *msp, mspPacket_t *command, mspProcessCommandFnPtr mspProcessCommandFn, mspPostProcessFnPtr *mspPostProcessFn, mspVersion_e mspVersion, int *bytesSent)
 {
-    uint8_t outBuf[MSP_PORT_OUTBUF_SIZE];
+    // The port's own buffer has room for the frame header in front of the payload and
+    // the checksum(s) behind it, mspSerialEncode() completes the frame in place
+    uint8_t *outBuf = msp->replyBuf + MSP_FRAME_HEADER_RESERVE;
 
     mspPacket_t reply = {
-        .buf = { .ptr = outBuf, .end = ARRAYEND(outBuf), },
+        .buf = { .ptr = outBuf, .end = outBuf + MSP_PORT_OUTBUF_SIZE, },
         .cmd = -1,
         .flags = 0,
         .result = 0,
     };
     uint8_t *outBufHead = reply.buf.ptr;
 
+    mspResult_e status;
+    if (command->cmd == MSP2_COMMON_SET_STREAMS) {
+        status = mspSerialSetStreamsCommand(msp, command, &reply);
+    } else if (command->cmd == MSP2_INAV_SET_STATE_STREAM) {
+        status = mspSerialSetStateStreamCommand(msp, command, &reply);
+    } else {
+        status = mspProcessCommandFn(command, &reply, mspPostProcessFn);
+    }
+
+    *bytesSent = 0;
+    if (status != MSP_RESULT_NO_REPLY) {
+        sbufSwitchToReader(&reply.buf, outBufHead); // change streambuf direction
+        *bytesSent = mspSerialEncode(msp, &reply, mspVersion, true);
+    }
+
+    return status;
+}
+
+static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+{
     mspPacket_t command = {
         .buf = { .ptr = msp->inBuf, .end = msp->inBuf + msp->dataSize, },
         .cmd = msp->cmdMSP,
@@ -409,17 +522,56 @@ static mspPostProcessFnPtr mspSerialProcessReceivedCommand(mspPort_t *msp, mspPr
     };
 
     mspPostProcessFnPtr mspPostProcessFn = NULL;
-    const mspResult_e status = mspProcessCommandFn(&command, &reply, &mspPostProcessFn);
-
-    if (status != MSP_RESULT_NO_REPLY) {
-        sbufSwitchToReader(&reply.buf, outBufHead); // change streambuf direction
-        mspSerialEncode(msp, &reply, msp->mspVersion);
-    }
+    int bytesSent;
+    mspSerialProcessCommand(msp, &command, mspProcessCommandFn, &mspPostProcessFn, msp->mspVersion, &bytesSent);
 
     msp->c_state = MSP_IDLE;
     return mspPostProcessFn;
 }
 
+static void mspSerialProcessStreams(mspPort_t *msp, mspProcessCommandFnPtr mspProcessCommandFn)
+{
+    if (msp->streamCount == 0 || !serialIsConnected(msp->port)) {
+        return;
+    }
+
+    const timeMs_t currentTimeMs = millis();
+
+    for (int ii = 0; ii < msp->streamCount; ii++) {
+        mspStream_t *stream = &msp->streams[ii];
+
+        if (stream->intervalMs == 0 || currentTimeMs - stream->lastSentMs < stream->intervalMs) {
+            continue;
+        }
+
+        // Hold the stream back while the last frame it produced wouldn't fit,
+        // so a slow link sees lower rates instead of dropped frames
+        if (serialTxBytesFree(msp->port) < stream->lastFrameSize) {
+            continue;
+        }
+
+        mspPacket_t command = {
+            .buf = { .ptr = msp->inBuf, .end = msp->inBuf, },
+            .cmd = stream->cmd,
+            .flags = MSP_FLAG_STREAMED,
+            .result = 0,
+        };
+
+        // Post process functions (reboot, passthrough) are never run for streams
+        mspPostProcessFnPtr mspPostProcessFn = NULL;
+        int bytesSent;
+        const mspResult_e status = mspSerialProcessCommand(msp, &command, mspProcessCommandFn, &mspPostProcessFn, msp->streamVersion, &bytesSent);
+
+        if (status == MSP_RESULT_ERROR) {
+            // Not a read-only command, the error reply tells the host. Don't retry it.
+            stream->intervalMs = 0;
+        } else if (bytesSent > 0) {
+            stream->lastSentMs = currentTimeMs;
+            stream->lastFrameSize = bytesSent;
+        }
+    }
+}
+
 static void mspEvaluateNonMspData(mspPort_t * mspPort, uint8_t receivedChar)
 {
     if (receivedChar == '#') {
@@ -458,17 +610,24 @@ static void mspProcessPendingRequest(mspPort_t * mspPort)
     }
 }
 
-void mspSerialProcessOnePort(mspPort_t * const mspPort, mspEvaluateNonMspData_e evaluateNonMspData, mspProcessCommandFnPtr mspProcessCommandFn)
+static void mspSerialProcessPortBudgeted(mspPort_t * const mspPort, mspEvaluateNonMspData_e evaluateNonMspData, mspProcessCommandFnPtr mspProcessCommandFn, int byteBudget)
 {
     mspPostProcessFnPtr mspPostProcessFn = NULL;
 
-    if (serialRxBytesWaiting(mspPort->port)) {
+    const uint32_t bytesWaiting = serialRxBytesWaiting(mspPort->port);
+    if (bytesWaiting) {
         // There are bytes incoming - abort pending request
         mspPort->lastActivityMs = millis();
         mspPort->pendingRequest = MSP_PENDING_NONE;
 
+        mspPort->stats.rxQueueDepth = MIN(bytesWaiting, UINT16_MAX);
+        mspPort->stats.rxQueueDepthMax = MAX(mspPort->stats.rxQueueDepthMax, mspPort->stats.rxQueueDepth);
+        if (mspPort->pendingSinceUs == 0) {
+            mspPort->pendingSinceUs = micros();
+        }
+
         // Process incoming bytes
-        while (serialRxBytesWaiting(mspPort->port)) {
+        while (byteBudget-- > 0 && serialRxBytesWaiting(mspPort->port)) {
             const uint8_t c = serialRead(mspPort->port);
             const bool consumed = mspSerialProcessReceivedData(mspPort, c);
 
@@ -478,6 +637,13 @@ void mspSerialProcessOnePort(mspPort_t * const mspPort, mspEvaluateNonMspData_e
 
             if (mspPort->c_state == MSP_COMMAND_RECEIVED) {
                 mspPostProcessFn = mspSerialProcessReceivedCommand(mspPort, mspProcessCommandFn);
+
+                const timeUs_t currentTimeUs = micros();
+                mspPort->stats.commands++;
+                mspPort->stats.latencyUs = currentTimeUs - mspPort->pendingSinceUs;
+                mspPort->stats.latencyMaxUs = MAX(mspPort->stats.latencyMaxUs, mspPort->stats.latencyUs);
+                // Whatever is still queued has been waiting since now at most
+                mspPort->pendingSinceUs = (mspPort->port && serialRxBytesWaiting(mspPort->port)) ? currentTimeUs : 0;
                 break; // process one command at a time so as not to block.
             }
         }
@@ -488,23 +654,64 @@ void mspSerialProcessOnePort(mspPort_t * const mspPort, mspEvaluateNonMspData_e
         }
     }
     else {
+        mspPort->pendingSinceUs = 0;
         mspProcessPendingRequest(mspPort);
     }
 }
 
+void mspSerialProcessOnePort(mspPort_t * const mspPort, mspEvaluateNonMspData_e evaluateNonMspData, mspProcessCommandFnPtr mspProcessCommandFn)
+{
+    mspSerialProcessPortBudgeted(mspPort, evaluateNonMspData, mspProcessCommandFn, INT16_MAX);
+}
+
 /*
  * Process MSP commands from serial ports configured as MSP ports.
  *
  * Called periodically by the scheduler.
+ *
+ * Ports are serviced round-robin, each with a byte budget, and the pass stops
+ * once MSP_PROCESS_TIME_BUDGET_US has been spent. Ports that missed out are
+ * served first on the next pass, so a busy port can't starve the others.
  */
 void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessCommandFnPtr mspProcessCommandFn)
 {
-    for (uint8_t portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
+    static uint8_t firstPortIndex = 0;
+
+    const timeUs_t startTimeUs = micros();
+    uint8_t nextFirstPortIndex = (firstPortIndex + 1) % MAX_MSP_PORT_COUNT;
+    bool budgetExhausted = false;
+
+    for (uint8_t ii = 0; ii < MAX_MSP_PORT_COUNT; ii++) {
+        const uint8_t portIndex = (firstPortIndex + ii) % MAX_MSP_PORT_COUNT;
         mspPort_t * const mspPort = &mspPorts[portIndex];
+        if (!mspPort->port) {
+            continue;
+        }
+
+        if (budgetExhausted) {
+            if (serialRxBytesWaiting(mspPort->port)) {
+                if (mspPort->pendingSinceUs == 0) {
+                    mspPort->pendingSinceUs = micros();
+                }
+                mspPort->stats.deferred++;
+            }
+            continue;
+        }
+
+        mspSerialProcessPortBudgeted(mspPort, evaluateNonMspData, mspProcessCommandFn, MSP_PORT_RX_BYTE_BUDGET);
+
+        // Port might have been handed over to the CLI
         if (mspPort->port) {
-            mspSerialProcessOnePort(mspPort, evaluateNonMspData, mspProcessCommandFn);
+            mspSerialProcessStreams(mspPort, mspProcessCommandFn);
+        }
+
+        if (cmpTimeUs(micros(), startTimeUs) >= MSP_PROCESS_TIME_BUDGET_US) {
+            budgetExhausted = true;
+            nextFirstPortIndex = (portIndex + 1) % MAX_MSP_PORT_COUNT;
         }
     }
+
+    firstPortIndex = nextFirstPortIndex;
 }
 
 void mspSerialInit(void)
@@ -515,19 +722,14 @@ void mspSerialInit(void)
 
 int mspSerialPushPort(uint16_t cmd, const uint8_t *data, int datalen, mspPort_t *mspPort, mspVersion_e version)
 {
-    uint8_t pushBuf[MSP_PORT_OUTBUF_SIZE];
-
+    // Encode straight from the caller's data, it's only read
     mspPacket_t push = {
-        .buf = { .ptr = pushBuf, .end = ARRAYEND(pushBuf), },
+        .buf = { .ptr = (uint8_t *)data, .end = (uint8_t *)data + datalen, },
         .cmd = cmd,
         .result = 0,
     };
 
-    sbufWriteData(&push.buf, data, datalen);
-
-    sbufSwitchToReader(&push.buf, pushBuf);
-
-    return mspSerialEncode(mspPort, &push, version);
+    return mspSerialEncode(mspPort, &push, version, false);
 }
 
 int mspSerialPush(uint8_t cmd, const uint8_t *data, int datalen)
@@ -550,6 +752,47 @@ int mspSerialPush(uint8_t cmd, const uint8_t *data, int datalen)
     return ret; // return the number of bytes written
 }
 
+/*
+ * Called from the PID loop, right after the motors have been written. The
+ * state is only built when a port is due and then pushed to every due port,
+ * so all of them see the same sample. A sample which doesn't fit in a port's
+ * TX buffer is skipped, the host sees the gap in the timestamps.
+ */
+void mspSerialProcessStateStream(timeUs_t currentTimeUs, mspStateFnPtr mspStateFn)
+{
+    uint8_t stateBuf[MSP_STATE_MAX_SIZE];
+    int stateLen = -1;
+
+    for (int portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
+        mspPort_t * const mspPort = &mspPorts[portIndex];
+        if (!mspPort->port || mspPort->stateStreamIntervalUs == 0 || cmpTimeUs(currentTimeUs, mspPort->stateStreamNextUs) < 0) {
+            continue;
+        }
+
+        // Keep the phase of the stream, unless it fell behind by a whole interval
+        mspPort->stateStreamNextUs += mspPort->stateStreamIntervalUs;
+        if (cmpTimeUs(currentTimeUs, mspPort->stateStreamNextUs) >= 0) {
+            mspPort->stateStreamNextUs = currentTimeUs + mspPort->stateStreamIntervalUs;
+        }
+
+        if (!serialIsConnected(mspPort->port)) {
+            continue;
+        }
+
+        if (stateLen < 0) {
+            sbuf_t dst = { .ptr = stateBuf, .end = ARRAYEND(stateBuf) };
+            mspStateFn(&dst, currentTimeUs);
+            stateLen = dst.ptr - stateBuf;
+        }
+
+        if (serialTxBytesFree(mspPort->port) < (uint32_t)(stateLen + mspSerialFrameOverhead(mspPort->stateStreamVersion, stateLen))) {
+            continue;
+        }
+
+        mspSerialPushPort(MSP2_INAV_STATE, stateBuf, stateLen, mspPort, mspPort->stateStreamVersion);
+    }
+}
+
 uint32_t mspSerialTxBytesFree(void)
 {
     uint32_t ret = UINT32_MAX;
@@ -574,6 +817,11 @@ uint32_t mspSerialTxBytesFree(void)
     return ret;
 }
 
+const mspPort_t * mspSerialGetPort(int portIndex)
+{
+    return &mspPorts[portIndex];
+}
+
 mspPort_t * mspSerialPortFind(const serialPort_t *serialPort)
 {
     for (int portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
@@ -60,11 +60,16 @@ typedef enum {
 #ifdef USE_FLASHFS
 #define MSP_PORT_DATAFLASH_BUFFER_SIZE 4096
 #define MSP_PORT_DATAFLASH_INFO_SIZE 16
-#define MSP_PORT_OUTBUF_SIZE (MSP_PORT_DATAFLASH_BUFFER_SIZE + MSP_PORT_DATAFLASH_INFO_SIZE)    // WARNING! Must fit in stack!
+#define MSP_PORT_OUTBUF_SIZE (MSP_PORT_DATAFLASH_BUFFER_SIZE + MSP_PORT_DATAFLASH_INFO_SIZE)
 #else
 #define MSP_PORT_OUTBUF_SIZE 512
 #endif
 
+// Room around the reply payload for the frame header and checksum(s)
+#define MSP_FRAME_HEADER_RESERVE    16
+#define MSP_FRAME_CHECKSUM_RESERVE  2
+#define MSP_PORT_REPLYBUF_SIZE      (MSP_FRAME_HEADER_RESERVE + MSP_PORT_OUTBUF_SIZE + MSP_FRAME_CHECKSUM_RESERVE)
+
 typedef struct __attribute__((packed)) {
     uint8_t size;
     uint8_t cmd;
@@ -82,6 +87,36 @@ typedef struct __attribute__((packed)) {
 
 #define MSP_MAX_HEADER_SIZE     9
 
+// Messages pushed periodically without a request, see MSP2_COMMON_SET_STREAMS
+#define MSP_MAX_STREAMS         8
+
+typedef struct mspStream_s {
+    uint16_t cmd;
+    uint16_t intervalMs;
+    timeMs_t lastSentMs;
+    uint16_t lastFrameSize;     // used to hold back a stream until the TX buffer can take it
+} mspStream_t;
+
+// Bytes parsed from one port per mspSerialProcess() pass, enough for a full request
+#define MSP_PORT_RX_BYTE_BUDGET     (MSP_PORT_INBUF_SIZE + 16)
+// Once a pass has spent this long servicing ports, the remaining ones wait for the next pass
+#define MSP_PROCESS_TIME_BUDGET_US  500
+
+// Fastest MSP2_INAV_STATE stream, it can't go faster than the PID loop anyway
+#define MSP_STATE_STREAM_RATE_MAX   1000
+#define MSP_STATE_MAX_SIZE          64
+
+typedef void (*mspStateFnPtr)(sbuf_t *dst, timeUs_t currentTimeUs);
+
+typedef struct mspPortStats_s {
+    uint32_t commands;          // requests processed
+    uint32_t deferred;          // passes the port had data waiting but ran out of budget
+    uint16_t rxQueueDepth;      // bytes waiting when the port was last serviced
+    uint16_t rxQueueDepthMax;
+    uint32_t latencyUs;         // from data first seen waiting to reply sent, last request
+    uint32_t latencyMaxUs;
+} mspPortStats_t;
+
 struct serialPort_s;
 typedef struct mspPort_s {
     struct serialPort_s *port; // null when port unused.
@@ -96,6 +131,15 @@ typedef struct mspPort_s {
     uint16_t cmdMSP;
     uint8_t checksum1;
     uint8_t checksum2;
+    mspStream_t streams[MSP_MAX_STREAMS];
+    uint8_t streamCount;
+    mspVersion_e streamVersion;
+    timeDelta_t stateStreamIntervalUs;  // MSP2_INAV_STATE pushed from the PID loop, 0 when off
+    timeUs_t stateStreamNextUs;
+    mspVersion_e stateStreamVersion;
+    timeUs_t pendingSinceUs;
+    mspPortStats_t stats;
+    uint8_t replyBuf[MSP_PORT_REPLYBUF_SIZE];   // Replies are built and framed in place here
 } mspPort_t;
 
 
@@ -109,3 +153,5 @@ int mspSerialPushPort(uint16_t cmd, const uint8_t *data, int datalen, mspPort_t
 int mspSerialPush(uint8_t cmd, const uint8_t *data, int datalen);
 uint32_t mspSerialTxBytesFree(void);
 mspPort_t * mspSerialPortFind(const struct serialPort_s *serialPort);
+const mspPort_t * mspSerialGetPort(int portIndex);
+void mspSerialProcessStateStream(timeUs_t currentTimeUs, mspStateFnPtr mspStateFn);
@@ -112,6 +112,11 @@ typedef enum {
     NAV_RESET_ON_EACH_ARM,
 } nav_reset_type_e;
 
+typedef enum {
+    NAV_ESTIMATOR_COMPLEMENTARY = 0,
+    NAV_ESTIMATOR_KALMAN,
+} navEstimatorType_e;
+
 typedef enum {
     NAV_RTH_ALLOW_LANDING_NEVER = 0,
     NAV_RTH_ALLOW_LANDING_ALWAYS = 1,
@@ -152,6 +157,7 @@ typedef struct positionEstimationConfig_s {
     uint8_t gravity_calibration_tolerance;    // Tolerance of gravity calibration (cm/s/s)
     uint8_t use_gps_velned;
     uint8_t allow_dead_reckoning;
+    uint8_t estimator_type;     // navEstimatorType_e
 
     uint16_t max_surface_altitude;
 
@@ -169,12 +175,18 @@ typedef struct positionEstimationConfig_s {
     float w_xy_flow_p;
     float w_xy_flow_v;
 
+    float w_xy_extpos_p;    // Weight (cutoff frequency) for external (vision/motion capture) position measurements
+    float w_xy_extpos_v;    // Weight (cutoff frequency) for external velocity measurements
+
     float w_z_res_v;    // When velocity sources lost slowly decrease estimated velocity with this weight
     float w_xy_res_v;
 
     float w_acc_bias;   // Weight (cutoff frequency) for accelerometer bias estimation. 0 to disable.
     float w_xyz_acc_p;
 
+    float kf_acc_noise;         // Kalman filter acceleration noise density (cm/s/s/sqrt(Hz))
+    float kf_acc_bias_noise;    // Kalman filter accelerometer bias random walk (cm/s/s/sqrt(s))
+
     float max_eph_epv;  // Max estimated position error acceptable for estimation (cm)
     float baro_epv;     // Baro position error
 
@@ -420,6 +432,7 @@ void updatePositionEstimator_BaroTopic(timeUs_t currentTimeUs);
 void updatePositionEstimator_OpticalFlowTopic(timeUs_t currentTimeUs);
 void updatePositionEstimator_SurfaceTopic(timeUs_t currentTimeUs, float newSurfaceAlt);
 void updatePositionEstimator_PitotTopic(timeUs_t currentTimeUs);
+void updatePositionEstimator_ExternalPoseTopic(timeUs_t measurementTimeUs, const fpVector3_t * pos, const fpVector3_t * vel, float posStd);
 
 /* Navigation system updates */
 void updateWaypointsAndNavigationMode(void);
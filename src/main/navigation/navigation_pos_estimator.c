@@ -56,7 +56,7 @@
 
 navigationPosEstimator_t posEstimator;
 
-PG_REGISTER_WITH_RESET_TEMPLATE(positionEstimationConfig_t, positionEstimationConfig, PG_POSITION_ESTIMATION_CONFIG, 5);
+PG_REGISTER_WITH_RESET_TEMPLATE(positionEstimationConfig_t, positionEstimationConfig, PG_POSITION_ESTIMATION_CONFIG, 7);
 
 PG_RESET_TEMPLATE(positionEstimationConfig_t, positionEstimationConfig,
         // Inertial position estimator parameters
@@ -67,6 +67,7 @@ PG_RESET_TEMPLATE(positionEstimationConfig_t, positionEstimationConfig,
         .use_gps_velned = SETTING_INAV_USE_GPS_VELNED_DEFAULT,                        // "Disabled" is mandatory with gps_dyn_model = Pedestrian
         .use_gps_no_baro = SETTING_INAV_USE_GPS_NO_BARO_DEFAULT,                      // Use GPS altitude if no baro is available on all aircrafts
         .allow_dead_reckoning = SETTING_INAV_ALLOW_DEAD_RECKONING_DEFAULT,
+        .estimator_type = SETTING_INAV_ESTIMATOR_DEFAULT,
 
         .max_surface_altitude = SETTING_INAV_MAX_SURFACE_ALTITUDE_DEFAULT,
 
@@ -86,11 +87,17 @@ PG_RESET_TEMPLATE(positionEstimationConfig_t, positionEstimationConfig,
         .w_xy_flow_p = SETTING_INAV_W_XY_FLOW_P_DEFAULT,
         .w_xy_flow_v = SETTING_INAV_W_XY_FLOW_V_DEFAULT,
 
+        .w_xy_extpos_p = SETTING_INAV_W_XY_EXTPOS_P_DEFAULT,
+        .w_xy_extpos_v = SETTING_INAV_W_XY_EXTPOS_V_DEFAULT,
+
         .w_z_res_v = SETTING_INAV_W_Z_RES_V_DEFAULT,
         .w_xy_res_v = SETTING_INAV_W_XY_RES_V_DEFAULT,
 
         .w_acc_bias = SETTING_INAV_W_ACC_BIAS_DEFAULT,
 
+        .kf_acc_noise = SETTING_INAV_KF_ACC_NOISE_DEFAULT,
+        .kf_acc_bias_noise = SETTING_INAV_KF_ACC_BIAS_NOISE_DEFAULT,
+
         .max_eph_epv = SETTING_INAV_MAX_EPH_EPV_DEFAULT,
         .baro_epv = SETTING_INAV_BARO_EPV_DEFAULT
 );
@@ -286,6 +293,7 @@ void onNewGPSData(void)
 
                 /* Indicate a last valid reading of Pos/Vel */
                 posEstimator.gps.lastUpdateTime = currentTimeUs;
+                posEstimator.gps.measurementTime = currentTimeUs - MS2US(gpsGetFixDelayMs());
             }
 
             previousLat = gpsSol.llh.lat;
@@ -347,6 +355,31 @@ void updatePositionEstimator_PitotTopic(timeUs_t currentTimeUs)
 }
 #endif
 
+/**
+ * Update external pose topic
+ *  Function is called when a pose from a vision or motion capture system arrives over MSP or MAVLink.
+ *  measurementTimeUs is the time the pose was valid at, 0 means now.
+ *  posStd of zero, below zero or NaN means the accuracy is unknown.
+ */
+void updatePositionEstimator_ExternalPoseTopic(timeUs_t measurementTimeUs, const fpVector3_t * pos, const fpVector3_t * vel, float posStd)
+{
+    const timeUs_t currentTimeUs = micros();
+
+    // Reject timestamps from the future
+    if (measurementTimeUs == 0 || cmpTimeUs(measurementTimeUs, currentTimeUs) > 0) {
+        measurementTimeUs = currentTimeUs;
+    }
+
+    posEstimator.extPos.pos = *pos;
+    posEstimator.extPos.velValid = (vel != NULL);
+    if (vel) {
+        posEstimator.extPos.vel = *vel;
+    }
+    posEstimator.extPos.eph = (posStd > 0.0f) ? posStd : INAV_EXTPOS_DEFAULT_STD;
+    posEstimator.extPos.measurementTime = measurementTimeUs;
+    posEstimator.extPos.lastUpdateTime = currentTimeUs;
+}
+
 /**
  * Update IMU topic
  *  Function is called at main loop rate
@@ -502,6 +535,11 @@ static uint32_t calculateCurrentValidityFlags(timeUs_t currentTimeUs)
         newFlags |= EST_FLOW_VALID;
     }
 
+    if (posEstimator.extPos.lastUpdateTime && ((currentTimeUs - posEstimator.extPos.lastUpdateTime) <= MS2US(INAV_EXTPOS_TIMEOUT_MS)) &&
+        (posEstimator.extPos.eph < positionEstimationConfig()->max_eph_epv)) {
+        newFlags |= EST_EXTPOS_VALID;
+    }
+
     if (posEstimator.est.eph < positionEstimationConfig()->max_eph_epv) {
         newFlags |= EST_XY_VALID;
     }
@@ -513,15 +551,28 @@ static uint32_t calculateCurrentValidityFlags(timeUs_t currentTimeUs)
     return newFlags;
 }
 
+static bool estimationUseKalman(void)
+{
+    return positionEstimationConfig()->estimator_type == NAV_ESTIMATOR_KALMAN;
+}
+
 static void estimationPredict(estimationContext_t * ctx)
 {
     const float accWeight = navGetAccelerometerWeight();
+    fpVector3_t accelNEU = posEstimator.imu.accelNEU;
+
+    // Kalman filter estimates accelerometer bias in earth frame
+    if (estimationUseKalman()) {
+        for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+            accelNEU.v[axis] -= posEstimator.kalman.filter.axis[axis].accBias;
+        }
+    }
 
     /* Prediction step: Z-axis */
     if ((ctx->newFlags & EST_Z_VALID)) {
         posEstimator.est.pos.z += posEstimator.est.vel.z * ctx->dt;
-        posEstimator.est.pos.z += posEstimator.imu.accelNEU.z * sq(ctx->dt) / 2.0f * accWeight;
-        posEstimator.est.vel.z += posEstimator.imu.accelNEU.z * ctx->dt * sq(accWeight);
+        posEstimator.est.pos.z += accelNEU.z * sq(ctx->dt) / 2.0f * accWeight;
+        posEstimator.est.vel.z += accelNEU.z * ctx->dt * sq(accWeight);
     }
 
     /* Prediction step: XY-axis */
@@ -532,39 +583,44 @@ static void estimationPredict(estimationContext_t * ctx)
 
         // If heading is valid, accelNEU is valid as well. Account for acceleration
         if (navIsHeadingUsable() && navIsAccelerationUsable()) {
-            posEstimator.est.pos.x += posEstimator.imu.accelNEU.x * sq(ctx->dt) / 2.0f * accWeight;
-            posEstimator.est.pos.y += posEstimator.imu.accelNEU.y * sq(ctx->dt) / 2.0f * accWeight;
-            posEstimator.est.vel.x += posEstimator.imu.accelNEU.x * ctx->dt * sq(accWeight);
-            posEstimator.est.vel.y += posEstimator.imu.accelNEU.y * ctx->dt * sq(accWeight);
+            posEstimator.est.pos.x += accelNEU.x * sq(ctx->dt) / 2.0f * accWeight;
+            posEstimator.est.pos.y += accelNEU.y * sq(ctx->dt) / 2.0f * accWeight;
+            posEstimator.est.vel.x += accelNEU.x * ctx->dt * sq(accWeight);
+            posEstimator.est.vel.y += accelNEU.y * ctx->dt * sq(accWeight);
         }
     }
 }
 
-static bool estimationCalculateCorrection_Z(estimationContext_t * ctx)
+static bool estimationDetectAirCushionEffect(estimationContext_t * ctx)
 {
-    if (ctx->newFlags & EST_BARO_VALID) {
-        timeUs_t currentTimeUs = micros();
+    timeUs_t currentTimeUs = micros();
 
-        if (!ARMING_FLAG(ARMED)) {
-            posEstimator.state.baroGroundAlt = posEstimator.est.pos.z;
-            posEstimator.state.isBaroGroundValid = true;
-            posEstimator.state.baroGroundTimeout = currentTimeUs + 250000;   // 0.25 sec
+    if (!ARMING_FLAG(ARMED)) {
+        posEstimator.state.baroGroundAlt = posEstimator.est.pos.z;
+        posEstimator.state.isBaroGroundValid = true;
+        posEstimator.state.baroGroundTimeout = currentTimeUs + 250000;   // 0.25 sec
+    }
+    else {
+        if (posEstimator.est.vel.z > 15) {
+            if (currentTimeUs > posEstimator.state.baroGroundTimeout) {
+                posEstimator.state.isBaroGroundValid = false;
+            }
         }
         else {
-            if (posEstimator.est.vel.z > 15) {
-                if (currentTimeUs > posEstimator.state.baroGroundTimeout) {
-                    posEstimator.state.isBaroGroundValid = false;
-                }
-            }
-            else {
-                posEstimator.state.baroGroundTimeout = currentTimeUs + 250000;   // 0.25 sec
-            }
+            posEstimator.state.baroGroundTimeout = currentTimeUs + 250000;   // 0.25 sec
         }
+    }
 
-        // We might be experiencing air cushion effect - use sonar or baro groung altitude to detect it
-        bool isAirCushionEffectDetected = ARMING_FLAG(ARMED) &&
-                                            (((ctx->newFlags & EST_SURFACE_VALID) && posEstimator.surface.alt < 20.0f && posEstimator.state.isBaroGroundValid) ||
-                                             ((ctx->newFlags & EST_BARO_VALID) && posEstimator.state.isBaroGroundValid && posEstimator.baro.alt < posEstimator.state.baroGroundAlt));
+    // We might be experiencing air cushion effect - use sonar or baro groung altitude to detect it
+    return ARMING_FLAG(ARMED) &&
+            (((ctx->newFlags & EST_SURFACE_VALID) && posEstimator.surface.alt < 20.0f && posEstimator.state.isBaroGroundValid) ||
+             ((ctx->newFlags & EST_BARO_VALID) && posEstimator.state.isBaroGroundValid && posEstimator.baro.alt < posEstimator.state.baroGroundAlt));
+}
+
+static bool estimationCalculateCorrection_Z(estimationContext_t * ctx)
+{
+    if (ctx->newFlags & EST_BARO_VALID) {
+        const bool isAirCushionEffectDetected = estimationDetectAirCushionEffect(ctx);
 
         // Altitude
         const float baroAltResidual = (isAirCushionEffectDetected ? posEstimator.state.baroGroundAlt : posEstimator.baro.alt) - posEstimator.est.pos.z;
@@ -573,8 +629,12 @@ static bool estimationCalculateCorrection_Z(estimationContext_t * ctx)
 
         // If GPS is available - also use GPS climb rate
         if (ctx->newFlags & EST_GPS_Z_VALID) {
+            fpVector3_t gpsRefPos;
+            fpVector3_t gpsRefVel;
+            posEstimatorHistoryGet(&posEstimator.history, posEstimator.gps.measurementTime, &posEstimator.est.pos, &posEstimator.est.vel, posEstimator.est.lastUpdateTime, &gpsRefPos, &gpsRefVel);
+
             // Trust GPS velocity only if residual/error is less than 2.5 m/s, scale weight according to gaussian distribution
-            const float gpsRocResidual = posEstimator.gps.vel.z - posEstimator.est.vel.z;
+            const float gpsRocResidual = posEstimator.gps.vel.z - gpsRefVel.z;
             const float gpsRocScaler = bellCurve(gpsRocResidual, 250.0f);
             ctx->estVelCorr.z += gpsRocResidual * positionEstimationConfig()->w_z_gps_v * gpsRocScaler * ctx->dt;
         }
@@ -597,12 +657,18 @@ static bool estimationCalculateCorrection_Z(estimationContext_t * ctx)
             ctx->newEPV = posEstimator.gps.epv;
         }
         else {
+            fpVector3_t gpsRefPos;
+            fpVector3_t gpsRefVel;
+            const bool gpsDelayed = posEstimatorHistoryGet(&posEstimator.history, posEstimator.gps.measurementTime, &posEstimator.est.pos, &posEstimator.est.vel, posEstimator.est.lastUpdateTime, &gpsRefPos, &gpsRefVel);
+            const float gpsAge = gpsDelayed ? posEstimatorHistoryMeasurementAge(posEstimator.est.lastUpdateTime, posEstimator.gps.measurementTime) : 0.0f;
+
             // Altitude
-            const float gpsAltResudual = posEstimator.gps.pos.z - posEstimator.est.pos.z;
+            const float gpsAltResudual = posEstimator.gps.pos.z - gpsRefPos.z;
+            const float gpsVelZCorr = (gpsAltResudual * sq(positionEstimationConfig()->w_z_gps_p) + (posEstimator.gps.vel.z - gpsRefVel.z) * positionEstimationConfig()->w_z_gps_v) * ctx->dt;
 
             ctx->estPosCorr.z += gpsAltResudual * positionEstimationConfig()->w_z_gps_p * ctx->dt;
-            ctx->estVelCorr.z += gpsAltResudual * sq(positionEstimationConfig()->w_z_gps_p) * ctx->dt;
-            ctx->estVelCorr.z += (posEstimator.gps.vel.z - posEstimator.est.vel.z) * positionEstimationConfig()->w_z_gps_v * ctx->dt;
+            ctx->estPosCorr.z += gpsVelZCorr * gpsAge;
+            ctx->estVelCorr.z += gpsVelZCorr;
             ctx->newEPV = updateEPE(posEstimator.est.epv, ctx->dt, MAX(posEstimator.gps.epv, gpsAltResudual), positionEstimationConfig()->w_z_gps_p);
 
             // Accelerometer bias
@@ -636,11 +702,13 @@ static bool estimationCalculateCorrection_XY_GPS(estimationContext_t * ctx)
             ctx->newEPH = posEstimator.gps.eph;
         }
         else {
-            const float gpsPosXResidual = posEstimator.gps.pos.x - posEstimator.est.pos.x;
-            const float gpsPosYResidual = posEstimator.gps.pos.y - posEstimator.est.pos.y;
-            const float gpsVelXResidual = posEstimator.gps.vel.x - posEstimator.est.vel.x;
-            const float gpsVelYResidual = posEstimator.gps.vel.y - posEstimator.est.vel.y;
-            const float gpsPosResidualMag = fast_fsqrtf(sq(gpsPosXResidual) + sq(gpsPosYResidual));
+            /* GPS fix is delayed - compare it against our estimate at the time it was taken */
+            const posEstimatorDelayedMeasurement_t gpsMeas = {
+                .pos = posEstimator.gps.pos,
+                .vel = posEstimator.gps.vel,
+                .velValid = true,
+                .time = posEstimator.gps.measurementTime,
+            };
 
             //const float gpsWeightScaler = scaleRangef(bellCurve(gpsPosResidualMag, INAV_GPS_ACCEPTANCE_EPE), 0.0f, 1.0f, 0.1f, 1.0f);
             const float gpsWeightScaler = 1.0f;
@@ -648,24 +716,188 @@ static bool estimationCalculateCorrection_XY_GPS(estimationContext_t * ctx)
             const float w_xy_gps_p = positionEstimationConfig()->w_xy_gps_p * gpsWeightScaler;
             const float w_xy_gps_v = positionEstimationConfig()->w_xy_gps_v * sq(gpsWeightScaler);
 
-            // Coordinates
-            ctx->estPosCorr.x += gpsPosXResidual * w_xy_gps_p * ctx->dt;
-            ctx->estPosCorr.y += gpsPosYResidual * w_xy_gps_p * ctx->dt;
+            const float gpsPosResidualMag = posEstimatorHistoryCorrectXY(&posEstimator.history, &gpsMeas,
+                                                &posEstimator.est.pos, &posEstimator.est.vel, posEstimator.est.lastUpdateTime,
+                                                w_xy_gps_p, w_xy_gps_v, ctx->dt,
+                                                &ctx->estPosCorr, &ctx->estVelCorr, &ctx->accBiasCorr);
 
-            // Velocity from coordinates
-            ctx->estVelCorr.x += gpsPosXResidual * sq(w_xy_gps_p) * ctx->dt;
-            ctx->estVelCorr.y += gpsPosYResidual * sq(w_xy_gps_p) * ctx->dt;
+            /* Adjust EPH */
+            ctx->newEPH = updateEPE(posEstimator.est.eph, ctx->dt, MAX(posEstimator.gps.eph, gpsPosResidualMag), w_xy_gps_p);
+        }
 
-            // Velocity from direct measurement
-            ctx->estVelCorr.x += gpsVelXResidual * w_xy_gps_v * ctx->dt;
-            ctx->estVelCorr.y += gpsVelYResidual * w_xy_gps_v * ctx->dt;
+        return true;
+    }
 
-            // Accelerometer bias
-            ctx->accBiasCorr.x -= gpsPosXResidual * sq(w_xy_gps_p);
-            ctx->accBiasCorr.y -= gpsPosYResidual * sq(w_xy_gps_p);
+    return false;
+}
 
-            /* Adjust EPH */
-            ctx->newEPH = updateEPE(posEstimator.est.eph, ctx->dt, MAX(posEstimator.gps.eph, gpsPosResidualMag), w_xy_gps_p);
+static bool estimationCalculateCorrection_XY_EXTPOS(estimationContext_t * ctx)
+{
+    if (!(ctx->newFlags & EST_EXTPOS_VALID)) {
+        return false;
+    }
+
+    /* If our estimate is NOT valid - reset it to the external pose */
+    if (!(ctx->newFlags & EST_XY_VALID)) {
+        ctx->estPosCorr.x += posEstimator.extPos.pos.x - posEstimator.est.pos.x;
+        ctx->estPosCorr.y += posEstimator.extPos.pos.y - posEstimator.est.pos.y;
+        if (posEstimator.extPos.velValid) {
+            ctx->estVelCorr.x += posEstimator.extPos.vel.x - posEstimator.est.vel.x;
+            ctx->estVelCorr.y += posEstimator.extPos.vel.y - posEstimator.est.vel.y;
+        }
+        ctx->newEPH = posEstimator.extPos.eph;
+        return true;
+    }
+
+    /* Compare the pose against our estimate at the time it was measured, not against the current one */
+    const posEstimatorDelayedMeasurement_t extPosMeas = {
+        .pos = posEstimator.extPos.pos,
+        .vel = posEstimator.extPos.vel,
+        .velValid = posEstimator.extPos.velValid,
+        .time = posEstimator.extPos.measurementTime,
+    };
+
+    const float w_xy_extpos_p = positionEstimationConfig()->w_xy_extpos_p;
+    const float w_xy_extpos_v = positionEstimationConfig()->w_xy_extpos_v;
+
+    const float extPosResidualMag = posEstimatorHistoryCorrectXY(&posEstimator.history, &extPosMeas,
+                                        &posEstimator.est.pos, &posEstimator.est.vel, posEstimator.est.lastUpdateTime,
+                                        w_xy_extpos_p, w_xy_extpos_v, ctx->dt,
+                                        &ctx->estPosCorr, &ctx->estVelCorr, &ctx->accBiasCorr);
+
+    /* Adjust EPH */
+    ctx->newEPH = updateEPE(posEstimator.est.eph, ctx->dt, MAX(posEstimator.extPos.eph, extPosResidualMag), w_xy_extpos_p);
+
+    return true;
+}
+
+static void estimationPredictKalman(estimationContext_t * ctx)
+{
+    // Keep position uncertainty bounded but above the validity limit
+    const float maxPosVar = sq(2.0f * positionEstimationConfig()->max_eph_epv);
+
+    for (int axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        posEstimatorKFAxisPredict(&posEstimator.kalman.filter.axis[axis], ctx->dt,
+            positionEstimationConfig()->kf_acc_noise, positionEstimationConfig()->kf_acc_bias_noise, maxPosVar);
+    }
+}
+
+/*
+ * Fuse one scalar measurement. innovation is taken against the reference state before
+ * this loop's corrections, those are subtracted here so sequential updates stay consistent.
+ * age is how long the measurement lags the estimate (s): the velocity correction is applied
+ * at the measurement time, so it is carried forward to now like the complementary filter does.
+ */
+static void estimationCorrectKalman(estimationContext_t * ctx, int axis, posEstimatorKFState_e state, float innovation, float variance, float age)
+{
+    float corr[POS_EST_KF_STATE_COUNT];
+
+    innovation -= (state == POS_EST_KF_POS) ? ctx->estPosCorr.v[axis] : ctx->estVelCorr.v[axis];
+    posEstimatorKFAxisCorrect(&posEstimator.kalman.filter.axis[axis], state, innovation, variance, corr);
+
+    ctx->estPosCorr.v[axis] += corr[POS_EST_KF_POS] + corr[POS_EST_KF_VEL] * age;
+    ctx->estVelCorr.v[axis] += corr[POS_EST_KF_VEL];
+}
+
+/*
+ * Reference state for a delayed measurement taken at measurementTime. Returns the
+ * measurement age to re-propagate the correction by, 0 if it is compared against now.
+ */
+static float estimationGetKalmanReference(timeUs_t measurementTime, fpVector3_t * refPos, fpVector3_t * refVel)
+{
+    if (posEstimatorHistoryGet(&posEstimator.history, measurementTime, &posEstimator.est.pos, &posEstimator.est.vel, posEstimator.est.lastUpdateTime, refPos, refVel)) {
+        return posEstimatorHistoryMeasurementAge(posEstimator.est.lastUpdateTime, measurementTime);
+    }
+
+    return 0.0f;
+}
+
+static void estimationResetKalmanAxis(estimationContext_t * ctx, int axis, float pos, float posStd, float velStd)
+{
+    ctx->estPosCorr.v[axis] = pos - posEstimator.est.pos.v[axis];
+    posEstimatorKFAxisReset(&posEstimator.kalman.filter.axis[axis], sq(posStd), sq(velStd), posEstimator.kalman.filter.axis[axis].P[POS_EST_KF_ACC_BIAS][POS_EST_KF_ACC_BIAS]);
+}
+
+static bool estimationCalculateCorrection_Z_Kalman(estimationContext_t * ctx, bool newGpsFix)
+{
+    fpVector3_t gpsRefPos;
+    fpVector3_t gpsRefVel;
+
+    if (ctx->newFlags & EST_BARO_VALID) {
+        const bool isAirCushionEffectDetected = estimationDetectAirCushionEffect(ctx);
+
+        if (posEstimator.baro.lastUpdateTime != posEstimator.kalman.baroFusedTime) {
+            const float baroAlt = isAirCushionEffectDetected ? posEstimator.state.baroGroundAlt : posEstimator.baro.alt;
+            estimationCorrectKalman(ctx, Z, POS_EST_KF_POS, baroAlt - posEstimator.est.pos.z, sq(posEstimator.baro.epv), 0.0f);
+        }
+
+        // If GPS is available - also use GPS climb rate
+        if ((ctx->newFlags & EST_GPS_Z_VALID) && newGpsFix) {
+            const float gpsAge = estimationGetKalmanReference(posEstimator.gps.measurementTime, &gpsRefPos, &gpsRefVel);
+            estimationCorrectKalman(ctx, Z, POS_EST_KF_VEL, posEstimator.gps.vel.z - gpsRefVel.z, sq(INAV_KF_GPS_VEL_STD), gpsAge);
+        }
+
+        return true;
+    }
+    else if ((STATE(FIXED_WING_LEGACY) || positionEstimationConfig()->use_gps_no_baro) && (ctx->newFlags & EST_GPS_Z_VALID)) {
+        // If baro is not available - use GPS Z for correction on a plane
+        if (!(ctx->newFlags & EST_Z_VALID)) {
+            estimationResetKalmanAxis(ctx, Z, posEstimator.gps.pos.z, posEstimator.gps.epv, INAV_KF_GPS_VEL_STD);
+            ctx->estVelCorr.z = posEstimator.gps.vel.z - posEstimator.est.vel.z;
+        }
+        else if (newGpsFix) {
+            const float gpsAge = estimationGetKalmanReference(posEstimator.gps.measurementTime, &gpsRefPos, &gpsRefVel);
+            estimationCorrectKalman(ctx, Z, POS_EST_KF_POS, posEstimator.gps.pos.z - gpsRefPos.z, sq(posEstimator.gps.epv), gpsAge);
+            estimationCorrectKalman(ctx, Z, POS_EST_KF_VEL, posEstimator.gps.vel.z - gpsRefVel.z, sq(INAV_KF_GPS_VEL_STD), gpsAge);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+static bool estimationCalculateCorrection_XY_Kalman(estimationContext_t * ctx, bool newGpsFix, bool newExtPos)
+{
+    const navPositionEstimatorEXTPOS_t * extPos = &posEstimator.extPos;
+    fpVector3_t refPos;
+    fpVector3_t refVel;
+
+    if (ctx->newFlags & EST_GPS_XY_VALID) {
+        if (!(ctx->newFlags & EST_XY_VALID)) {
+            for (int axis = X; axis <= Y; axis++) {
+                estimationResetKalmanAxis(ctx, axis, posEstimator.gps.pos.v[axis], posEstimator.gps.eph, INAV_KF_GPS_VEL_STD);
+                ctx->estVelCorr.v[axis] = posEstimator.gps.vel.v[axis] - posEstimator.est.vel.v[axis];
+            }
+        }
+        else if (newGpsFix) {
+            const float gpsAge = estimationGetKalmanReference(posEstimator.gps.measurementTime, &refPos, &refVel);
+            for (int axis = X; axis <= Y; axis++) {
+                estimationCorrectKalman(ctx, axis, POS_EST_KF_POS, posEstimator.gps.pos.v[axis] - refPos.v[axis], sq(posEstimator.gps.eph), gpsAge);
+                estimationCorrectKalman(ctx, axis, POS_EST_KF_VEL, posEstimator.gps.vel.v[axis] - refVel.v[axis], sq(INAV_KF_GPS_VEL_STD), gpsAge);
+            }
+        }
+
+        return true;
+    }
+
+    if (ctx->newFlags & EST_EXTPOS_VALID) {
+        if (!(ctx->newFlags & EST_XY_VALID)) {
+            for (int axis = X; axis <= Y; axis++) {
+                estimationResetKalmanAxis(ctx, axis, extPos->pos.v[axis], extPos->eph, INAV_KF_EXTPOS_VEL_STD);
+                if (extPos->velValid) {
+                    ctx->estVelCorr.v[axis] = extPos->vel.v[axis] - posEstimator.est.vel.v[axis];
+                }
+            }
+        }
+        else if (newExtPos) {
+            const float extPosAge = estimationGetKalmanReference(extPos->measurementTime, &refPos, &refVel);
+            for (int axis = X; axis <= Y; axis++) {
+                estimationCorrectKalman(ctx, axis, POS_EST_KF_POS, extPos->pos.v[axis] - refPos.v[axis], sq(extPos->eph), extPosAge);
+                if (extPos->velValid) {
+                    estimationCorrectKalman(ctx, axis, POS_EST_KF_VEL, extPos->vel.v[axis] - refVel.v[axis], sq(INAV_KF_EXTPOS_VEL_STD), extPosAge);
+                }
+            }
         }
 
         return true;
@@ -708,15 +940,44 @@ static void updateEstimatedTopic(timeUs_t currentTimeUs)
     /* Prediction stage: X,Y,Z */
     estimationPredict(&ctx);
 
-    /* Correction stage: Z */
-    const bool estZCorrectOk =
-        estimationCalculateCorrection_Z(&ctx);
+    bool estZCorrectOk;
+    bool estXYCorrectOk;
+
+    if (estimationUseKalman()) {
+        estimationPredictKalman(&ctx);
 
-    /* Correction stage: XY: GPS, FLOW */
-    // FIXME: Handle transition from FLOW to GPS and back - seamlessly fly indoor/outdoor
-    const bool estXYCorrectOk =
-        estimationCalculateCorrection_XY_GPS(&ctx) ||
-        estimationCalculateCorrection_XY_FLOW(&ctx);
+        /* Each measurement is fused once, the filter weighs it by its accuracy */
+        const bool newGpsFix = posEstimator.gps.lastUpdateTime != posEstimator.kalman.gpsFusedTime;
+        const bool newExtPos = posEstimator.extPos.lastUpdateTime != posEstimator.kalman.extPosFusedTime;
+
+        estZCorrectOk = estimationCalculateCorrection_Z_Kalman(&ctx, newGpsFix);
+
+        const bool estXYKalmanOk = estimationCalculateCorrection_XY_Kalman(&ctx, newGpsFix, newExtPos);
+        estXYCorrectOk = estXYKalmanOk || estimationCalculateCorrection_XY_FLOW(&ctx);
+
+        posEstimator.kalman.gpsFusedTime = posEstimator.gps.lastUpdateTime;
+        posEstimator.kalman.baroFusedTime = posEstimator.baro.lastUpdateTime;
+        posEstimator.kalman.extPosFusedTime = posEstimator.extPos.lastUpdateTime;
+
+        /* Uncertainty comes from the covariance, unless optical flow did the XY correction */
+        const posEstimatorKF_t * kf = &posEstimator.kalman.filter;
+        if (estXYKalmanOk || !estXYCorrectOk) {
+            ctx.newEPH = sqrtf(kf->axis[X].P[POS_EST_KF_POS][POS_EST_KF_POS] + kf->axis[Y].P[POS_EST_KF_POS][POS_EST_KF_POS]);
+        }
+        ctx.newEPV = sqrtf(kf->axis[Z].P[POS_EST_KF_POS][POS_EST_KF_POS]);
+    }
+    else {
+        /* Correction stage: Z */
+        estZCorrectOk =
+            estimationCalculateCorrection_Z(&ctx);
+
+        /* Correction stage: XY: GPS, external pose, FLOW */
+        // FIXME: Handle transition from FLOW to GPS and back - seamlessly fly indoor/outdoor
+        estXYCorrectOk =
+            estimationCalculateCorrection_XY_GPS(&ctx) ||
+            estimationCalculateCorrection_XY_EXTPOS(&ctx) ||
+            estimationCalculateCorrection_XY_FLOW(&ctx);
+    }
 
     // If we can't apply correction or accuracy is off the charts - decay velocity to zero
     if (!estXYCorrectOk || ctx.newEPH > positionEstimationConfig()->max_eph_epv) {
@@ -732,8 +993,12 @@ static void updateEstimatedTopic(timeUs_t currentTimeUs)
     vectorAdd(&posEstimator.est.pos, &posEstimator.est.pos, &ctx.estPosCorr);
     vectorAdd(&posEstimator.est.vel, &posEstimator.est.vel, &ctx.estVelCorr);
 
-    /* Correct accelerometer bias */
-    if (positionEstimationConfig()->w_acc_bias > 0.0f) {
+    /* Keep past states in line with the corrected estimate and remember the new one */
+    posEstimatorHistoryApplyCorrection(&posEstimator.history, &ctx.estPosCorr, &ctx.estVelCorr);
+    posEstimatorHistoryStore(&posEstimator.history, currentTimeUs, &posEstimator.est.pos, &posEstimator.est.vel);
+
+    /* Correct accelerometer bias, the Kalman filter does this itself */
+    if (!estimationUseKalman() && positionEstimationConfig()->w_acc_bias > 0.0f) {
         const float accelBiasCorrMagnitudeSq = sq(ctx.accBiasCorr.x) + sq(ctx.accBiasCorr.y) + sq(ctx.accBiasCorr.z);
         if (accelBiasCorrMagnitudeSq < sq(INAV_ACC_BIAS_ACCEPTANCE_VALUE)) {
             /* transform error vector from NEU frame to body frame */
@@ -814,6 +1079,7 @@ void initializePositionEstimator(void)
     posEstimator.gps.lastUpdateTime = 0;
     posEstimator.baro.lastUpdateTime = 0;
     posEstimator.surface.lastUpdateTime = 0;
+    posEstimator.extPos.lastUpdateTime = 0;
 
     posEstimator.est.aglAlt = 0;
     posEstimator.est.aglVel = 0;
@@ -833,6 +1099,13 @@ void initializePositionEstimator(void)
 
     pt1FilterInit(&posEstimator.baro.avgFilter, INAV_BARO_AVERAGE_HZ, 0.0f);
     pt1FilterInit(&posEstimator.surface.avgFilter, INAV_SURFACE_AVERAGE_HZ, 0.0f);
+
+    posEstimatorHistoryReset(&posEstimator.history);
+
+    for (axis = 0; axis < XYZ_AXIS_COUNT; axis++) {
+        posEstimatorKFAxisReset(&posEstimator.kalman.filter.axis[axis], sq(posEstimator.est.eph), sq(INAV_KF_GPS_VEL_STD), sq(INAV_KF_ACC_BIAS_INITIAL_STD));
+        posEstimator.kalman.filter.axis[axis].accBias = 0;
+    }
 }
 
 /**
@@ -0,0 +1,194 @@
+/*
+ * This file is part of INAV Project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU General Public License Version 3, as described below:
+ *
+ * This file is free software: you may copy, redistribute and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "common/maths.h"
+#include "common/time.h"
+#include "common/vector.h"
+
+#include "navigation/navigation_pos_estimator_history.h"
+
+static const posEstimatorHistorySample_t * historySample(const posEstimatorHistory_t * history, unsigned age)
+{
+    // age 0 is the newest sample
+    return &history->samples[(history->head + POS_ESTIMATOR_HISTORY_SIZE - 1 - age) % POS_ESTIMATOR_HISTORY_SIZE];
+}
+
+void posEstimatorHistoryReset(posEstimatorHistory_t * history)
+{
+    memset(history, 0, sizeof(*history));
+}
+
+/*
+ * Fold accumulated corrections into the stored samples. Called once per
+ * ring wrap to keep the correction sums small and preserve float precision.
+ */
+static void posEstimatorHistoryRebase(posEstimatorHistory_t * history)
+{
+    for (unsigned i = 0; i < history->count; i++) {
+        posEstimatorHistorySample_t * sample = &history->samples[i];
+        vectorAdd(&sample->pos, &sample->pos, &history->posCorrSum);
+        vectorAdd(&sample->vel, &sample->vel, &history->velCorrSum);
+    }
+
+    vectorZero(&history->posCorrSum);
+    vectorZero(&history->velCorrSum);
+}
+
+void posEstimatorHistoryStore(posEstimatorHistory_t * history, timeUs_t currentTimeUs, const fpVector3_t * pos, const fpVector3_t * vel)
+{
+    if (history->count > 0 && cmpTimeUs(currentTimeUs, historySample(history, 0)->time) < POS_ESTIMATOR_HISTORY_INTERVAL_US) {
+        return;
+    }
+
+    if (history->head == 0) {
+        posEstimatorHistoryRebase(history);
+    }
+
+    posEstimatorHistorySample_t * sample = &history->samples[history->head];
+    sample->time = currentTimeUs;
+    sample->pos.x = pos->x - history->posCorrSum.x;
+    sample->pos.y = pos->y - history->posCorrSum.y;
+    sample->pos.z = pos->z - history->posCorrSum.z;
+    sample->vel.x = vel->x - history->velCorrSum.x;
+    sample->vel.y = vel->y - history->velCorrSum.y;
+    sample->vel.z = vel->z - history->velCorrSum.z;
+
+    history->head = (history->head + 1) % POS_ESTIMATOR_HISTORY_SIZE;
+    if (history->count < POS_ESTIMATOR_HISTORY_SIZE) {
+        history->count++;
+    }
+}
+
+void posEstimatorHistoryApplyCorrection(posEstimatorHistory_t * history, const fpVector3_t * posCorr, const fpVector3_t * velCorr)
+{
+    vectorAdd(&history->posCorrSum, &history->posCorrSum, posCorr);
+    vectorAdd(&history->velCorrSum, &history->velCorrSum, velCorr);
+}
+
+/*
+ * Returns the estimator state at the given time, linearly interpolated between
+ * the two closest samples and shifted by the corrections applied since.
+ * Times after the newest sample are interpolated towards the current estimate
+ * (estPos/estVel at estimateTime). Times older than the oldest sample fail and
+ * return the current estimate.
+ */
+bool posEstimatorHistoryGet(const posEstimatorHistory_t * history, timeUs_t time,
+                            const fpVector3_t * estPos, const fpVector3_t * estVel, timeUs_t estimateTime,
+                            fpVector3_t * pos, fpVector3_t * vel)
+{
+    if (cmpTimeUs(time, estimateTime) >= 0) {
+        *pos = *estPos;
+        *vel = *estVel;
+        return true;
+    }
+
+    *pos = *estPos;
+    *vel = *estVel;
+
+    if (history->count == 0) {
+        return false;
+    }
+
+    const posEstimatorHistorySample_t * newer = historySample(history, 0);
+    if (cmpTimeUs(time, newer->time) >= 0) {
+        const float k = (float)cmpTimeUs(time, newer->time) / (float)cmpTimeUs(estimateTime, newer->time);
+
+        for (int axis = 0; axis < 3; axis++) {
+            const float newerPos = newer->pos.v[axis] + history->posCorrSum.v[axis];
+            const float newerVel = newer->vel.v[axis] + history->velCorrSum.v[axis];
+            pos->v[axis] = newerPos + (estPos->v[axis] - newerPos) * k;
+            vel->v[axis] = newerVel + (estVel->v[axis] - newerVel) * k;
+        }
+        return true;
+    }
+
+    for (unsigned age = 1; age < history->count; age++) {
+        const posEstimatorHistorySample_t * older = historySample(history, age);
+
+        if (cmpTimeUs(time, older->time) >= 0) {
+            const float k = (float)cmpTimeUs(time, older->time) / (float)cmpTimeUs(newer->time, older->time);
+
+            for (int axis = 0; axis < 3; axis++) {
+                pos->v[axis] = older->pos.v[axis] + (newer->pos.v[axis] - older->pos.v[axis]) * k + history->posCorrSum.v[axis];
+                vel->v[axis] = older->vel.v[axis] + (newer->vel.v[axis] - older->vel.v[axis]) * k + history->velCorrSum.v[axis];
+            }
+            return true;
+        }
+
+        newer = older;
+    }
+
+    return false;
+}
+
+/*
+ * Time (s) between a delayed measurement and the current estimate. Velocity corrections
+ * calculated at the measurement time are propagated over this interval to reach the current state.
+ */
+float posEstimatorHistoryMeasurementAge(timeUs_t estimateTime, timeUs_t measurementTime)
+{
+    const timeDelta_t ageUs = cmpTimeUs(estimateTime, measurementTime);
+    return US2S(constrain(ageUs, 0, POS_ESTIMATOR_HISTORY_SIZE * POS_ESTIMATOR_HISTORY_INTERVAL_US));
+}
+
+/*
+ * XY correction of the complementary filter from a delayed measurement. The residuals are
+ * taken against the estimate at the time the measurement was taken and the velocity
+ * correction is re-propagated from then to now. Measurements older than the history are
+ * taken against the current estimate, as if they weren't delayed.
+ * Adds to the corrections, returns the position residual magnitude.
+ */
+float posEstimatorHistoryCorrectXY(const posEstimatorHistory_t * history, const posEstimatorDelayedMeasurement_t * meas,
+                                   const fpVector3_t * estPos, const fpVector3_t * estVel, timeUs_t estimateTime,
+                                   float w_p, float w_v, float dt,
+                                   fpVector3_t * posCorr, fpVector3_t * velCorr, fpVector3_t * accBiasCorr)
+{
+    fpVector3_t refPos;
+    fpVector3_t refVel;
+    const bool delayed = posEstimatorHistoryGet(history, meas->time, estPos, estVel, estimateTime, &refPos, &refVel);
+    const float age = delayed ? posEstimatorHistoryMeasurementAge(estimateTime, meas->time) : 0.0f;
+
+    for (int axis = 0; axis < 2; axis++) {
+        const float posResidual = meas->pos.v[axis] - refPos.v[axis];
+
+        // Velocity from coordinates and from direct measurement
+        float velAxisCorr = posResidual * sq(w_p) * dt;
+        if (meas->velValid) {
+            velAxisCorr += (meas->vel.v[axis] - refVel.v[axis]) * w_v * dt;
+        }
+
+        // Coordinates, plus the velocity correction re-propagated from the measurement time to now
+        posCorr->v[axis] += posResidual * w_p * dt + velAxisCorr * age;
+        velCorr->v[axis] += velAxisCorr;
+
+        // Accelerometer bias
+        accBiasCorr->v[axis] -= posResidual * sq(w_p);
+    }
+
+    return fast_fsqrtf(sq(meas->pos.x - refPos.x) + sq(meas->pos.y - refPos.y));
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is part of INAV Project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU General Public License Version 3, as described below:
+ *
+ * This file is free software: you may copy, redistribute and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+#include "common/vector.h"
+
+#define POS_ESTIMATOR_HISTORY_SIZE          32      // Number of stored estimator states
+#define POS_ESTIMATOR_HISTORY_INTERVAL_US   20000   // 50Hz, gives 640ms of history
+
+typedef struct {
+    timeUs_t    time;
+    fpVector3_t pos;            // Estimated position (cm) minus corrections applied before storing
+    fpVector3_t vel;            // Estimated velocity (cm/s) minus corrections applied before storing
+} posEstimatorHistorySample_t;
+
+/*
+ * Ring of past predicted estimator states used to fuse delayed measurements.
+ * Corrections applied to the current estimate are accumulated in posCorrSum/velCorrSum
+ * instead of being added to every stored sample, so past states stay consistent
+ * with the corrected estimate at O(1) cost per update.
+ */
+typedef struct {
+    posEstimatorHistorySample_t samples[POS_ESTIMATOR_HISTORY_SIZE];
+    uint8_t     head;           // Index of the next sample to write
+    uint8_t     count;
+    fpVector3_t posCorrSum;
+    fpVector3_t velCorrSum;
+} posEstimatorHistory_t;
+
+/*
+ * Position (and optionally velocity) measurement which arrived after it was taken
+ */
+typedef struct {
+    fpVector3_t pos;
+    fpVector3_t vel;
+    bool        velValid;
+    timeUs_t    time;           // When the measurement was taken
+} posEstimatorDelayedMeasurement_t;
+
+void posEstimatorHistoryReset(posEstimatorHistory_t * history);
+void posEstimatorHistoryStore(posEstimatorHistory_t * history, timeUs_t currentTimeUs, const fpVector3_t * pos, const fpVector3_t * vel);
+void posEstimatorHistoryApplyCorrection(posEstimatorHistory_t * history, const fpVector3_t * posCorr, const fpVector3_t * velCorr);
+bool posEstimatorHistoryGet(const posEstimatorHistory_t * history, timeUs_t time,
+                            const fpVector3_t * estPos, const fpVector3_t * estVel, timeUs_t estimateTime,
+                            fpVector3_t * pos, fpVector3_t * vel);
+float posEstimatorHistoryMeasurementAge(timeUs_t estimateTime, timeUs_t measurementTime);
+float posEstimatorHistoryCorrectXY(const posEstimatorHistory_t * history, const posEstimatorDelayedMeasurement_t * meas,
+                                   const fpVector3_t * estPos, const fpVector3_t * estVel, timeUs_t estimateTime,
+                                   float w_p, float w_v, float dt,
+                                   fpVector3_t * posCorr, fpVector3_t * velCorr, fpVector3_t * accBiasCorr);
@@ -0,0 +1,114 @@
+/*
+ * This file is part of INAV Project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU General Public License Version 3, as described below:
+ *
+ * This file is free software: you may copy, redistribute and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+
+#include "navigation/navigation_pos_estimator_kf.h"
+
+void posEstimatorKFAxisReset(posEstimatorKFAxis_t * kf, float posVar, float velVar, float accBiasVar)
+{
+    memset(kf->P, 0, sizeof(kf->P));
+    kf->P[POS_EST_KF_POS][POS_EST_KF_POS] = posVar;
+    kf->P[POS_EST_KF_VEL][POS_EST_KF_VEL] = velVar;
+    kf->P[POS_EST_KF_ACC_BIAS][POS_EST_KF_ACC_BIAS] = accBiasVar;
+}
+
+/*
+ * P = F * P * F' + Q with
+ *      | 1  dt  -dt^2/2 |
+ *  F = | 0   1  -dt     |
+ *      | 0   0   1      |
+ * multiplied out to skip the zero and unity terms. accNoise is the acceleration
+ * noise density (cm/s/s per sqrt(Hz)), accBiasNoise the bias random walk
+ * (cm/s/s per sqrt(s)), so the result does not depend on the loop rate.
+ * Position variance is capped at maxPosVar so the filter stays well conditioned
+ * while a reference sensor is missing.
+ */
+void posEstimatorKFAxisPredict(posEstimatorKFAxis_t * kf, float dt, float accNoise, float accBiasNoise, float maxPosVar)
+{
+    float (*P)[POS_EST_KF_STATE_COUNT] = kf->P;
+    const float hdt2 = dt * dt / 2.0f;
+
+    // A = F * P, the last row is unchanged
+    const float a00 = P[0][0] + dt * P[1][0] - hdt2 * P[2][0];
+    const float a01 = P[0][1] + dt * P[1][1] - hdt2 * P[2][1];
+    const float a02 = P[0][2] + dt * P[1][2] - hdt2 * P[2][2];
+    const float a11 = P[1][1] - dt * P[2][1];
+    const float a12 = P[1][2] - dt * P[2][2];
+
+    // Process noise of white acceleration, integrated over dt
+    const float q = accNoise * accNoise;
+
+    // A * F' + Q, symmetric
+    P[0][0] = a00 + dt * a01 - hdt2 * a02 + q * dt * dt * dt / 3.0f;
+    P[0][1] = P[1][0] = a01 - dt * a02 + q * hdt2;
+    P[0][2] = P[2][0] = a02;
+    P[1][1] = a11 - dt * a12 + q * dt;
+    P[1][2] = P[2][1] = a12;
+    P[2][2] += accBiasNoise * accBiasNoise * dt;
+
+    // Scale the position row and column, keeps P positive definite
+    if (P[0][0] > maxPosVar) {
+        const float scale = sqrtf(maxPosVar / P[0][0]);
+        P[0][0] = maxPosVar;
+        P[0][1] = P[1][0] = P[0][1] * scale;
+        P[0][2] = P[2][0] = P[0][2] * scale;
+    }
+}
+
+/*
+ * Scalar measurement of one state: K = P * H' / (H * P * H' + R), P = (I - K * H) * P.
+ * innovation is the measurement minus the matching state. corr receives K * innovation
+ * for position, velocity and bias; the bias part is applied here.
+ */
+void posEstimatorKFAxisCorrect(posEstimatorKFAxis_t * kf, posEstimatorKFState_e state, float innovation, float variance, float corr[POS_EST_KF_STATE_COUNT])
+{
+    float (*P)[POS_EST_KF_STATE_COUNT] = kf->P;
+    const float S = P[state][state] + variance;
+
+    if (S <= 0.0f) {
+        memset(corr, 0, sizeof(float) * POS_EST_KF_STATE_COUNT);
+        return;
+    }
+
+    float K[POS_EST_KF_STATE_COUNT];
+    float Ph[POS_EST_KF_STATE_COUNT];
+    for (int i = 0; i < POS_EST_KF_STATE_COUNT; i++) {
+        Ph[i] = P[state][i];
+        K[i] = Ph[i] / S;
+        corr[i] = K[i] * innovation;
+    }
+
+    for (int i = 0; i < POS_EST_KF_STATE_COUNT; i++) {
+        for (int j = i; j < POS_EST_KF_STATE_COUNT; j++) {
+            P[i][j] -= K[i] * Ph[j];
+            P[j][i] = P[i][j];
+        }
+    }
+
+    kf->accBias += corr[POS_EST_KF_ACC_BIAS];
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of INAV Project.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Alternatively, the contents of this file may be used under the terms
+ * of the GNU General Public License Version 3, as described below:
+ *
+ * This file is free software: you may copy, redistribute and/or modify
+ * it under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This file is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General
+ * Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+/*
+ * Kalman filter for the inertial position estimator.
+ *
+ * State per NEU axis is [position, velocity, accelerometer bias]. Attitude comes
+ * from the AHRS, so acceleration is already rotated to earth frame and the axes
+ * are independent: the 9x9 covariance is block diagonal and only three 3x3 blocks
+ * are kept. All measurements are scalar and observe a single state, so no matrix
+ * inversion is needed.
+ *
+ * Only the covariance and the bias live here. Position and velocity stay in the
+ * estimator, corrections are returned to the caller to be applied there.
+ */
+
+#include "common/axis.h"
+
+typedef enum {
+    POS_EST_KF_POS = 0,
+    POS_EST_KF_VEL,
+    POS_EST_KF_ACC_BIAS,
+    POS_EST_KF_STATE_COUNT
+} posEstimatorKFState_e;
+
+typedef struct {
+    float P[POS_EST_KF_STATE_COUNT][POS_EST_KF_STATE_COUNT];
+    float accBias;              // Accelerometer bias in earth frame (cm/s/s)
+} posEstimatorKFAxis_t;
+
+typedef struct {
+    posEstimatorKFAxis_t axis[XYZ_AXIS_COUNT];
+} posEstimatorKF_t;
+
+void posEstimatorKFAxisReset(posEstimatorKFAxis_t * kf, float posVar, float velVar, float accBiasVar);
+void posEstimatorKFAxisPredict(posEstimatorKFAxis_t * kf, float dt, float accNoise, float accBiasNoise, float maxPosVar);
+void posEstimatorKFAxisCorrect(posEstimatorKFAxis_t * kf, posEstimatorKFState_e state, float innovation, float variance, float corr[POS_EST_KF_STATE_COUNT]);
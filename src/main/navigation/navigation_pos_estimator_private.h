@@ -25,6 +25,9 @@
 #include "common/filter.h"
 #include "common/calibration.h"
 
+#include "navigation/navigation_pos_estimator_history.h"
+#include "navigation/navigation_pos_estimator_kf.h"
+
 #include "sensors/sensors.h"
 
 #define INAV_GPS_DEFAULT_EPH                200.0f  // 2m GPS HDOP  (gives about 1.6s of dead-reckoning if GPS is temporary lost)
@@ -44,6 +47,12 @@
 #define INAV_BARO_TIMEOUT_MS                200     // Baro timeout
 #define INAV_SURFACE_TIMEOUT_MS             400     // Surface timeout    (missed 3 readings in a row)
 #define INAV_FLOW_TIMEOUT_MS                200
+#define INAV_EXTPOS_TIMEOUT_MS              200
+#define INAV_EXTPOS_DEFAULT_STD             10.0f   // Assumed external position accuracy (cm) when the source doesn't know it
+
+#define INAV_KF_GPS_VEL_STD                 50.0f   // Assumed GPS velocity accuracy (cm/s)
+#define INAV_KF_EXTPOS_VEL_STD              25.0f   // Assumed external velocity accuracy (cm/s)
+#define INAV_KF_ACC_BIAS_INITIAL_STD        50.0f   // Initial accelerometer bias uncertainty (cm/s/s)
 
 #define CALIBRATING_GRAVITY_TIME_MS         2000
 
@@ -65,6 +74,7 @@ typedef struct {
 
 typedef struct {
     timeUs_t    lastUpdateTime; // Last update time (us)
+    timeUs_t    measurementTime; // Time the fix was valid at (us)
 #if defined(NAV_GPS_GLITCH_DETECTION)
     bool        glitchDetected;
     bool        glitchRecovery;
@@ -108,6 +118,15 @@ typedef struct {
     float       bodyRate[2];
 } navPositionEstimatorFLOW_t;
 
+typedef struct {
+    timeUs_t    lastUpdateTime; // Last update time (us)
+    timeUs_t    measurementTime; // Time the pose was valid at (us)
+    bool        velValid;
+    fpVector3_t pos;            // External position in NEU coordinate system (cm)
+    fpVector3_t vel;            // External velocity (cms)
+    float       eph;            // Position standard deviation (cm)
+} navPositionEstimatorEXTPOS_t;
+
 typedef struct {
     timeUs_t    lastUpdateTime; // Last update time (us)
 
@@ -144,8 +163,16 @@ typedef enum {
     EST_FLOW_VALID              = (1 << 4),
     EST_XY_VALID                = (1 << 5),
     EST_Z_VALID                 = (1 << 6),
+    EST_EXTPOS_VALID            = (1 << 7),
 } navPositionEstimationFlags_e;
 
+typedef struct {
+    posEstimatorKF_t filter;
+    timeUs_t    gpsFusedTime;       // lastUpdateTime of the last fused measurement, each one is fused once
+    timeUs_t    baroFusedTime;
+    timeUs_t    extPosFusedTime;
+} navPositionEstimatorKALMAN_t;
+
 typedef struct {
     timeUs_t    baroGroundTimeout;
     float       baroGroundAlt;
@@ -162,6 +189,7 @@ typedef struct {
     navPositionEstimatorSURFACE_t surface;
     navPositionEstimatorPITOT_t pitot;
     navPositionEstimatorFLOW_t  flow;
+    navPositionEstimatorEXTPOS_t extPos;
 
     // IMU data
     navPosisitonEstimatorIMU_t  imu;
@@ -169,6 +197,12 @@ typedef struct {
     // Estimate
     navPositionEstimatorESTIMATE_t  est;
 
+    // Past estimates for fusing delayed measurements
+    posEstimatorHistory_t       history;
+
+    // Kalman filter covariance and accelerometer bias, used with NAV_ESTIMATOR_KALMAN
+    navPositionEstimatorKALMAN_t kalman;
+
     // Extra state variables
     navPositionEstimatorSTATE_t state;
 } navigationPosEstimator_t;
@@ -157,6 +157,7 @@ typedef struct {
 typedef struct fportBuffer_s {
     uint8_t data[sizeof(fportFrame_t)+1]; // +1 for CRC
     uint8_t length;
+    timeUs_t frameTimeUs; // Time the last byte of the frame was received
 } fportBuffer_t;
 
 typedef struct {
@@ -167,6 +168,7 @@ typedef struct {
 static volatile fportBuffer_t rxBuffer[NUM_RX_BUFFERS];
 static volatile uint8_t rxBufferWriteIndex = 0;
 static volatile uint8_t rxBufferReadIndex = 0;
+static timeUs_t rcFrameTimeUs = 0;
 
 static serialPort_t *fportPort;
 
@@ -282,7 +284,9 @@ static void fportDataReceive(uint16_t byte, void *callback_data)
 
         case FS_CONTROL_FRAME_DATA: {
             if (writeBuffer(byte) > controlFrameSize) {
+                rxBuffer[rxBufferWriteIndex].frameTimeUs = currentTimeUs;
                 nextWriteBuffer();
+                rxSignalFrameComplete();
                 state = FS_DOWNLINK_FRAME_START;
             }
             break;
@@ -377,6 +381,7 @@ static uint8_t frameStatus(rxRuntimeConfig_t *rxRuntimeConfig)
                             result = sbusChannelsDecode(rxRuntimeConfig, &frame->control.rc.channels);
                             lqTrackerSet(rxRuntimeConfig->lqTracker, scaleRange(frame->control.rc.rssi, 0, 100, 0, RSSI_MAX_VALUE));
                             frameReceivedTimestamp = currentTimeUs;
+                            rcFrameTimeUs = rxBuffer[rxBufferReadIndex].frameTimeUs;
 #if defined(USE_TELEMETRY_SMARTPORT)
                             otaMode = false;
 #endif
@@ -650,6 +655,11 @@ static bool processFrame(const rxRuntimeConfig_t *rxRuntimeConfig)
     return true;
 }
 
+static timeUs_t frameTimeUs(const rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    UNUSED(rxRuntimeConfig);
+    return rcFrameTimeUs;
+}
 
 bool fport2RxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig)
 {
@@ -662,6 +672,7 @@ bool fport2RxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig
 
     rxRuntimeConfig->rcFrameStatusFn = frameStatus;
     rxRuntimeConfig->rcProcessFrameFn = processFrame;
+    rxRuntimeConfig->rcFrameTimeUsFn = frameTimeUs;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
@@ -118,6 +118,11 @@ void ghstRxWriteTelemetryData(const void *data, int len)
     telemetryBufLen = len;
 }
 
+bool ghstRxIsTelemetryBufEmpty(void)
+{
+    return telemetryBufLen == 0;
+}
+
 void ghstRxSendTelemetryData(void)
 {
     // if there is telemetry data to write
@@ -130,11 +135,8 @@ void ghstRxSendTelemetryData(void)
 STATIC_UNIT_TESTED uint8_t ghstFrameCRC(ghstFrame_t *pGhstFrame)
 {
     // CRC includes type and payload
-    uint8_t crc = crc8_dvb_s2(0, pGhstFrame->frame.type);
-    for (int i = 0; i < pGhstFrame->frame.len - GHST_FRAME_LENGTH_TYPE_CRC - 1; ++i) {
-        crc = crc8_dvb_s2(crc, pGhstFrame->frame.payload[i]);
-    }
-    return crc;
+    const uint8_t crc = crc8_dvb_s2(0, pGhstFrame->frame.type);
+    return crc8_dvb_s2_update(crc, pGhstFrame->frame.payload, pGhstFrame->frame.len - GHST_FRAME_LENGTH_TYPE_CRC - 1);
 }
 
 // Receive ISR callback, called back from serial port
@@ -171,6 +173,7 @@ STATIC_UNIT_TESTED void ghstDataReceive(uint16_t c, void *data)
 
             // remember what time the incoming (Rx) packet ended, so that we can ensure a quite bus before sending telemetry
             ghstRxFrameEndAtUs = microsISR();
+            rxSignalFrameComplete();
         }
     }
 }
@@ -324,6 +327,12 @@ static bool ghstProcessFrame(const rxRuntimeConfig_t *rxRuntimeConfig)
     return true;
 }
 
+static timeUs_t ghstFrameTimeUs(const rxRuntimeConfig_t *rxRuntimeState)
+{
+    UNUSED(rxRuntimeState);
+    return ghstRxFrameEndAtUs;
+}
+
 STATIC_UNIT_TESTED uint16_t ghstReadRawRC(const rxRuntimeConfig_t *rxRuntimeState, uint8_t chan)
 {
     UNUSED(rxRuntimeState);
@@ -352,6 +361,7 @@ bool ghstRxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeState)
     rxRuntimeState->rcReadRawFn = ghstReadRawRC;
     rxRuntimeState->rcFrameStatusFn = ghstFrameStatus;
     rxRuntimeState->rcProcessFrameFn = ghstProcessFrame;
+    rxRuntimeState->rcFrameTimeUsFn = ghstFrameTimeUs;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
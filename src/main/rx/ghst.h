@@ -26,6 +26,7 @@
 
 void ghstRxWriteTelemetryData(const void *data, int len);
 void ghstRxSendTelemetryData(void);
+bool ghstRxIsTelemetryBufEmpty(void);
 
 struct rxConfig_s;
 struct rxRuntimeState_s;
@@ -27,6 +27,7 @@
 #include "build/debug.h"
 
 #include "common/maths.h"
+#include "common/median_filter.h"
 #include "common/utils.h"
 
 #include "programming/logic_condition.h"
@@ -51,6 +52,8 @@
 
 #include "io/serial.h"
 
+#include "scheduler/scheduler.h"
+
 #include "rx/rx.h"
 #include "rx/crsf.h"
 #include "rx/eleres.h"
@@ -101,6 +104,14 @@ static timeUs_t needRxSignalBefore = 0;
 static timeUs_t suspendRxSignalUntil = 0;
 static uint8_t skipRxSamples = 0;
 
+#define RX_FRAME_DELTA_MAX_US   100000      // Longer gaps are signal drop-outs, not the frame rate
+
+static timeUs_t rxPendingFrameTimeUs = 0;   // Completion time of the last received frame
+static timeUs_t rxFrameTimeUs = 0;          // Completion time of the frame held in rcChannels
+static timeDelta_t rxFrameDeltaUs = 0;
+static timeDelta_t rxFrameLatencyUs = 0;
+static bool rxFrameLatencyPending = false;
+
 static rcChannel_t rcChannels[MAX_SUPPORTED_RC_CHANNEL_COUNT];
 
 #define SKIP_RC_ON_SUSPEND_PERIOD 1500000           // 1.5 second period in usec (call frequency independent)
@@ -108,9 +119,9 @@ static rcChannel_t rcChannels[MAX_SUPPORTED_RC_CHANNEL_COUNT];
 
 rxLinkStatistics_t rxLinkStatistics;
 rxRuntimeConfig_t rxRuntimeConfig;
-static uint8_t rcSampleIndex = 0;
+static medianFilter_t rcMedianFilter[MAX_SUPPORTED_RC_CHANNEL_COUNT];
 
-PG_REGISTER_WITH_RESET_TEMPLATE(rxConfig_t, rxConfig, PG_RX_CONFIG, 9);
+PG_REGISTER_WITH_RESET_TEMPLATE(rxConfig_t, rxConfig, PG_RX_CONFIG, 10);
 
 #ifndef RX_SPI_DEFAULT_PROTOCOL
 #define RX_SPI_DEFAULT_PROTOCOL 0
@@ -145,6 +156,8 @@ PG_RESET_TEMPLATE(rxConfig_t, rxConfig,
     .rssiMax = SETTING_RSSI_MAX_DEFAULT,
     .sbusSyncInterval = SETTING_SBUS_SYNC_INTERVAL_DEFAULT,
     .rcFilterFrequency = SETTING_RC_FILTER_FREQUENCY_DEFAULT,
+    .rcMedianFilterSticks = SETTING_RC_MEDIAN_FILTER_STICKS_DEFAULT,
+    .rcMedianFilterAux = SETTING_RC_MEDIAN_FILTER_AUX_DEFAULT,
 #if defined(USE_RX_MSP) && defined(USE_MSP_RC_OVERRIDE)
     .mspOverrideChannels = SETTING_MSP_OVERRIDE_CHANNELS_DEFAULT,
 #endif
@@ -284,9 +297,13 @@ void rxInit(void)
     rxRuntimeConfig.lqTracker = &rxLQTracker;
     rxRuntimeConfig.rcReadRawFn = nullReadRawRC;
     rxRuntimeConfig.rcFrameStatusFn = nullFrameStatus;
+    rxRuntimeConfig.rcFrameTimeUsFn = NULL;
     rxRuntimeConfig.rxSignalTimeout = DELAY_10_HZ;
     rxRuntimeConfig.requireFiltering = false;
-    rcSampleIndex = 0;
+
+    for (int i = 0; i < MAX_SUPPORTED_RC_CHANNEL_COUNT; i++) {
+        medianFilterInit(&rcMedianFilter[i], i < NON_AUX_CHANNEL_COUNT ? rxConfig()->rcMedianFilterSticks : rxConfig()->rcMedianFilterAux);
+    }
 
     timeMs_t nowMs = millis();
 
@@ -451,6 +468,14 @@ bool rxUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
         rxSignalReceived = (frameStatus & RX_FRAME_FAILSAFE) == 0;
         needRxSignalBefore = currentTimeUs + rxRuntimeConfig.rxSignalTimeout;
         rxDataProcessingRequired = true;
+
+        // Prefer the time the driver saw the last byte of the frame over the time we got to it
+        const timeUs_t frameTimeUs = rxRuntimeConfig.rcFrameTimeUsFn ? rxRuntimeConfig.rcFrameTimeUsFn(&rxRuntimeConfig) : currentTimeUs;
+        const timeDelta_t frameDeltaUs = cmpTimeUs(frameTimeUs, rxPendingFrameTimeUs);
+        if (frameDeltaUs > 0 && frameDeltaUs < RX_FRAME_DELTA_MAX_US) {
+            rxFrameDeltaUs = frameDeltaUs;
+        }
+        rxPendingFrameTimeUs = frameTimeUs;
     }
     else if ((frameStatus & RX_FRAME_FAILSAFE) && rxSignalReceived) {
         // All other receiver statuses are allowed to report failsafe, but not allowed to leave it
@@ -477,23 +502,8 @@ bool rxUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTime)
     return result;
 }
 
-#define FILTERING_SAMPLE_COUNT  5
 static uint16_t applyChannelFiltering(uint8_t chan, uint16_t sample)
 {
-    static int16_t rcSamples[MAX_SUPPORTED_RC_CHANNEL_COUNT][FILTERING_SAMPLE_COUNT];
-    static bool rxSamplesCollected = false;
-
-    // Update the recent samples
-    rcSamples[chan][rcSampleIndex % FILTERING_SAMPLE_COUNT] = sample;
-
-    // Until we have enough data - return unfiltered samples
-    if (!rxSamplesCollected) {
-        if (rcSampleIndex < FILTERING_SAMPLE_COUNT) {
-            return sample;
-        }
-        rxSamplesCollected = true;
-    }
-
     // Assuming a step transition from 1000 -> 2000 different filters will yield the following output:
     //  No filter:              1000, 2000, 2000, 2000, 2000        - 0 samples delay
     //  3-point moving average: 1000, 1333, 1667, 2000, 2000        - 2 samples delay
@@ -506,8 +516,9 @@ static uint16_t applyChannelFiltering(uint8_t chan, uint16_t sample)
     //  3-point median:         1000, 1000, 1000, 2000, 1000, 1000, 1000    - high density noise is not removed
     //  5-point median:         1000, 1000, 1000, 1000, 1000, 1000, 1000    - only 3 out of 5 outlier noise will get through
 
-    // Apply 5-point median filtering. This filter has the same delay as 3-point moving average, but better noise rejection
-    return quickMedianFilter5_16(rcSamples[chan]);
+    // Default is 5-point median filtering. This filter has the same delay as 3-point moving average, but better noise rejection.
+    // Until the window is full samples are returned unfiltered.
+    return medianFilterApply(&rcMedianFilter[chan], sample);
 }
 
 bool calculateRxChannelsAndUpdateFailsafe(timeUs_t currentTimeUs)
@@ -585,6 +596,13 @@ bool calculateRxChannelsAndUpdateFailsafe(timeUs_t currentTimeUs)
                 rcChannels[channel].data = rcStaging[channel];
             }
         }
+
+        if (rxFrameTimeUs != rxPendingFrameTimeUs) {
+            rxFrameTimeUs = rxPendingFrameTimeUs;
+            rxFrameLatencyPending = true;
+            DEBUG_SET(DEBUG_RX_LATENCY, 0, cmpTimeUs(micros(), rxFrameTimeUs));
+            DEBUG_SET(DEBUG_RX_LATENCY, 1, rxFrameDeltaUs);
+        }
     }
 
 #if defined(USE_RX_MSP) && defined(USE_MSP_RC_OVERRIDE)
@@ -600,7 +618,6 @@ bool calculateRxChannelsAndUpdateFailsafe(timeUs_t currentTimeUs)
         failsafeOnValidDataFailed();
     }
 
-    rcSampleIndex++;
     return true;
 }
 
@@ -728,6 +745,36 @@ uint16_t rxGetRefreshRate(void)
     return rxRuntimeConfig.rxRefreshRate;
 }
 
+timeUs_t rxGetFrameTimeUs(void)
+{
+    return rxFrameTimeUs;
+}
+
+timeDelta_t rxGetFrameDeltaUs(void)
+{
+    return rxFrameDeltaUs;
+}
+
+timeDelta_t rxGetFrameLatencyUs(void)
+{
+    return rxFrameLatencyUs;
+}
+
+void rxUpdateFrameLatency(timeUs_t outputTimeUs)
+{
+    // Only the first output update after a new frame measures its latency
+    if (rxFrameLatencyPending) {
+        rxFrameLatencyPending = false;
+        rxFrameLatencyUs = cmpTimeUs(outputTimeUs, rxFrameTimeUs);
+        DEBUG_SET(DEBUG_RX_LATENCY, 2, rxFrameLatencyUs);
+    }
+}
+
+void rxSignalFrameComplete(void)
+{
+    schedulerSignalTask(TASK_RX);
+}
+
 int16_t rxGetChannelValue(unsigned channelNumber)
 {
     if (LOGIC_CONDITION_GLOBAL_FLAG(LOGIC_CONDITION_GLOBAL_FLAG_OVERRIDE_RC_CHANNEL)) {
@@ -133,6 +133,8 @@ typedef struct rxConfig_s {
     uint16_t rx_min_usec;
     uint16_t rx_max_usec;
     uint8_t rcFilterFrequency;              // RC filter cutoff frequency (smoothness vs response sharpness)
+    uint8_t rcMedianFilterSticks;           // Median filter window for the stick channels of receivers that need filtering
+    uint8_t rcMedianFilterAux;              // Median filter window for the AUX channels
     uint16_t mspOverrideChannels;           // Channels to override with MSP RC when BOXMSPRCOVERRIDE is active
     uint8_t rssi_source;
 #ifdef USE_SERIALRX_SRXL2
@@ -149,6 +151,7 @@ typedef struct rxRuntimeConfig_s rxRuntimeConfig_t;
 typedef uint16_t (*rcReadRawDataFnPtr)(const rxRuntimeConfig_t *rxRuntimeConfig, uint8_t chan); // used by receiver driver to return channel data
 typedef uint8_t (*rcFrameStatusFnPtr)(rxRuntimeConfig_t *rxRuntimeConfig);
 typedef bool (*rcProcessFrameFnPtr)(const rxRuntimeConfig_t *rxRuntimeConfig);
+typedef timeUs_t (*rcFrameTimeUsFnPtr)(const rxRuntimeConfig_t *rxRuntimeConfig); // time the last byte of the latest frame was received
 typedef uint16_t (*rcGetLinkQualityPtr)(const rxRuntimeConfig_t *rxRuntimeConfig);
 
 typedef struct rxLinkQualityTracker_s {
@@ -166,6 +169,7 @@ typedef struct rxRuntimeConfig_s {
     rcReadRawDataFnPtr rcReadRawFn;
     rcFrameStatusFnPtr rcFrameStatusFn;
     rcProcessFrameFnPtr rcProcessFrameFn;
+    rcFrameTimeUsFnPtr rcFrameTimeUsFn;     // Optional, frames are timestamped when the RX task picks them up otherwise
     rxLinkQualityTracker_e * lqTracker;     // Pointer to a
     uint16_t *channelData;
     void *frameData;
@@ -226,6 +230,16 @@ void resumeRxSignal(void);
 
 uint16_t rxGetRefreshRate(void);
 
+// Completion time of the frame the current channel values came from
+timeUs_t rxGetFrameTimeUs(void);
+// Measured interval between the last two received frames, 0 if unknown
+timeDelta_t rxGetFrameDeltaUs(void);
+// Time from the completion of the last processed frame until the motor outputs were updated with it
+timeDelta_t rxGetFrameLatencyUs(void);
+void rxUpdateFrameLatency(timeUs_t outputTimeUs);
+// Called by serial RX drivers from ISR when a frame is ready to be decoded
+void rxSignalFrameComplete(void);
+
 // Processed RC channel value. These values might include
 // filtering and some extra processing like value holding
 // during failsafe. 
@@ -95,6 +95,7 @@ static uint32_t fullTimeoutTimestamp = 0;
 static uint32_t lastValidPacketTimestamp = 0;
 static volatile uint32_t lastReceiveTimestamp = 0;
 static volatile uint32_t lastIdleTimestamp = 0;
+static timeUs_t processBufferTimestamp = 0;
 
 struct rxBuf readBuffer[2];
 struct rxBuf* readBufferPtr = &readBuffer[0];
@@ -321,6 +322,7 @@ static void srxl2Idle(void)
             readBufferPtr = &readBuffer[1];
         }
         processBufferPtr->len = readBufferIdx;
+        processBufferTimestamp = lastReceiveTimestamp;
     }
 
     readBufferIdx = 0;
@@ -458,6 +460,12 @@ static bool srxl2ProcessFrame(const rxRuntimeConfig_t *rxRuntimeConfig)
     return true;
 }
 
+static timeUs_t srxl2FrameTimeUs(const rxRuntimeConfig_t *rxRuntimeConfig)
+{
+    UNUSED(rxRuntimeConfig);
+    return processBufferTimestamp;
+}
+
 static uint16_t srxl2ReadRawRC(const rxRuntimeConfig_t *rxRuntimeConfig, uint8_t channelIdx)
 {
     if (channelIdx >= rxRuntimeConfig->channelCount) {
@@ -495,6 +503,7 @@ bool srxl2RxInit(const rxConfig_t *rxConfig, rxRuntimeConfig_t *rxRuntimeConfig)
     rxRuntimeConfig->rcReadRawFn = srxl2ReadRawRC;
     rxRuntimeConfig->rcFrameStatusFn = srxl2FrameStatus;
     rxRuntimeConfig->rcProcessFrameFn = srxl2ProcessFrame;
+    rxRuntimeConfig->rcFrameTimeUsFn = srxl2FrameTimeUs;
 
     const serialPortConfig_t *portConfig = findSerialPortConfig(FUNCTION_RX_SERIAL);
     if (!portConfig) {
@@ -23,6 +23,7 @@
 
 #ifdef USE_SERIALRX_XBUS
 
+#include "common/crc.h"
 #include "common/utils.h"
 
 #include "drivers/serial.h"
@@ -49,8 +50,6 @@
 #define XBUS_RJ01_MESSAGE_LENGTH 30
 #define XBUS_RJ01_OFFSET_BYTES 3
 
-#define XBUS_CRC_AND_VALUE 0x8000
-#define XBUS_CRC_POLY 0x1021
 
 #define XBUS_BAUDRATE 115200
 #define XBUS_RJ01_BAUDRATE 250000
@@ -86,23 +85,6 @@ static uint8_t xBusProvider;
 static volatile uint8_t xBusFrame[XBUS_RJ01_FRAME_SIZE];
 static uint16_t xBusChannelData[XBUS_RJ01_CHANNEL_COUNT];
 
-// The xbus mode B CRC calculations
-static uint16_t xBusCRC16(uint16_t crc, uint8_t value)
-{
-    uint8_t i;
-
-    crc = crc ^ (int16_t)value << 8;
-
-    for (i = 0; i < 8; i++) {
-        if (crc & XBUS_CRC_AND_VALUE) {
-            crc = crc << 1 ^ XBUS_CRC_POLY;
-        } else {
-            crc = crc << 1;
-        }
-    }
-    return crc;
-}
-
 // Full RJ01 message CRC calculations
 uint8_t xBusRj01CRC8(uint8_t inData, uint8_t seed)
 {
@@ -136,9 +118,9 @@ static void xBusUnpackModeBFrame(uint8_t offsetBytes)
     uint16_t value;
     uint8_t frameAddr;
 
-    // Calculate on all bytes except the final two CRC bytes
+    // Mode B CRC is CRC16-CCITT, calculated on all bytes except the final two CRC bytes
     for (i = 0; i < XBUS_FRAME_SIZE - 2; i++) {
-        inCrc = xBusCRC16(inCrc, xBusFrame[i+offsetBytes]);
+        inCrc = crc16_ccitt(inCrc, xBusFrame[i+offsetBytes]);
     }
 
     // Get the received CRC
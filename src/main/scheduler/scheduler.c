@@ -208,6 +208,19 @@ void schedulerResetTaskStatistics(cfTaskId_e taskId)
 #endif
 }
 
+/*
+ * Mark an event driven task as having work pending. Safe to call from ISR.
+ * When its checkFunc confirms, the task wins ties against other tasks of the
+ * same dynamic priority, so it runs in the next scheduler slot instead of
+ * waiting for time-driven tasks of equal priority.
+ */
+void schedulerSignalTask(cfTaskId_e taskId)
+{
+    if (taskId < TASK_COUNT) {
+        cfTasks[taskId].isSignaled = true;
+    }
+}
+
 void schedulerInit(void)
 {
     queueClear();
@@ -222,6 +235,7 @@ void FAST_CODE NOINLINE scheduler(void)
     // The task to be invoked
     cfTask_t *selectedTask = NULL;
     uint16_t selectedTaskDynamicPriority = 0;
+    bool selectedTaskSignaled = false;
     bool forcedRealTimeTask = false;
 
     // Update task dynamic priorities
@@ -269,9 +283,14 @@ void FAST_CODE NOINLINE scheduler(void)
             }
         }
 
-        if (!forcedRealTimeTask && task->dynamicPriority > selectedTaskDynamicPriority) {
-            selectedTaskDynamicPriority = task->dynamicPriority;
-            selectedTask = task;
+        if (!forcedRealTimeTask && task->dynamicPriority > 0) {
+            const bool isSignaled = task->checkFunc && task->isSignaled;
+            if (task->dynamicPriority > selectedTaskDynamicPriority ||
+                (task->dynamicPriority == selectedTaskDynamicPriority && isSignaled && !selectedTaskSignaled)) {
+                selectedTaskDynamicPriority = task->dynamicPriority;
+                selectedTask = task;
+                selectedTaskSignaled = isSignaled;
+            }
         }
     }
 
@@ -285,6 +304,7 @@ void FAST_CODE NOINLINE scheduler(void)
         selectedTask->taskLatestDeltaTime = (timeDelta_t)(currentTimeUs - selectedTask->lastExecutedAt);
         selectedTask->lastExecutedAt = currentTimeUs;
         selectedTask->dynamicPriority = 0;
+        selectedTask->isSignaled = false;
 
         // Execute task
         const timeUs_t currentTimeBeforeTaskCall = micros();
@@ -145,6 +145,7 @@ typedef struct {
     uint16_t taskAgeCycles;
     timeUs_t lastExecutedAt;        // last time of invocation
     timeUs_t lastSignaledAt;        // time of invocation event for event-driven tasks
+    volatile bool isSignaled;       // set from ISR by schedulerSignalTask(), cleared when the task runs
     timeDelta_t taskLatestDeltaTime;
 
     /* Statistics */
@@ -164,6 +165,7 @@ void rescheduleTask(cfTaskId_e taskId, timeDelta_t newPeriodUs);
 void setTaskEnabled(cfTaskId_e taskId, bool newEnabledState);
 timeDelta_t getTaskDeltaTime(cfTaskId_e taskId);
 void schedulerResetTaskStatistics(cfTaskId_e taskId);
+void schedulerSignalTask(cfTaskId_e taskId);
 
 void schedulerInit(void);
 void scheduler(void);
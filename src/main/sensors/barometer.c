@@ -70,6 +70,7 @@ PG_RESET_TEMPLATE(barometerConfig_t, barometerConfig,
 static zeroCalibrationScalar_t zeroCalibration;
 static float baroGroundAltitude = 0;
 static float baroGroundPressure = 101325.0f; // 101325 pascal, 1 standard atmosphere
+static bool baroHasReading = false;        // baroPressure holds a real sample
 
 bool baroDetect(baroDev_t *dev, baroSensor_e baroHardwareToUse)
 {
@@ -302,18 +303,22 @@ uint32_t baroUpdate(void)
         break;
 
         case BAROMETER_NEEDS_CALCULATION:
-            if (baro.dev.get_up) {
-                baro.dev.get_up(&baro.dev);
-            }
+        {
+            // Keep the previous pressure if there is no new reading (e.g. a deferred read still in flight)
+            const bool newReading = baro.dev.get_up ? baro.dev.get_up(&baro.dev) : true;
             if (baro.dev.start_ut) {
                 baro.dev.start_ut(&baro.dev);
             }
-            baro.dev.calculate(&baro.dev, &baro.baroPressure, &baro.baroTemperature);
-            if (barometerConfig()->use_median_filtering) {
-                baro.baroPressure = applyBarometerMedianFilter(baro.baroPressure);
+            if (newReading) {
+                baro.dev.calculate(&baro.dev, &baro.baroPressure, &baro.baroTemperature);
+                if (barometerConfig()->use_median_filtering) {
+                    baro.baroPressure = applyBarometerMedianFilter(baro.baroPressure);
+                }
+                baroHasReading = true;
             }
             state = BAROMETER_NEEDS_SAMPLES;
             return baro.dev.ut_delay;
+        }
         break;
     }
 }
@@ -342,6 +347,11 @@ void baroStartCalibration(void)
 int32_t baroCalculateAltitude(void)
 {
     if (!baroIsCalibrationComplete()) {
+        if (!baroHasReading) {
+            baro.BaroAlt = 0;
+            return baro.BaroAlt;
+        }
+
         zeroCalibrationAddValueS(&zeroCalibration, baro.baroPressure);
 
         if (zeroCalibrationIsCompleteS(&zeroCalibration)) {
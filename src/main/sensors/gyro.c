@@ -363,6 +363,11 @@ bool gyroInit(void)
     // initFn will initialize sampleRateIntervalUs to actual gyro sampling rate (if driver supports it). Calculate target looptime using that value
     gyro.targetLooptime = gyroDev[0].sampleRateIntervalUs;
 
+    // Keep the other devices on the gyro's bus from delaying its reads
+    if (gyroDev[0].busDev) {
+        busSetPriority(gyroDev[0].busDev, BUS_PRIORITY_HIGH, gyro.targetLooptime);
+    }
+
     // At this poinrt gyroDev[0].gyroAlign was set up by the driver from the busDev record
     // If configuration says different - override
     if (gyroConfig()->gyro_align != ALIGN_DEFAULT) {
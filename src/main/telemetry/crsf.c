@@ -64,7 +64,9 @@ FILE_COMPILE_FOR_SPEED
 #include "telemetry/msp_shared.h"
 
 
-#define CRSF_CYCLETIME_US                   100000  // 100ms, 10 Hz
+#define CRSF_RC_FRAMES_PER_TELEMETRY_SLOT   4
+#define CRSF_TELEMETRY_SLOT_RATE_MIN        10      // Hz, the rate of the old fixed telemetry cycle
+#define CRSF_TELEMETRY_SLOT_RATE_MAX        50      // Hz
 #define CRSF_DEVICEINFO_VERSION             0x01
 // According to TBS: "CRSF over serial should always use a sync byte at the beginning of each frame.
 // To get better performance it's recommended to use the sync byte 0xC8 to get better performance"
@@ -305,14 +307,8 @@ static void crsfFrameAttitude(sbuf_t *dst)
 Payload:
 char[]      Flight mode ( Null­terminated string )
 */
-static void crsfFrameFlightMode(sbuf_t *dst)
+static const char *crsfFlightModeString(void)
 {
-    // just do "OK" for the moment as a placeholder
-    // write zero for frame length, since we don't know it yet
-    uint8_t *lengthPtr = sbufPtr(dst);
-    sbufWriteU8(dst, 0);
-    crsfSerialize8(dst, CRSF_FRAMETYPE_FLIGHT_MODE);
-
     // use same logic as OSD, so telemetry displays same flight text as OSD when armed
     const char *flightMode = "OK";
     if (ARMING_FLAG(ARMED)) {
@@ -352,6 +348,17 @@ static void crsfFrameFlightMode(sbuf_t *dst)
         flightMode = "!ERR";
     }
 
+    return flightMode;
+}
+
+static void crsfFrameFlightMode(sbuf_t *dst)
+{
+    // write zero for frame length, since we don't know it yet
+    uint8_t *lengthPtr = sbufPtr(dst);
+    sbufWriteU8(dst, 0);
+    crsfSerialize8(dst, CRSF_FRAMETYPE_FLIGHT_MODE);
+
+    const char *flightMode = crsfFlightModeString();
     crsfSerializeData(dst, (const uint8_t*)flightMode, strlen(flightMode));
     crsfSerialize8(dst, 0); // zero terminator for string
     // write in the length
@@ -390,21 +397,80 @@ static void crsfFrameDeviceInfo(sbuf_t *dst)
     *lengthPtr = sbufPtr(dst) - lengthPtr;
 }
 
-#define BV(x)  (1 << (x)) // bit value
+/*
+ * Values watched by the telemetry scheduler, a frame is sent early when any of
+ * them changes by at least the frame's change threshold
+ */
+static uint8_t crsfAttitudeValues(int32_t *values)
+{
+    values[0] = attitude.values.roll;
+    values[1] = attitude.values.pitch;
+    values[2] = attitude.values.yaw;
+    return 3;
+}
+
+static uint8_t crsfBatterySensorValues(int32_t *values)
+{
+    values[0] = getBatteryVoltage();
+    values[1] = getAmperage();
+    values[2] = getMAhDrawn();
+    return 3;
+}
+
+static uint8_t crsfFlightModeValues(int32_t *values)
+{
+    // flight mode strings are at most 4 characters, pack them into one value
+    const char *flightMode = crsfFlightModeString();
+    int32_t packed = 0;
+    for (int ii = 0; ii < 4 && flightMode[ii]; ii++) {
+        packed = (packed << 8) | flightMode[ii];
+    }
+    values[0] = packed;
+    return 1;
+}
+
+#ifdef USE_GPS
+static uint8_t crsfGpsValues(int32_t *values)
+{
+    values[0] = gpsSol.llh.lat;
+    values[1] = gpsSol.llh.lon;
+    values[2] = getEstimatedActualPosition(Z) / 100;
+    values[3] = gpsSol.groundSpeed;
+    return 4;
+}
+#endif
+
+#if defined(USE_BARO) || defined(USE_GPS)
+static uint8_t crsfVarioSensorValues(int32_t *values)
+{
+    values[0] = lrintf(getEstimatedActualVelocity(Z));
+    return 1;
+}
+#endif
 
-// schedule array to decide how often each type of frame is sent
 typedef enum {
-    CRSF_FRAME_START_INDEX = 0,
-    CRSF_FRAME_ATTITUDE_INDEX = CRSF_FRAME_START_INDEX,
+    CRSF_FRAME_ATTITUDE_INDEX = 0,
     CRSF_FRAME_BATTERY_SENSOR_INDEX,
     CRSF_FRAME_FLIGHT_MODE_INDEX,
     CRSF_FRAME_GPS_INDEX,
     CRSF_FRAME_VARIO_SENSOR_INDEX,
-    CRSF_SCHEDULE_COUNT_MAX
+    CRSF_FRAME_COUNT
 } crsfFrameTypeIndex_e;
 
-static uint8_t crsfScheduleCount;
-static uint8_t crsfSchedule[CRSF_SCHEDULE_COUNT_MAX];
+// Changes are sent as soon as the link allows, unchanged frames are repeated every maxIntervalMs
+static telemetryFrame_t crsfFrames[CRSF_FRAME_COUNT] = {
+    [CRSF_FRAME_ATTITUDE_INDEX]         = { .priority = 4, .minIntervalMs = 40,  .maxIntervalMs = 500,  .changeThreshold = 5,  .valuesFn = crsfAttitudeValues },      // 0.5 deg
+    [CRSF_FRAME_BATTERY_SENSOR_INDEX]   = { .priority = 1, .minIntervalMs = 200, .maxIntervalMs = 1000, .changeThreshold = 10, .valuesFn = crsfBatterySensorValues }, // 0.1V, 0.1A, 10mAh
+    [CRSF_FRAME_FLIGHT_MODE_INDEX]      = { .priority = 2, .minIntervalMs = 100, .maxIntervalMs = 1000, .changeThreshold = 1,  .valuesFn = crsfFlightModeValues },
+#ifdef USE_GPS
+    [CRSF_FRAME_GPS_INDEX]              = { .priority = 3, .minIntervalMs = 80,  .maxIntervalMs = 1000, .changeThreshold = 10, .valuesFn = crsfGpsValues },           // ~1m, 10cm/s
+#endif
+#if defined(USE_BARO) || defined(USE_GPS)
+    [CRSF_FRAME_VARIO_SENSOR_INDEX]     = { .priority = 2, .minIntervalMs = 100, .maxIntervalMs = 1000, .changeThreshold = 10, .valuesFn = crsfVarioSensorValues },   // 10cm/s
+#endif
+};
+
+static telemetryScheduler_t crsfScheduler;
 
 #if defined(USE_MSP_OVER_TELEMETRY)
 
@@ -430,44 +496,47 @@ void crsfSendMspResponse(uint8_t *payload)
 }
 #endif
 
-static void processCrsf(void)
+static void processCrsf(timeUs_t currentTimeUs)
 {
-    static uint8_t crsfScheduleIndex = 0;
-    const uint8_t currentSchedule = crsfSchedule[crsfScheduleIndex];
+    // The receiver keeps the newest frame of each type for the downlink, so the
+    // slot rate follows the RC frame rate rather than a fixed cycle time
+    const timeDelta_t rxFrameDeltaUs = rxGetFrameDeltaUs();
+    const uint16_t slotRate = rxFrameDeltaUs > 0 ? 1000000 / (rxFrameDeltaUs * CRSF_RC_FRAMES_PER_TELEMETRY_SLOT) : 0;
+    telemetrySchedulerSetSlotRate(&crsfScheduler, constrain(slotRate, CRSF_TELEMETRY_SLOT_RATE_MIN, CRSF_TELEMETRY_SLOT_RATE_MAX));
+
+    const int frameIndex = telemetrySchedulerNextFrame(&crsfScheduler, currentTimeUs);
+    if (frameIndex < 0) {
+        return;
+    }
 
     sbuf_t crsfPayloadBuf;
     sbuf_t *dst = &crsfPayloadBuf;
 
-    if (currentSchedule & BV(CRSF_FRAME_ATTITUDE_INDEX)) {
-        crsfInitializeFrame(dst);
+    crsfInitializeFrame(dst);
+    switch (frameIndex) {
+    case CRSF_FRAME_ATTITUDE_INDEX:
         crsfFrameAttitude(dst);
-        crsfFinalize(dst);
-    }
-    if (currentSchedule & BV(CRSF_FRAME_BATTERY_SENSOR_INDEX)) {
-        crsfInitializeFrame(dst);
+        break;
+    case CRSF_FRAME_BATTERY_SENSOR_INDEX:
         crsfFrameBatterySensor(dst);
-        crsfFinalize(dst);
-    }
-    if (currentSchedule & BV(CRSF_FRAME_FLIGHT_MODE_INDEX)) {
-        crsfInitializeFrame(dst);
+        break;
+    case CRSF_FRAME_FLIGHT_MODE_INDEX:
         crsfFrameFlightMode(dst);
-        crsfFinalize(dst);
-    }
+        break;
 #ifdef USE_GPS
-    if (currentSchedule & BV(CRSF_FRAME_GPS_INDEX)) {
-        crsfInitializeFrame(dst);
+    case CRSF_FRAME_GPS_INDEX:
         crsfFrameGps(dst);
-        crsfFinalize(dst);
-    }
+        break;
 #endif
 #if defined(USE_BARO) || defined(USE_GPS)
-    if (currentSchedule & BV(CRSF_FRAME_VARIO_SENSOR_INDEX)) {
-        crsfInitializeFrame(dst);
+    case CRSF_FRAME_VARIO_SENSOR_INDEX:
         crsfFrameVarioSensor(dst);
-        crsfFinalize(dst);
-    }
+        break;
 #endif
-    crsfScheduleIndex = (crsfScheduleIndex + 1) % crsfScheduleCount;
+    default:
+        return;
+    }
+    crsfFinalize(dst);
 }
 
 void crsfScheduleDeviceInfoResponse(void)
@@ -486,21 +555,16 @@ void initCrsfTelemetry(void)
     mspReplyPending = false;
 #endif
 
-    int index = 0;
-    crsfSchedule[index++] = BV(CRSF_FRAME_ATTITUDE_INDEX);
-    crsfSchedule[index++] = BV(CRSF_FRAME_BATTERY_SENSOR_INDEX);
-    crsfSchedule[index++] = BV(CRSF_FRAME_FLIGHT_MODE_INDEX);
+    crsfFrames[CRSF_FRAME_ATTITUDE_INDEX].enabled = true;
+    crsfFrames[CRSF_FRAME_BATTERY_SENSOR_INDEX].enabled = true;
+    crsfFrames[CRSF_FRAME_FLIGHT_MODE_INDEX].enabled = true;
 #ifdef USE_GPS
-    if (feature(FEATURE_GPS)) {
-        crsfSchedule[index++] = BV(CRSF_FRAME_GPS_INDEX);
-    }
+    crsfFrames[CRSF_FRAME_GPS_INDEX].enabled = feature(FEATURE_GPS);
 #endif
 #if defined(USE_BARO) || defined(USE_GPS)
-    if (sensors(SENSOR_BARO) || (STATE(FIXED_WING_LEGACY) && feature(FEATURE_GPS))) {
-        crsfSchedule[index++] = BV(CRSF_FRAME_VARIO_SENSOR_INDEX);
-    }
+    crsfFrames[CRSF_FRAME_VARIO_SENSOR_INDEX].enabled = sensors(SENSOR_BARO) || (STATE(FIXED_WING_LEGACY) && feature(FEATURE_GPS));
 #endif
-    crsfScheduleCount = (uint8_t)index;
+    telemetrySchedulerInit(&crsfScheduler, crsfFrames, CRSF_FRAME_COUNT);
 }
 
 bool checkCrsfTelemetryState(void)
@@ -513,8 +577,6 @@ bool checkCrsfTelemetryState(void)
  */
 void handleCrsfTelemetry(timeUs_t currentTimeUs)
 {
-    static uint32_t crsfLastCycleTime;
-
     if (!crsfTelemetryEnabled) {
         return;
     }
@@ -523,11 +585,15 @@ void handleCrsfTelemetry(timeUs_t currentTimeUs)
     // in between the RX frames.
     crsfRxSendTelemetryData();
 
+    // A new frame would overwrite the one still waiting for its slot
+    if (!crsfRxIsTelemetryBufEmpty()) {
+        return;
+    }
+
     // Send ad-hoc response frames as soon as possible
 #if defined(USE_MSP_OVER_TELEMETRY)
     if (mspReplyPending) {
         mspReplyPending = handleCrsfMspFrameBuffer(CRSF_FRAME_TX_MSP_FRAME_SIZE, &crsfSendMspResponse);
-        crsfLastCycleTime = currentTimeUs; // reset telemetry timing due to ad-hoc request
         return;
     }
 #endif
@@ -539,16 +605,10 @@ void handleCrsfTelemetry(timeUs_t currentTimeUs)
         crsfFrameDeviceInfo(dst);
         crsfFinalize(dst);
         deviceInfoReplyPending = false;
-        crsfLastCycleTime = currentTimeUs; // reset telemetry timing due to ad-hoc request
         return;
     }
 
-    // Actual telemetry data only needs to be sent at a low frequency, ie 10Hz
-    // Spread out scheduled frames evenly so each frame is sent at the same frequency.
-    if (currentTimeUs >= crsfLastCycleTime + (CRSF_CYCLETIME_US / crsfScheduleCount)) {
-        crsfLastCycleTime = currentTimeUs;
-        processCrsf();
-    }
+    processCrsf(currentTimeUs);
 }
 
 int getCrsfFrame(uint8_t *frame, crsfFrameType_e frameType)
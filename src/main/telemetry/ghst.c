@@ -68,7 +68,9 @@
 
 #include "build/debug.h"
 
-#define GHST_CYCLETIME_US                   100000      // 10x/sec
+#define GHST_RC_FRAMES_PER_TELEMETRY_SLOT   4
+#define GHST_TELEMETRY_SLOT_RATE_MIN        10          // Hz, the rate of the old fixed telemetry cycle
+#define GHST_TELEMETRY_SLOT_RATE_MAX        50          // Hz
 #define GHST_FRAME_PACK_PAYLOAD_SIZE        10
 #define GHST_FRAME_GPS_PAYLOAD_SIZE         10
 #define GHST_FRAME_LENGTH_CRC               1
@@ -156,46 +158,83 @@ void ghstFrameGpsSecondaryTelemetry(sbuf_t *dst)
     sbufWriteU8(dst, gpsFlags);
 }
 
-// schedule array to decide how often each type of frame is sent
+static uint8_t ghstPackValues(int32_t *values)
+{
+    values[0] = getBatteryVoltage();
+    values[1] = getAmperage();
+    values[2] = getMAhDrawn();
+    return 3;
+}
+
+#ifdef USE_GPS
+static uint8_t ghstGpsPrimaryValues(int32_t *values)
+{
+    values[0] = gpsSol.llh.lat;
+    values[1] = gpsSol.llh.lon;
+    values[2] = getEstimatedActualPosition(Z) / 100;
+    return 3;
+}
+
+static uint8_t ghstGpsSecondaryValues(int32_t *values)
+{
+    values[0] = gpsSol.groundSpeed;
+    values[1] = gpsSol.groundCourse;
+    values[2] = GPS_distanceToHome;
+    values[3] = (gpsSol.numSat << 8) | (STATE(GPS_FIX) << 1) | STATE(GPS_FIX_HOME);
+    return 4;
+}
+#endif
+
 typedef enum {
-    GHST_FRAME_START_INDEX = 0,
-    GHST_FRAME_PACK_INDEX = GHST_FRAME_START_INDEX, // Battery (Pack) data
+    GHST_FRAME_PACK_INDEX = 0,                      // Battery (Pack) data
     GHST_FRAME_GPS_PRIMARY_INDEX,                   // GPS, primary values (Lat, Long, Alt)
     GHST_FRAME_GPS_SECONDARY_INDEX,                 // GPS, secondary values (Sat Count, HDOP, etc.)
-   GHST_SCHEDULE_COUNT_MAX
+    GHST_FRAME_COUNT
 } ghstFrameTypeIndex_e;
 
-static uint8_t ghstScheduleCount;
-static uint8_t ghstSchedule[GHST_SCHEDULE_COUNT_MAX];
+// Changes are sent as soon as the link allows, unchanged frames are repeated every maxIntervalMs
+static telemetryFrame_t ghstFrames[GHST_FRAME_COUNT] = {
+    [GHST_FRAME_PACK_INDEX]             = { .priority = 1, .minIntervalMs = 200, .maxIntervalMs = 1000, .changeThreshold = 10, .valuesFn = ghstPackValues },         // 0.1V, 0.1A, 10mAh
+#ifdef USE_GPS
+    [GHST_FRAME_GPS_PRIMARY_INDEX]      = { .priority = 3, .minIntervalMs = 80,  .maxIntervalMs = 1000, .changeThreshold = 10, .valuesFn = ghstGpsPrimaryValues },   // ~1m
+    [GHST_FRAME_GPS_SECONDARY_INDEX]    = { .priority = 2, .minIntervalMs = 200, .maxIntervalMs = 1000, .changeThreshold = 10, .valuesFn = ghstGpsSecondaryValues }, // 10cm/s, 1deg
+#endif
+};
+
+static telemetryScheduler_t ghstScheduler;
 
-static void processGhst(void)
+static void processGhst(timeUs_t currentTimeUs)
 {
-    static uint8_t ghstScheduleIndex = 0;
+    // Every RC frame opens a downlink window, the receiver keeps the newest frame of each type
+    const timeDelta_t rxFrameDeltaUs = rxGetFrameDeltaUs();
+    const uint16_t slotRate = rxFrameDeltaUs > 0 ? 1000000 / (rxFrameDeltaUs * GHST_RC_FRAMES_PER_TELEMETRY_SLOT) : 0;
+    telemetrySchedulerSetSlotRate(&ghstScheduler, constrain(slotRate, GHST_TELEMETRY_SLOT_RATE_MIN, GHST_TELEMETRY_SLOT_RATE_MAX));
 
-    const uint8_t currentSchedule = ghstSchedule[ghstScheduleIndex];
+    const int frameIndex = telemetrySchedulerNextFrame(&ghstScheduler, currentTimeUs);
+    if (frameIndex < 0) {
+        return;
+    }
 
     sbuf_t ghstPayloadBuf;
     sbuf_t *dst = &ghstPayloadBuf;
 
-    if (currentSchedule & BIT(GHST_FRAME_PACK_INDEX)) {
-        ghstInitializeFrame(dst);
+    ghstInitializeFrame(dst);
+    switch (frameIndex) {
+    case GHST_FRAME_PACK_INDEX:
         ghstFramePackTelemetry(dst);
-        ghstFinalize(dst);
-    } 
-
-    if (currentSchedule & BIT(GHST_FRAME_GPS_PRIMARY_INDEX)) {
-        ghstInitializeFrame(dst);
+        break;
+#ifdef USE_GPS
+    case GHST_FRAME_GPS_PRIMARY_INDEX:
         ghstFrameGpsPrimaryTelemetry(dst);
-        ghstFinalize(dst);
-    }
-
-   if (currentSchedule & BIT(GHST_FRAME_GPS_SECONDARY_INDEX)) {
-        ghstInitializeFrame(dst);
+        break;
+    case GHST_FRAME_GPS_SECONDARY_INDEX:
         ghstFrameGpsSecondaryTelemetry(dst);
-        ghstFinalize(dst);
+        break;
+#endif
+    default:
+        return;
     }
-
-    ghstScheduleIndex = (ghstScheduleIndex + 1) % ghstScheduleCount;
+    ghstFinalize(dst);
 }
 
 void initGhstTelemetry(void)
@@ -207,20 +246,13 @@ void initGhstTelemetry(void)
         return;
     }
 
-    int index = 0;
-    if (isBatteryVoltageConfigured() || isAmperageConfigured()) {
-        ghstSchedule[index++] = BIT(GHST_FRAME_PACK_INDEX);
-    }
-
+    ghstFrames[GHST_FRAME_PACK_INDEX].enabled = isBatteryVoltageConfigured() || isAmperageConfigured();
 #ifdef USE_GPS
-    if (feature(FEATURE_GPS)) {
-        ghstSchedule[index++] = BIT(GHST_FRAME_GPS_PRIMARY_INDEX);
-        ghstSchedule[index++] = BIT(GHST_FRAME_GPS_SECONDARY_INDEX);
-    }
+    ghstFrames[GHST_FRAME_GPS_PRIMARY_INDEX].enabled = feature(FEATURE_GPS);
+    ghstFrames[GHST_FRAME_GPS_SECONDARY_INDEX].enabled = feature(FEATURE_GPS);
 #endif
-
-    ghstScheduleCount = (uint8_t)index;
- }
+    telemetrySchedulerInit(&ghstScheduler, ghstFrames, GHST_FRAME_COUNT);
+}
 
 bool checkGhstTelemetryState(void)
 {
@@ -230,16 +262,13 @@ bool checkGhstTelemetryState(void)
 // Called periodically by the scheduler
  void handleGhstTelemetry(timeUs_t currentTimeUs)
 {
-    static timeUs_t ghstLastCycleTime;
-
     if (!ghstTelemetryEnabled) {
         return;
     }
 
-    // Ready to send telemetry?
-    if (currentTimeUs >= ghstLastCycleTime + (GHST_CYCLETIME_US / ghstScheduleCount)) {
-        ghstLastCycleTime = currentTimeUs;
-        processGhst();
+    // Ready to send telemetry? A new frame would overwrite the one still waiting for its slot
+    if (ghstRxIsTelemetryBufEmpty()) {
+        processGhst(currentTimeUs);
     }
 
     // telemetry is sent from the Rx driver, ghstProcessFrame
@@ -29,6 +29,27 @@
 
 #if defined(USE_TELEMETRY) && defined(USE_TELEMETRY_MAVLINK)
 
+// Use the mavlink_msg_*_send() functions, which pack the message payload on
+// the stack and write header, payload and checksum straight into the serial
+// port TX buffer, instead of going through a mavlink_message_t and a second
+// send buffer. This has to be set up before anything includes the library.
+#define MAVLINK_USE_CONVENIENCE_FUNCTIONS
+#define MAVLINK_START_UART_SEND(chan, length)       if (!mavlinkTxSpaceAvailable(length)) return
+#define MAVLINK_SEND_UART_BYTES(chan, buf, len)     mavlinkSendBytes(buf, len)
+
+#define MAVLINK_COMM_NUM_BUFFERS 1
+
+#include "mavlink_types.h"
+
+static mavlink_system_t mavlink_system; // system and component id of outgoing messages
+static bool mavlinkTxSpaceAvailable(uint16_t length);
+static void mavlinkSendBytes(const uint8_t *buf, uint16_t len);
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#include "common/mavlink.h"
+#pragma GCC diagnostic pop
+
 #include "build/build_config.h"
 #include "build/debug.h"
 
@@ -87,16 +108,14 @@
 
 #include "scheduler/scheduler.h"
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-function"
-#define MAVLINK_COMM_NUM_BUFFERS 1
-#include "common/mavlink.h"
-#pragma GCC diagnostic pop
-
 #define TELEMETRY_MAVLINK_PORT_MODE     MODE_RXTX
 #define TELEMETRY_MAVLINK_MAXRATE       50
 #define TELEMETRY_MAVLINK_DELAY         ((1000 * 1000) / TELEMETRY_MAVLINK_MAXRATE)
 
+#define MAVLINK_MISSION_REQUEST_WINDOW      4       // mission items requested ahead during upload
+#define MAVLINK_MISSION_REQUEST_TIMEOUT_US  1000000
+#define MAVLINK_MISSION_REQUEST_RETRIES     5
+
 /**
  * MAVLink requires angles to be in the range -Pi..Pi.
  * This converts angles from a range of 0..Pi to -Pi..Pi
@@ -176,13 +195,9 @@ static uint8_t mavRates[] = {
 
 static timeUs_t lastMavlinkMessage = 0;
 static uint8_t mavTicks[MAXSTREAMS];
-static mavlink_message_t mavSendMsg;
 static mavlink_message_t mavRecvMsg;
 static mavlink_status_t mavRecvStatus;
 
-static uint8_t mavSystemId = 1;
-static uint8_t mavComponentId = MAV_COMP_ID_SYSTEM_CONTROL;
-
 static APM_COPTER_MODE inavToArduCopterMap(flightModeForTelemetry_e flightMode)
 {
     switch (flightMode)
@@ -276,6 +291,8 @@ void initMAVLinkTelemetry(void)
 {
     portConfig = findSerialPortConfig(FUNCTION_TELEMETRY_MAVLINK);
     mavlinkPortSharing = determinePortSharing(portConfig, FUNCTION_TELEMETRY_MAVLINK);
+    mavlink_system.sysid = 1;
+    mavlink_system.compid = MAV_COMP_ID_SYSTEM_CONTROL;
 }
 
 void configureMAVLinkTelemetryPort(void)
@@ -299,6 +316,17 @@ void configureMAVLinkTelemetryPort(void)
     mavlinkTelemetryEnabled = true;
 }
 
+static void configureMAVLinkVersion(void)
+{
+    mavlink_status_t *chanState = mavlink_get_channel_status(MAVLINK_COMM_0);
+    if (telemetryConfig()->mavlink.version == 1) {
+        chanState->flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+    } else {
+        // MAVLink 2 frames have the trailing zero bytes of the payload truncated
+        chanState->flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+    }
+}
+
 static void configureMAVLinkStreamRates(void)
 {
     mavRates[MAV_DATA_STREAM_EXTENDED_STATUS] = telemetryConfig()->mavlink.extended_status_rate;
@@ -319,27 +347,21 @@ void checkMAVLinkTelemetryState(void)
 
     if (newTelemetryEnabledValue) {
         configureMAVLinkTelemetryPort();
+        configureMAVLinkVersion();
         configureMAVLinkStreamRates();
     } else
         freeMAVLinkTelemetryPort();
 }
 
-static void mavlinkSendMessage(void)
+static bool mavlinkTxSpaceAvailable(uint16_t length)
 {
-    uint8_t mavBuffer[MAVLINK_MAX_PACKET_LEN];
-
-    mavlink_status_t* chan_state = mavlink_get_channel_status(MAVLINK_COMM_0);
-    if (telemetryConfig()->mavlink.version == 1) {
-        chan_state->flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
-    } else {
-        chan_state->flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
-    }
-
-    int msgLength = mavlink_msg_to_send_buffer(mavBuffer, &mavSendMsg);
+    // Drop the whole message rather than writing a truncated frame
+    return serialTxBytesFree(mavlinkPort) >= length;
+}
 
-    for (int i = 0; i < msgLength; i++) {
-        serialWrite(mavlinkPort, mavBuffer[i]);
-    }
+static void mavlinkSendBytes(const uint8_t *buf, uint16_t len)
+{
+    serialWriteBuf(mavlinkPort, buf, len);
 }
 
 void mavlinkSendSystemStatus(void)
@@ -454,7 +476,7 @@ void mavlinkSendSystemStatus(void)
     }
 #endif
 
-    mavlink_msg_sys_status_pack(mavSystemId, mavComponentId, &mavSendMsg,
+    mavlink_msg_sys_status_send(MAVLINK_COMM_0,
         // onboard_control_sensors_present Bitmask showing which onboard controllers and sensors are present.
         //Value of 0: not present. Value of 1: present. Indices according MAV_SYS_STATUS_SENSOR
         onboard_control_sensors_present,
@@ -482,14 +504,12 @@ void mavlinkSendSystemStatus(void)
         0,
         // errors_count4 Autopilot-specific errors
         0);
-
-    mavlinkSendMessage();
 }
 
 void mavlinkSendRCChannelsAndRSSI(void)
 {
 #define GET_CHANNEL_VALUE(x) ((rxRuntimeConfig.channelCount >= (x + 1)) ? rxGetChannelValue(x) : 0)
-    mavlink_msg_rc_channels_raw_pack(mavSystemId, mavComponentId, &mavSendMsg,
+    mavlink_msg_rc_channels_raw_send(MAVLINK_COMM_0,
         // time_boot_ms Timestamp (milliseconds since system boot)
         millis(),
         // port Servo output port (set of 8 outputs = 1 port). Most MAVs will just use one, but this allows to encode more than 8 servos.
@@ -514,8 +534,6 @@ void mavlinkSendRCChannelsAndRSSI(void)
 		//https://github.com/mavlink/mavlink/issues/1027
         scaleRange(getRSSI(), 0, 1023, 0, 254));
 #undef GET_CHANNEL_VALUE
-
-    mavlinkSendMessage();
 }
 
 #if defined(USE_GPS)
@@ -533,7 +551,7 @@ void mavlinkSendPosition(timeUs_t currentTimeUs)
     else if (gpsSol.fixType == GPS_FIX_3D)
             gpsFixType = 3;
 
-    mavlink_msg_gps_raw_int_pack(mavSystemId, mavComponentId, &mavSendMsg,
+    mavlink_msg_gps_raw_int_send(MAVLINK_COMM_0,
         // time_usec Timestamp (microseconds since UNIX epoch or microseconds since system boot)
         currentTimeUs,
         // fix_type 0-1: no fix, 2: 2D fix, 3: 3D fix. Some applications will not use the value of this field unless it is at least two, so always correctly fill in the fix.
@@ -567,10 +585,8 @@ void mavlinkSendPosition(timeUs_t currentTimeUs)
         // yaw Yaw in earth frame from north. Use 0 if this GPS does not provide yaw. Use 65535 if this GPS is configured to provide yaw and is currently unable to provide it. Use 36000 for north.
         0);
 
-    mavlinkSendMessage();
-
     // Global position
-    mavlink_msg_global_position_int_pack(mavSystemId, mavComponentId, &mavSendMsg,
+    mavlink_msg_global_position_int_send(MAVLINK_COMM_0,
         // time_usec Timestamp (microseconds since UNIX epoch or microseconds since system boot)
         currentTimeUs,
         // lat Latitude in 1E7 degrees
@@ -595,9 +611,7 @@ void mavlinkSendPosition(timeUs_t currentTimeUs)
         DECIDEGREES_TO_CENTIDEGREES(attitude.values.yaw)
     );
 
-    mavlinkSendMessage();
-
-    mavlink_msg_gps_global_origin_pack(mavSystemId, mavComponentId, &mavSendMsg,
+    mavlink_msg_gps_global_origin_send(MAVLINK_COMM_0,
         // latitude Latitude (WGS84), expressed as * 1E7
         GPS_home.lat,
         // longitude Longitude (WGS84), expressed as * 1E7
@@ -607,14 +621,12 @@ void mavlinkSendPosition(timeUs_t currentTimeUs)
         // time_usec Timestamp (microseconds since system boot)
         // Use millis() * 1000 as micros() will overflow after 1.19 hours.
         ((uint64_t) millis()) * 1000);
-
-    mavlinkSendMessage();
 }
 #endif
 
 void mavlinkSendAttitude(void)
 {
-    mavlink_msg_attitude_pack(mavSystemId, mavComponentId, &mavSendMsg,
+    mavlink_msg_attitude_send(MAVLINK_COMM_0,
         // time_boot_ms Timestamp (milliseconds since system boot)
         millis(),
         // roll Roll angle (rad)
@@ -629,8 +641,6 @@ void mavlinkSendAttitude(void)
         gyro.gyroADCf[FD_PITCH],
         // yawspeed Yaw angular speed (rad/s)
         gyro.gyroADCf[FD_YAW]);
-
-    mavlinkSendMessage();
 }
 
 void mavlinkSendHUDAndHeartbeat(void)
@@ -669,7 +679,7 @@ void mavlinkSendHUDAndHeartbeat(void)
     if (navigationIsControllingThrottle()) {
         thr = rcCommand[THROTTLE];
     }
-    mavlink_msg_vfr_hud_pack(mavSystemId, mavComponentId, &mavSendMsg,
+    mavlink_msg_vfr_hud_send(MAVLINK_COMM_0,
         // airspeed Current airspeed in m/s
         mavAirSpeed,
         // groundspeed Current ground speed in m/s
@@ -683,9 +693,6 @@ void mavlinkSendHUDAndHeartbeat(void)
         // climb Current climb rate in meters/second
         mavClimbRate);
 
-    mavlinkSendMessage();
-
-
     uint8_t mavModes = MAV_MODE_FLAG_MANUAL_INPUT_ENABLED | MAV_MODE_FLAG_CUSTOM_MODE_ENABLED;
     if (ARMING_FLAG(ARMED))
         mavModes |= MAV_MODE_FLAG_SAFETY_ARMED;
@@ -749,7 +756,7 @@ void mavlinkSendHUDAndHeartbeat(void)
         mavSystemState = MAV_STATE_STANDBY;
     }
 
-    mavlink_msg_heartbeat_pack(mavSystemId, mavComponentId, &mavSendMsg,
+    mavlink_msg_heartbeat_send(MAVLINK_COMM_0,
         // type Type of the MAV (quadrotor, helicopter, etc., up to 15 types, defined in MAV_TYPE ENUM)
         mavSystemType,
         // autopilot Autopilot type / class. defined in MAV_AUTOPILOT ENUM
@@ -760,8 +767,6 @@ void mavlinkSendHUDAndHeartbeat(void)
         mavCustomMode,
         // system_status System status flag, see MAV_STATE ENUM
         mavSystemState);
-
-    mavlinkSendMessage();
 }
 
 void mavlinkSendBatteryTemperatureStatusText(void)
@@ -789,7 +794,7 @@ void mavlinkSendBatteryTemperatureStatusText(void)
         batteryVoltages[0] = 0;
     }
 
-    mavlink_msg_battery_status_pack(mavSystemId, mavComponentId, &mavSendMsg,
+    mavlink_msg_battery_status_send(MAVLINK_COMM_0,
         // id Battery ID
         0,
         // battery_function Function of the battery
@@ -819,20 +824,15 @@ void mavlinkSendBatteryTemperatureStatusText(void)
         // fault_bitmask Fault/health indications. These should be set when charge_state is MAV_BATTERY_CHARGE_STATE_FAILED or MAV_BATTERY_CHARGE_STATE_UNHEALTHY (if not, fault reporting is not supported).
         0);
 
-    mavlinkSendMessage();
-
-
     int16_t temperature;
     sensors(SENSOR_BARO) ? getBaroTemperature(&temperature) : getIMUTemperature(&temperature);
-    mavlink_msg_scaled_pressure_pack(mavSystemId, mavComponentId, &mavSendMsg,
+    mavlink_msg_scaled_pressure_send(MAVLINK_COMM_0,
         millis(),
         0,
         0,
         temperature * 10,
         0);
 
-    mavlinkSendMessage();
-
 
 // FIXME - Status text is limited to boards with USE_OSD
 #ifdef USE_OSD
@@ -846,13 +846,11 @@ void mavlinkSendBatteryTemperatureStatusText(void)
             severity = MAV_SEVERITY_WARNING;
         }
 
-        mavlink_msg_statustext_pack(mavSystemId, mavComponentId, &mavSendMsg,
+        mavlink_msg_statustext_send(MAVLINK_COMM_0,
             (uint8_t)severity,
             buff,
             0,
             0);
-
-        mavlinkSendMessage();
     }
 #endif
 
@@ -890,16 +888,20 @@ void processMAVLinkTelemetry(timeUs_t currentTimeUs)
 
 }
 
+static void mavlinkSendMissionAck(uint8_t targetSystem, uint8_t targetComponent, MAV_MISSION_RESULT result)
+{
+    mavlink_msg_mission_ack_send(MAVLINK_COMM_0, targetSystem, targetComponent, result, MAV_MISSION_TYPE_MISSION);
+}
+
 static bool handleIncoming_MISSION_CLEAR_ALL(void)
 {
     mavlink_mission_clear_all_t msg;
     mavlink_msg_mission_clear_all_decode(&mavRecvMsg, &msg);
 
     // Check if this message is for us
-    if (msg.target_system == mavSystemId) {
+    if (msg.target_system == mavlink_system.sysid) {
         resetWaypointList();
-        mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ACCEPTED, MAV_MISSION_TYPE_MISSION);
-        mavlinkSendMessage();
+        mavlinkSendMissionAck(mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ACCEPTED);
         return true;
     }
 
@@ -907,8 +909,49 @@ static bool handleIncoming_MISSION_CLEAR_ALL(void)
 }
 
 // Static state for MISSION UPLOAD transaction (starting with MISSION_COUNT)
-static int incomingMissionWpCount = 0;
-static int incomingMissionWpSequence = 0;
+static struct {
+    bool inProgress;
+    uint8_t gcsSystemId;
+    uint8_t gcsComponentId;
+    int wpCount;
+    int wpSequence;         // next item to be stored
+    int wpRequested;        // items up to here have been requested
+    timeUs_t lastItemTimeUs;
+    uint8_t retries;
+} incomingMission;
+
+/*
+ * Keep up to MAVLINK_MISSION_REQUEST_WINDOW item requests in flight, so the
+ * GCS can stream the following items while the previous ones are on the way
+ * instead of waiting a full link round trip for each waypoint.
+ */
+static void mavlinkRequestMissionItems(void)
+{
+    while (incomingMission.wpRequested < incomingMission.wpCount &&
+           incomingMission.wpRequested < incomingMission.wpSequence + MAVLINK_MISSION_REQUEST_WINDOW) {
+        mavlink_msg_mission_request_int_send(MAVLINK_COMM_0, incomingMission.gcsSystemId, incomingMission.gcsComponentId,
+            incomingMission.wpRequested, MAV_MISSION_TYPE_MISSION);
+        incomingMission.wpRequested++;
+    }
+}
+
+static void mavlinkCheckMissionUploadTimeout(timeUs_t currentTimeUs)
+{
+    if (!incomingMission.inProgress || cmpTimeUs(currentTimeUs, incomingMission.lastItemTimeUs) < MAVLINK_MISSION_REQUEST_TIMEOUT_US) {
+        return;
+    }
+
+    if (++incomingMission.retries > MAVLINK_MISSION_REQUEST_RETRIES) {
+        incomingMission.inProgress = false;
+        mavlinkSendMissionAck(incomingMission.gcsSystemId, incomingMission.gcsComponentId, MAV_MISSION_OPERATION_CANCELLED);
+        return;
+    }
+
+    // An item or a request got lost, request again from the first missing one
+    incomingMission.lastItemTimeUs = currentTimeUs;
+    incomingMission.wpRequested = incomingMission.wpSequence;
+    mavlinkRequestMissionItems();
+}
 
 static bool handleIncoming_MISSION_COUNT(void)
 {
@@ -916,22 +959,30 @@ static bool handleIncoming_MISSION_COUNT(void)
     mavlink_msg_mission_count_decode(&mavRecvMsg, &msg);
 
     // Check if this message is for us
-    if (msg.target_system == mavSystemId) {
+    if (msg.target_system == mavlink_system.sysid) {
         if (msg.count <= NAV_MAX_WAYPOINTS) {
-            incomingMissionWpCount = msg.count; // We need to know how many items to request
-            incomingMissionWpSequence = 0;
-            mavlink_msg_mission_request_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, incomingMissionWpSequence, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
+            incomingMission.inProgress = msg.count > 0;
+            incomingMission.gcsSystemId = mavRecvMsg.sysid;
+            incomingMission.gcsComponentId = mavRecvMsg.compid;
+            incomingMission.wpCount = msg.count; // We need to know how many items to request
+            incomingMission.wpSequence = 0;
+            incomingMission.wpRequested = 0;
+            incomingMission.lastItemTimeUs = micros();
+            incomingMission.retries = 0;
+            if (msg.count > 0) {
+                mavlinkRequestMissionItems();
+            } else {
+                resetWaypointList();
+                mavlinkSendMissionAck(mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ACCEPTED);
+            }
             return true;
         }
         else if (ARMING_FLAG(ARMED)) {
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ERROR, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
+            mavlinkSendMissionAck(mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ERROR);
             return true;
         }
         else {
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_NO_SPACE, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
+            mavlinkSendMissionAck(mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_NO_SPACE);
             return true;
         }
     }
@@ -939,69 +990,88 @@ static bool handleIncoming_MISSION_COUNT(void)
     return false;
 }
 
+// Common part of MISSION_ITEM and MISSION_ITEM_INT, coordinates in 1e7 degrees and altitude in meters
+static bool handleIncomingMissionItem(uint16_t seq, uint8_t frame, uint16_t command, uint8_t autocontinue, int32_t lat, int32_t lon, float alt)
+{
+    // Check supported values first
+    if (ARMING_FLAG(ARMED)) {
+        incomingMission.inProgress = false;
+        mavlinkSendMissionAck(mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ERROR);
+        return true;
+    }
+
+    if ((autocontinue == 0) || (command != MAV_CMD_NAV_WAYPOINT && command != MAV_CMD_NAV_RETURN_TO_LAUNCH)) {
+        incomingMission.inProgress = false;
+        mavlinkSendMissionAck(mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_UNSUPPORTED);
+        return true;
+    }
+
+    if ((frame != MAV_FRAME_GLOBAL_RELATIVE_ALT) && (frame != MAV_FRAME_GLOBAL_RELATIVE_ALT_INT) &&
+        !(frame == MAV_FRAME_MISSION && command == MAV_CMD_NAV_RETURN_TO_LAUNCH)) {
+        incomingMission.inProgress = false;
+        mavlinkSendMissionAck(mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_UNSUPPORTED_FRAME);
+        return true;
+    }
+
+    if (!incomingMission.inProgress) {
+        mavlinkSendMissionAck(mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID_SEQUENCE);
+        return true;
+    }
+
+    if (seq != incomingMission.wpSequence) {
+        // With several requests in flight an item can be repeated, or arrive
+        // after a lost one. Drop it, the timeout requests the missing items again.
+        return true;
+    }
+
+    incomingMission.wpSequence++;
+    incomingMission.lastItemTimeUs = micros();
+    incomingMission.retries = 0;
+
+    navWaypoint_t wp;
+    wp.action = (command == MAV_CMD_NAV_RETURN_TO_LAUNCH) ? NAV_WP_ACTION_RTH : NAV_WP_ACTION_WAYPOINT;
+    wp.lat = lat;
+    wp.lon = lon;
+    wp.alt = alt * 100.0f;
+    wp.p1 = 0;
+    wp.p2 = 0;
+    wp.p3 = 0;
+    wp.flag = (incomingMission.wpSequence >= incomingMission.wpCount) ? NAV_WP_FLAG_LAST : 0;
+
+    setWaypoint(incomingMission.wpSequence, &wp);
+
+    if (incomingMission.wpSequence >= incomingMission.wpCount) {
+        incomingMission.inProgress = false;
+        mavlinkSendMissionAck(mavRecvMsg.sysid, mavRecvMsg.compid, isWaypointListValid() ? MAV_MISSION_ACCEPTED : MAV_MISSION_INVALID);
+    }
+    else {
+        mavlinkRequestMissionItems();
+    }
+
+    return true;
+}
+
 static bool handleIncoming_MISSION_ITEM(void)
 {
     mavlink_mission_item_t msg;
     mavlink_msg_mission_item_decode(&mavRecvMsg, &msg);
 
     // Check if this message is for us
-    if (msg.target_system == mavSystemId) {
-        // Check supported values first
-        if (ARMING_FLAG(ARMED)) {
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ERROR, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-            return true;
-        }
-
-        if ((msg.autocontinue == 0) || (msg.command != MAV_CMD_NAV_WAYPOINT && msg.command != MAV_CMD_NAV_RETURN_TO_LAUNCH)) {
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_UNSUPPORTED, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-            return true;
-        }
+    if (msg.target_system == mavlink_system.sysid) {
+        return handleIncomingMissionItem(msg.seq, msg.frame, msg.command, msg.autocontinue, (int32_t)(msg.x * 1e7f), (int32_t)(msg.y * 1e7f), msg.z);
+    }
 
-        if ((msg.frame != MAV_FRAME_GLOBAL_RELATIVE_ALT) && !(msg.frame == MAV_FRAME_MISSION && msg.command == MAV_CMD_NAV_RETURN_TO_LAUNCH)) {
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_UNSUPPORTED_FRAME, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-            return true;
-        }
+    return false;
+}
 
-        if (msg.seq == incomingMissionWpSequence) {
-            incomingMissionWpSequence++;
-
-            navWaypoint_t wp;
-            wp.action = (msg.command == MAV_CMD_NAV_RETURN_TO_LAUNCH) ? NAV_WP_ACTION_RTH : NAV_WP_ACTION_WAYPOINT;
-            wp.lat = (int32_t)(msg.x * 1e7f);
-            wp.lon = (int32_t)(msg.y * 1e7f);
-            wp.alt = msg.z * 100.0f;
-            wp.p1 = 0;
-            wp.p2 = 0;
-            wp.p3 = 0;
-            wp.flag = (incomingMissionWpSequence >= incomingMissionWpCount) ? NAV_WP_FLAG_LAST : 0;
-
-            setWaypoint(incomingMissionWpSequence, &wp);
-
-            if (incomingMissionWpSequence >= incomingMissionWpCount) {
-                if (isWaypointListValid()) {
-                    mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_ACCEPTED, MAV_MISSION_TYPE_MISSION);
-                    mavlinkSendMessage();
-                }
-                else {
-                    mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID, MAV_MISSION_TYPE_MISSION);
-                    mavlinkSendMessage();
-                }
-            }
-            else {
-                mavlink_msg_mission_request_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, incomingMissionWpSequence, MAV_MISSION_TYPE_MISSION);
-                mavlinkSendMessage();
-            }
-        }
-        else {
-            // Wrong sequence number received
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID_SEQUENCE, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-        }
+static bool handleIncoming_MISSION_ITEM_INT(void)
+{
+    mavlink_mission_item_int_t msg;
+    mavlink_msg_mission_item_int_decode(&mavRecvMsg, &msg);
 
-        return true;
+    // Check if this message is for us
+    if (msg.target_system == mavlink_system.sysid) {
+        return handleIncomingMissionItem(msg.seq, msg.frame, msg.command, msg.autocontinue, msg.x, msg.y, msg.z);
     }
 
     return false;
@@ -1013,46 +1083,77 @@ static bool handleIncoming_MISSION_REQUEST_LIST(void)
     mavlink_msg_mission_request_list_decode(&mavRecvMsg, &msg);
 
     // Check if this message is for us
-    if (msg.target_system == mavSystemId) {
-        mavlink_msg_mission_count_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, getWaypointCount(), MAV_MISSION_TYPE_MISSION);
-        mavlinkSendMessage();
+    if (msg.target_system == mavlink_system.sysid) {
+        mavlink_msg_mission_count_send(MAVLINK_COMM_0, mavRecvMsg.sysid, mavRecvMsg.compid, getWaypointCount(), MAV_MISSION_TYPE_MISSION);
         return true;
     }
 
     return false;
 }
 
+// Answers MISSION_REQUEST with MISSION_ITEM and MISSION_REQUEST_INT with MISSION_ITEM_INT
+static void mavlinkSendMissionItem(uint16_t seq, bool intCoordinates)
+{
+    if (seq >= getWaypointCount()) {
+        mavlinkSendMissionAck(mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID_SEQUENCE);
+        return;
+    }
+
+    navWaypoint_t wp;
+    getWaypoint(seq + 1, &wp);
+
+    const bool isRth = wp.action == NAV_WP_ACTION_RTH;
+    const uint16_t command = isRth ? MAV_CMD_NAV_RETURN_TO_LAUNCH : MAV_CMD_NAV_WAYPOINT;
+
+    if (intCoordinates) {
+        mavlink_msg_mission_item_int_send(MAVLINK_COMM_0, mavRecvMsg.sysid, mavRecvMsg.compid,
+                    seq,
+                    isRth ? MAV_FRAME_MISSION : MAV_FRAME_GLOBAL_RELATIVE_ALT_INT,
+                    command,
+                    0,
+                    1,
+                    0, 0, 0, 0,
+                    wp.lat,
+                    wp.lon,
+                    wp.alt / 100.0f,
+                    MAV_MISSION_TYPE_MISSION);
+    } else {
+        mavlink_msg_mission_item_send(MAVLINK_COMM_0, mavRecvMsg.sysid, mavRecvMsg.compid,
+                    seq,
+                    isRth ? MAV_FRAME_MISSION : MAV_FRAME_GLOBAL_RELATIVE_ALT,
+                    command,
+                    0,
+                    1,
+                    0, 0, 0, 0,
+                    wp.lat / 1e7f,
+                    wp.lon / 1e7f,
+                    wp.alt / 100.0f,
+                    MAV_MISSION_TYPE_MISSION);
+    }
+}
+
 static bool handleIncoming_MISSION_REQUEST(void)
 {
     mavlink_mission_request_t msg;
     mavlink_msg_mission_request_decode(&mavRecvMsg, &msg);
 
     // Check if this message is for us
-    if (msg.target_system == mavSystemId) {
-        int wpCount = getWaypointCount();
-
-        if (msg.seq < wpCount) {
-            navWaypoint_t wp;
-            getWaypoint(msg.seq + 1, &wp);
-
-            mavlink_msg_mission_item_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid,
-                        msg.seq,
-                        wp.action == NAV_WP_ACTION_RTH ? MAV_FRAME_MISSION : MAV_FRAME_GLOBAL_RELATIVE_ALT,
-                        wp.action == NAV_WP_ACTION_RTH ? MAV_CMD_NAV_RETURN_TO_LAUNCH : MAV_CMD_NAV_WAYPOINT,
-                        0,
-                        1,
-                        0, 0, 0, 0,
-                        wp.lat / 1e7f,
-                        wp.lon / 1e7f,
-                        wp.alt / 100.0f,
-                        MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-        }
-        else {
-            mavlink_msg_mission_ack_pack(mavSystemId, mavComponentId, &mavSendMsg, mavRecvMsg.sysid, mavRecvMsg.compid, MAV_MISSION_INVALID_SEQUENCE, MAV_MISSION_TYPE_MISSION);
-            mavlinkSendMessage();
-        }
+    if (msg.target_system == mavlink_system.sysid) {
+        mavlinkSendMissionItem(msg.seq, false);
+        return true;
+    }
 
+    return false;
+}
+
+static bool handleIncoming_MISSION_REQUEST_INT(void)
+{
+    mavlink_mission_request_int_t msg;
+    mavlink_msg_mission_request_int_decode(&mavRecvMsg, &msg);
+
+    // Check if this message is for us
+    if (msg.target_system == mavlink_system.sysid) {
+        mavlinkSendMissionItem(msg.seq, true);
         return true;
     }
 
@@ -1067,6 +1168,22 @@ static bool handleIncoming_RC_CHANNELS_OVERRIDE(void) {
     return true;
 }
 
+#if defined(USE_NAV)
+static bool handleIncoming_VISION_POSITION_ESTIMATE(void)
+{
+    mavlink_vision_position_estimate_t msg;
+    mavlink_msg_vision_position_estimate_decode(&mavRecvMsg, &msg);
+
+    // Companion clock is not synchronised with ours, treat the pose as current. Local NED (m) to NEU (cm)
+    const fpVector3_t pos = { .v = { msg.x * 100.0f, msg.y * 100.0f, -msg.z * 100.0f } };
+    // NaN means unknown, MAVLink1 frames and many companions send 0 for that as well. Both are left to the estimator
+    const float posStd = sqrtf(msg.covariance[0]) * 100.0f;
+
+    updatePositionEstimator_ExternalPoseTopic(0, &pos, NULL, posStd);
+    return true;
+}
+#endif
+
 static bool processMAVLinkIncomingTelemetry(void)
 {
     while (serialRxBytesWaiting(mavlinkPort) > 0) {
@@ -1083,12 +1200,20 @@ static bool processMAVLinkIncomingTelemetry(void)
                     return handleIncoming_MISSION_COUNT();
                 case MAVLINK_MSG_ID_MISSION_ITEM:
                     return handleIncoming_MISSION_ITEM();
+                case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+                    return handleIncoming_MISSION_ITEM_INT();
                 case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
                     return handleIncoming_MISSION_REQUEST_LIST();
                 case MAVLINK_MSG_ID_MISSION_REQUEST:
                     return handleIncoming_MISSION_REQUEST();
+                case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+                    return handleIncoming_MISSION_REQUEST_INT();
                 case MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE:
                     return handleIncoming_RC_CHANNELS_OVERRIDE();
+#if defined(USE_NAV)
+                case MAVLINK_MSG_ID_VISION_POSITION_ESTIMATE:
+                    return handleIncoming_VISION_POSITION_ESTIMATE();
+#endif
                 default:
                     return false;
             }
@@ -1115,6 +1240,8 @@ void handleMAVLinkTelemetry(timeUs_t currentTimeUs)
         incomingRequestServed = true;
     }
 
+    mavlinkCheckMissionUploadTimeout(currentTimeUs);
+
     if ((currentTimeUs - lastMavlinkMessage) >= TELEMETRY_MAVLINK_DELAY) {
         // Only process scheduled data if we didn't serve any incoming request this cycle
         if (!incomingRequestServed) {
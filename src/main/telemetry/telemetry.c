@@ -18,11 +18,13 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "platform.h"
 
 #ifdef USE_TELEMETRY
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "config/parameter_group.h"
@@ -259,4 +261,103 @@ void telemetryProcess(timeUs_t currentTimeUs)
 #endif
 }
 
+void telemetrySchedulerInit(telemetryScheduler_t *scheduler, telemetryFrame_t *frames, uint8_t frameCount)
+{
+    scheduler->frames = frames;
+    scheduler->frameCount = frameCount;
+    scheduler->slotIntervalUs = 0;
+    scheduler->lastSlotUs = 0;
+
+    for (int ii = 0; ii < frameCount; ii++) {
+        frames[ii].sent = false;
+    }
+}
+
+void telemetrySchedulerSetSlotRate(telemetryScheduler_t *scheduler, uint16_t slotsPerSecond)
+{
+    scheduler->slotIntervalUs = slotsPerSecond ? 1000000 / slotsPerSecond : 0;
+}
+
+static bool telemetryFrameValuesChanged(const telemetryFrame_t *frame, const int32_t *values, uint8_t count)
+{
+    for (int ii = 0; ii < count; ii++) {
+        // int64 so wide swings (e.g. longitude across +-180deg) don't overflow
+        const int64_t delta = (int64_t)values[ii] - frame->lastValues[ii];
+        if (ABS(delta) >= frame->changeThreshold) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Called by the backend when the link has a free TX slot. Returns the index of
+ * the frame to send in it, or -1 when no slot is due or nothing needs sending.
+ * Changed frames go before stale ones, then by priority, then the oldest first.
+ * Unchanged frames are only repeated every maxIntervalMs, so slots are left
+ * empty instead of spending airtime on values the ground station already has.
+ */
+int telemetrySchedulerNextFrame(telemetryScheduler_t *scheduler, timeUs_t currentTimeUs)
+{
+    if (cmpTimeUs(currentTimeUs, scheduler->lastSlotUs) < (timeDelta_t)scheduler->slotIntervalUs) {
+        return -1;
+    }
+    scheduler->lastSlotUs = currentTimeUs;
+
+    int best = -1;
+    bool bestChanged = false;
+    timeDelta_t bestAge = 0;
+    uint8_t bestCount = 0;
+    int32_t bestValues[TELEMETRY_FRAME_VALUE_COUNT];
+
+    for (int ii = 0; ii < scheduler->frameCount; ii++) {
+        const telemetryFrame_t *frame = &scheduler->frames[ii];
+        if (!frame->enabled) {
+            continue;
+        }
+
+        const timeDelta_t age = frame->sent ? cmpTimeUs(currentTimeUs, frame->lastSentUs) : INT32_MAX;
+        if (age < (timeDelta_t)frame->minIntervalMs * 1000) {
+            continue;
+        }
+
+        int32_t values[TELEMETRY_FRAME_VALUE_COUNT];
+        const uint8_t count = MIN(frame->valuesFn(values), TELEMETRY_FRAME_VALUE_COUNT);
+        const bool changed = !frame->sent || telemetryFrameValuesChanged(frame, values, count);
+        if (!changed && age < (timeDelta_t)frame->maxIntervalMs * 1000) {
+            continue;
+        }
+
+        if (best >= 0) {
+            const telemetryFrame_t *bestFrame = &scheduler->frames[best];
+            if (changed != bestChanged) {
+                if (!changed) {
+                    continue;
+                }
+            } else if (frame->priority != bestFrame->priority) {
+                if (frame->priority < bestFrame->priority) {
+                    continue;
+                }
+            } else if (age <= bestAge) {
+                continue;
+            }
+        }
+
+        best = ii;
+        bestChanged = changed;
+        bestAge = age;
+        bestCount = count;
+        memcpy(bestValues, values, sizeof(int32_t) * count);
+    }
+
+    if (best >= 0) {
+        telemetryFrame_t *frame = &scheduler->frames[best];
+        frame->sent = true;
+        frame->lastSentUs = currentTimeUs;
+        memcpy(frame->lastValues, bestValues, sizeof(int32_t) * bestCount);
+    }
+
+    return best;
+}
+
 #endif
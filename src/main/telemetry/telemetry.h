@@ -103,3 +103,36 @@ void telemetryCheckState(void);
 void telemetryProcess(timeUs_t currentTimeUs);
 
 bool telemetryDetermineEnabledState(portSharing_e portSharing);
+
+/*
+ * Common frame scheduler for the telemetry backends which send one frame per
+ * free TX slot (CRSF, GHST). Frames whose values changed are sent before
+ * unchanged frames which are only repeated once they get stale.
+ */
+#define TELEMETRY_FRAME_VALUE_COUNT 4
+
+typedef uint8_t (*telemetryFrameValuesFnPtr)(int32_t *values);
+
+typedef struct telemetryFrame_s {
+    uint8_t priority;                   // higher priority frames are sent first when several are due
+    uint16_t minIntervalMs;             // frame is never sent more often than this
+    uint16_t maxIntervalMs;             // frame is repeated at least this often, even when unchanged
+    int32_t changeThreshold;            // change of any value which makes the frame due before maxIntervalMs
+    telemetryFrameValuesFnPtr valuesFn; // fills in the values to watch for changes, returns their count
+    bool enabled;
+    // scheduler state
+    bool sent;
+    timeUs_t lastSentUs;
+    int32_t lastValues[TELEMETRY_FRAME_VALUE_COUNT];
+} telemetryFrame_t;
+
+typedef struct telemetryScheduler_s {
+    telemetryFrame_t *frames;
+    uint8_t frameCount;
+    timeUs_t slotIntervalUs;            // time between TX slots, from the link capacity
+    timeUs_t lastSlotUs;
+} telemetryScheduler_t;
+
+void telemetrySchedulerInit(telemetryScheduler_t *scheduler, telemetryFrame_t *frames, uint8_t frameCount);
+void telemetrySchedulerSetSlotRate(telemetryScheduler_t *scheduler, uint16_t slotsPerSecond);
+int telemetrySchedulerNextFrame(telemetryScheduler_t *scheduler, timeUs_t currentTimeUs);
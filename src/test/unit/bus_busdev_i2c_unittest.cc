@@ -0,0 +1,378 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "platform.h"
+#include "common/utils.h"
+#include "drivers/bus.h"
+#include "drivers/bus_i2c.h"
+#include "drivers/time.h"
+}
+
+#include "gtest/gtest.h"
+
+#define POLLS_PER_TRANSFER  3
+#define POLL_TIME_US        10
+
+// Emulates the low level driver, one transfer at a time per bus
+static struct {
+    bool active;
+    uint8_t reg;
+    uint8_t len;
+    uint8_t *buf;
+    bool read;
+    unsigned polls;
+} hw[I2CDEV_COUNT];
+
+static std::vector<uint8_t> started;    // Registers in the order the transfers were started
+static uint8_t nackReg;                 // Transfers to this register fail with NACK
+static timeUs_t fakeMicros;
+static unsigned emulatedTransfers;
+
+static busDevice_t makeDevice(I2CDevice bus, uint8_t address)
+{
+    busDevice_t dev;
+    memset(&dev, 0, sizeof(dev));
+    dev.busType = BUSTYPE_I2C;
+    dev.busdev.i2c.i2cBus = bus;
+    dev.busdev.i2c.address = address;
+    return dev;
+}
+
+static busI2CTransaction_t makeTransaction(const busDevice_t *dev, uint8_t reg, uint8_t *buf, uint8_t priority, timeDelta_t timeoutUs = 0)
+{
+    busI2CTransaction_t txn;
+    memset(&txn, 0, sizeof(txn));
+    txn.dev = dev;
+    txn.reg = reg;
+    txn.read = true;
+    txn.buf = buf;
+    txn.length = 1;
+    txn.priority = priority;
+    txn.timeoutUs = timeoutUs;
+    return txn;
+}
+
+static void processUntilIdle(void)
+{
+    for (int ii = 0; ii < 100; ii++) {
+        i2cBusProcessQueues(fakeMicros);
+        bool idle = true;
+        for (int bus = 0; bus < I2CDEV_COUNT; bus++) {
+            idle = idle && !hw[bus].active;
+        }
+        if (idle) {
+            return;
+        }
+    }
+    ADD_FAILURE() << "queue never drained";
+}
+
+static unsigned callbacks;
+static i2cTransactionState_e lastCallbackState;
+
+static void countCallback(busI2CTransaction_t *txn)
+{
+    callbacks++;
+    lastCallbackState = txn->state;
+}
+
+class BusDevI2CTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        processUntilIdle();
+        memset(hw, 0, sizeof(hw));
+        started.clear();
+        nackReg = 0xFF;
+        callbacks = 0;
+        emulatedTransfers = 0;
+    }
+};
+
+TEST_F(BusDevI2CTest, TestPriorityOrder)
+{
+    busDevice_t dev = makeDevice(I2CDEV_1, 0x3C);
+    uint8_t data[4];
+
+    busI2CTransaction_t first = makeTransaction(&dev, 1, &data[0], 0);
+    busI2CTransaction_t low = makeTransaction(&dev, 2, &data[1], 0);
+    busI2CTransaction_t high1 = makeTransaction(&dev, 3, &data[2], 5);
+    busI2CTransaction_t high2 = makeTransaction(&dev, 4, &data[3], 5);
+
+    // The bus is idle, the first one starts right away
+    EXPECT_TRUE(i2cBusSubmit(&first));
+    EXPECT_EQ(I2C_TXN_ACTIVE, first.state);
+    EXPECT_TRUE(i2cBusSubmit(&low));
+    EXPECT_TRUE(i2cBusSubmit(&high1));
+    EXPECT_TRUE(i2cBusSubmit(&high2));
+    EXPECT_EQ(I2C_TXN_QUEUED, low.state);
+
+    // Submitting a pending transaction again is refused
+    EXPECT_FALSE(i2cBusSubmit(&low));
+
+    processUntilIdle();
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 3, 4, 2 }), started);
+    EXPECT_EQ(I2C_TXN_DONE, first.state);
+    EXPECT_EQ(I2C_TXN_DONE, low.state);
+    EXPECT_EQ(I2C_TXN_DONE, high1.state);
+    EXPECT_EQ(I2C_TXN_DONE, high2.state);
+    EXPECT_EQ(0xA2, data[1]);
+}
+
+TEST_F(BusDevI2CTest, TestTimeout)
+{
+    busDevice_t dev = makeDevice(I2CDEV_1, 0x3C);
+    uint8_t data[2];
+
+    i2cBusStats_t before;
+    ASSERT_TRUE(i2cBusGetStats(I2CDEV_1, &before));
+
+    busI2CTransaction_t blocker = makeTransaction(&dev, 1, &data[0], 0);
+    busI2CTransaction_t stale = makeTransaction(&dev, 2, &data[1], 0, 100);
+    stale.callback = countCallback;
+    EXPECT_TRUE(i2cBusSubmit(&blocker));
+    EXPECT_TRUE(i2cBusSubmit(&stale));
+
+    // Wasn't started before its deadline
+    fakeMicros += 200;
+    processUntilIdle();
+    EXPECT_EQ(I2C_TXN_EXPIRED, stale.state);
+    EXPECT_EQ(1u, callbacks);
+    EXPECT_EQ(I2C_TXN_EXPIRED, lastCallbackState);
+    EXPECT_EQ((std::vector<uint8_t>{ 1 }), started);
+
+    i2cBusStats_t after;
+    ASSERT_TRUE(i2cBusGetStats(I2CDEV_1, &after));
+    EXPECT_EQ(before.expired + 1, after.expired);
+    EXPECT_EQ(0, after.queued);
+}
+
+TEST_F(BusDevI2CTest, TestCallbackAndNack)
+{
+    busDevice_t dev = makeDevice(I2CDEV_1, 0x3C);
+    uint8_t data;
+
+    i2cBusStats_t before;
+    ASSERT_TRUE(i2cBusGetStats(I2CDEV_1, &before));
+
+    nackReg = 7;
+    busI2CTransaction_t txn = makeTransaction(&dev, 7, &data, 0);
+    txn.callback = countCallback;
+    EXPECT_TRUE(i2cBusSubmit(&txn));
+    EXPECT_TRUE(i2cBusIsTransactionPending(&txn));
+    EXPECT_EQ(0u, callbacks);
+
+    processUntilIdle();
+    EXPECT_FALSE(i2cBusIsTransactionPending(&txn));
+    EXPECT_EQ(1u, callbacks);
+    EXPECT_EQ(I2C_TXN_FAILED, lastCallbackState);
+
+    i2cBusStats_t after;
+    ASSERT_TRUE(i2cBusGetStats(I2CDEV_1, &after));
+    EXPECT_EQ(before.transfers + 1, after.transfers);
+    EXPECT_EQ(before.nacks + 1, after.nacks);
+    EXPECT_EQ(before.bytes, after.bytes);
+    EXPECT_GE(after.busyTimeUs - before.busyTimeUs, (uint64_t)(POLLS_PER_TRANSFER * POLL_TIME_US));
+}
+
+static busI2CTransaction_t chained;
+
+static void submitChained(busI2CTransaction_t *txn)
+{
+    if (txn->state == I2C_TXN_DONE) {
+        EXPECT_TRUE(i2cBusSubmit(&chained));
+    }
+}
+
+TEST_F(BusDevI2CTest, TestCallbackSubmitsNext)
+{
+    busDevice_t dev = makeDevice(I2CDEV_1, 0x3C);
+    uint8_t data[3];
+
+    busI2CTransaction_t first = makeTransaction(&dev, 1, &data[0], 0);
+    busI2CTransaction_t other = makeTransaction(&dev, 2, &data[1], 0);
+    chained = makeTransaction(&dev, 3, &data[2], 5);
+    first.callback = submitChained;
+    EXPECT_TRUE(i2cBusSubmit(&first));
+    EXPECT_TRUE(i2cBusSubmit(&other));
+
+    // Submitted from the callback, goes ahead of the queue by its priority
+    processUntilIdle();
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 3, 2 }), started);
+    EXPECT_EQ(I2C_TXN_DONE, chained.state);
+    EXPECT_EQ(I2C_TXN_DONE, other.state);
+
+    // Not submitted after a failure
+    nackReg = 1;
+    chained = makeTransaction(&dev, 3, &data[2], 5);
+    EXPECT_TRUE(i2cBusSubmit(&first));
+    processUntilIdle();
+    EXPECT_EQ(I2C_TXN_FAILED, first.state);
+    EXPECT_EQ(I2C_TXN_IDLE, chained.state);
+}
+
+TEST_F(BusDevI2CTest, TestBlockingWaitsForTransferInFlight)
+{
+    busDevice_t dev = makeDevice(I2CDEV_1, 0x3C);
+    uint8_t data[2];
+
+    busI2CTransaction_t inFlight = makeTransaction(&dev, 1, &data[0], 0);
+    busI2CTransaction_t queued = makeTransaction(&dev, 2, &data[1], 0);
+    EXPECT_TRUE(i2cBusSubmit(&inFlight));
+    EXPECT_TRUE(i2cBusSubmit(&queued));
+
+    // Goes after the transfer on the bus but ahead of the queue
+    uint8_t value = 0;
+    EXPECT_TRUE(i2cBusReadRegister(&dev, 9, &value));
+    EXPECT_EQ(0xA9, value);
+    EXPECT_EQ(I2C_TXN_DONE, inFlight.state);
+    EXPECT_EQ(I2C_TXN_QUEUED, queued.state);
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 9 }), started);
+
+    processUntilIdle();
+    EXPECT_EQ(I2C_TXN_DONE, queued.state);
+
+    nackReg = 4;
+    const uint8_t payload[] = { 1, 2, 3 };
+    EXPECT_FALSE(i2cBusWriteBuffer(&dev, 4, payload, sizeof(payload)));
+    EXPECT_TRUE(i2cBusWriteBuffer(&dev, 5, payload, sizeof(payload)));
+}
+
+TEST_F(BusDevI2CTest, TestEmulatedBusPassesThrough)
+{
+    busDevice_t dev = makeDevice(I2CDEV_EMULATED, 0x3C);
+    uint8_t data = 0;
+
+    EXPECT_TRUE(i2cBusReadRegister(&dev, 3, &data));
+    EXPECT_EQ(1u, emulatedTransfers);
+    EXPECT_TRUE(started.empty());
+
+    // Can't be queued
+    busI2CTransaction_t txn = makeTransaction(&dev, 3, &data, 0);
+    EXPECT_FALSE(i2cBusSubmit(&txn));
+
+    i2cBusStats_t stats;
+    EXPECT_FALSE(i2cBusGetStats(I2CDEV_EMULATED, &stats));
+}
+
+TEST_F(BusDevI2CTest, TestDeferredReadReturnsPreviousReading)
+{
+    busDevice_t dev = makeDevice(I2CDEV_1, 0x1E);
+    busDeferredRead_t read;
+    memset(&read, 0, sizeof(read));
+    uint8_t data[6];
+    memset(data, 0x55, sizeof(data));
+
+    // Nothing to return yet, the read is queued
+    EXPECT_EQ(BUS_READ_PENDING, i2cBusReadBufferDeferred(&read, &dev, 0x03, data, sizeof(data)));
+    EXPECT_EQ(BUS_READ_PENDING, i2cBusReadBufferDeferred(&read, &dev, 0x03, data, sizeof(data)));
+    EXPECT_EQ(0x55, data[0]);
+    EXPECT_EQ((std::vector<uint8_t>{ 0x03 }), started);
+
+    // Picked up on the next call, which queues the next read
+    processUntilIdle();
+    EXPECT_EQ(BUS_READ_DONE, i2cBusReadBufferDeferred(&read, &dev, 0x03, data, sizeof(data)));
+    EXPECT_EQ(0xA3, data[0]);
+    EXPECT_EQ(0xA3, data[5]);
+    EXPECT_EQ((std::vector<uint8_t>{ 0x03, 0x03 }), started);
+
+    nackReg = 0x03;
+    processUntilIdle();
+    memset(data, 0x55, sizeof(data));
+    EXPECT_EQ(BUS_READ_FAILED, i2cBusReadBufferDeferred(&read, &dev, 0x03, data, sizeof(data)));
+    EXPECT_EQ(0x55, data[0]);
+    processUntilIdle();
+}
+
+TEST_F(BusDevI2CTest, TestDeferredReadFallsBackToBlocking)
+{
+    busDeferredRead_t read;
+    memset(&read, 0, sizeof(read));
+    uint8_t data[BUS_DEFERRED_READ_MAX_LENGTH + 1];
+
+    busDevice_t emulated = makeDevice(I2CDEV_EMULATED, 0x1E);
+    EXPECT_EQ(BUS_READ_DONE, i2cBusReadBufferDeferred(&read, &emulated, 0x03, data, 6));
+    EXPECT_EQ(0xA3, data[0]);
+    EXPECT_EQ(1u, emulatedTransfers);
+
+    // Too long for its buffer
+    busDevice_t dev = makeDevice(I2CDEV_1, 0x1E);
+    EXPECT_EQ(BUS_READ_DONE, i2cBusReadBufferDeferred(&read, &dev, 0x04, data, sizeof(data)));
+    EXPECT_EQ(0xA4, data[BUS_DEFERRED_READ_MAX_LENGTH]);
+    EXPECT_FALSE(i2cBusIsTransactionPending(&read.txn));
+}
+
+// STUBS
+
+extern "C" {
+
+bool i2cTransferStart(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *buf, bool read, bool allowRawAccess)
+{
+    UNUSED(addr);
+    UNUSED(allowRawAccess);
+    EXPECT_GE(device, 0);
+    EXPECT_LT(device, I2CDEV_COUNT);
+    if (hw[device].active) {
+        return false;
+    }
+
+    hw[device].active = true;
+    hw[device].reg = reg;
+    hw[device].len = len;
+    hw[device].buf = buf;
+    hw[device].read = read;
+    hw[device].polls = 0;
+    started.push_back(reg);
+    return true;
+}
+
+i2cTransferStatus_e i2cTransferPoll(I2CDevice device)
+{
+    fakeMicros += POLL_TIME_US;
+    if (!hw[device].active) {
+        return I2C_TRANSFER_ERROR;
+    }
+    if (++hw[device].polls < POLLS_PER_TRANSFER) {
+        return I2C_TRANSFER_BUSY;
+    }
+
+    hw[device].active = false;
+    if (hw[device].reg == nackReg) {
+        return I2C_TRANSFER_NACK;
+    }
+    if (hw[device].read) {
+        memset(hw[device].buf, 0xA0 | hw[device].reg, hw[device].len);
+    }
+    return I2C_TRANSFER_OK;
+}
+
+bool i2cRead(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, uint8_t *buf, bool allowRawAccess)
+{
+    UNUSED(addr);
+    UNUSED(allowRawAccess);
+    EXPECT_EQ(I2CDEV_EMULATED, device);
+    memset(buf, 0xA0 | reg, len);
+    emulatedTransfers++;
+    return true;
+}
+
+bool i2cWriteBuffer(I2CDevice device, uint8_t addr, uint8_t reg, uint8_t len, const uint8_t *data, bool allowRawAccess)
+{
+    UNUSED(addr);
+    UNUSED(reg);
+    UNUSED(len);
+    UNUSED(data);
+    UNUSED(allowRawAccess);
+    EXPECT_EQ(I2CDEV_EMULATED, device);
+    emulatedTransfers++;
+    return true;
+}
+
+timeUs_t micros(void)
+{
+    return fakeMicros;
+}
+
+}
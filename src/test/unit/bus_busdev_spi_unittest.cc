@@ -0,0 +1,236 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+#include "platform.h"
+#include "build/debug.h"
+#include "common/utils.h"
+#include "drivers/bus.h"
+#include "drivers/bus_spi.h"
+#include "drivers/io.h"
+#include "drivers/time.h"
+}
+
+#include "gtest/gtest.h"
+
+#define GYRO_PERIOD_US      1000
+#define NS_PER_BYTE         200     // Emulated SPI speed, including the CPU overhead
+
+static uint64_t fakeNanos;
+static SPI_TypeDef fakeInstance;
+
+static busDevice_t makeDevice(SPIDevice bus)
+{
+    busDevice_t dev;
+    memset(&dev, 0, sizeof(dev));
+    dev.busType = BUSTYPE_SPI;
+    dev.busdev.spi.spiBus = bus;
+    dev.busdev.spi.csnPin = IO_NONE;
+    return dev;
+}
+
+static void advanceUs(timeDelta_t us)
+{
+    fakeNanos += (uint64_t)us * 1000;
+}
+
+static void transfer(const busDevice_t *dev, int length)
+{
+    static uint8_t buf[8192];
+    ASSERT_LE(length, (int)sizeof(buf));
+    spiBusTransfer(dev, NULL, buf, length);
+}
+
+static void readGyro(const busDevice_t *gyro)
+{
+    uint8_t data[14];
+    spiBusReadBuffer(gyro, 0x3B | 0x80, data, sizeof(data));
+}
+
+class BusDevSpiTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        // Every test uses its own bus, the arbitration state can't be reset
+        static int nextBus = 0;
+        ASSERT_LT(nextBus, SPIDEV_COUNT);
+        bus = (SPIDevice)nextBus++;
+        gyro = makeDevice(bus);
+        osd = makeDevice(bus);
+        debugMode = DEBUG_SPI_BUS;
+        memset(debug, 0, sizeof(debug));
+        fakeNanos += 10 * 1000 * 1000;
+    }
+
+    // Returns with the next gyro read due
+    void startGyro() {
+        spiBusSetPriority(&gyro, BUS_PRIORITY_HIGH, GYRO_PERIOD_US);
+        const uint64_t start = fakeNanos;
+        readGyro(&gyro);
+        // Lets the bus measure how fast it is
+        transfer(&osd, 256);
+        fakeNanos = start + GYRO_PERIOD_US * 1000;
+    }
+
+    SPIDevice bus;
+    busDevice_t gyro;
+    busDevice_t osd;
+};
+
+TEST_F(BusDevSpiTest, TestBudgetFitsBeforeNextRead)
+{
+    startGyro();
+    EXPECT_EQ(BUS_TRANSFER_BUDGET_UNLIMITED, spiBusGetTransferBudget(&gyro));
+
+    for (int elapsedUs = 100; elapsedUs < GYRO_PERIOD_US - 100; elapsedUs += 200) {
+        readGyro(&gyro);
+        const uint64_t readAt = fakeNanos;
+        advanceUs(elapsedUs);
+
+        const int32_t budget = spiBusGetTransferBudget(&osd);
+        EXPECT_GT(budget, 0);
+        transfer(&osd, budget);
+        EXPECT_LE(fakeNanos, readAt + GYRO_PERIOD_US * 1000) << "after " << elapsedUs << "us";
+
+        // The budget isn't needlessly small either
+        EXPECT_GE(fakeNanos, readAt + (GYRO_PERIOD_US - 100) * 1000) << "after " << elapsedUs << "us";
+        fakeNanos = readAt + GYRO_PERIOD_US * 1000;
+    }
+}
+
+TEST_F(BusDevSpiTest, TestProgressWhenReadIsDue)
+{
+    EXPECT_EQ(BUS_TRANSFER_BUDGET_UNLIMITED, spiBusGetTransferBudget(&osd));
+    transfer(&osd, 512);
+    EXPECT_EQ(BUS_TRANSFER_BUDGET_UNLIMITED, spiBusGetTransferBudget(&osd));
+
+    // Registered, but not read yet
+    spiBusSetPriority(&gyro, BUS_PRIORITY_HIGH, GYRO_PERIOD_US);
+    EXPECT_EQ(BUS_TRANSFER_BUDGET_UNLIMITED, spiBusGetTransferBudget(&osd));
+
+    startGyro();
+    readGyro(&gyro);
+
+    // The gyro is overdue, other devices can still send a little
+    advanceUs(GYRO_PERIOD_US + 100);
+    const int32_t budget = spiBusGetTransferBudget(&osd);
+    EXPECT_GT(budget, 0);
+    EXPECT_LE(budget, 64);
+
+    // Until the gyro isn't being read any more
+    advanceUs(2 * GYRO_PERIOD_US);
+    EXPECT_EQ(BUS_TRANSFER_BUDGET_UNLIMITED, spiBusGetTransferBudget(&osd));
+}
+
+TEST_F(BusDevSpiTest, TestOtherReadsFromGyroChip)
+{
+    startGyro();
+    readGyro(&gyro);
+    advanceUs(300);
+
+    // An accelerometer read from the same chip doesn't move the next gyro read
+    readGyro(&gyro);
+    advanceUs(500);
+    const int32_t budget = spiBusGetTransferBudget(&osd);
+    transfer(&osd, budget);
+    EXPECT_LT(budget * NS_PER_BYTE / 1000, 200);
+}
+
+TEST_F(BusDevSpiTest, TestLatencyIsReported)
+{
+    startGyro();
+    readGyro(&gyro);
+
+    // A long transfer delays the next read by ~400us
+    advanceUs(GYRO_PERIOD_US - 100);
+    transfer(&osd, 500 * 1000 / NS_PER_BYTE);
+    readGyro(&gyro);
+    EXPECT_GE(debug[0], 400);
+    EXPECT_LE(debug[0], 420);
+    const int32_t worst = debug[0];
+
+    // On time reads only take as long as the read itself
+    for (int ii = 0; ii < 1100; ii++) {
+        advanceUs(GYRO_PERIOD_US);
+        readGyro(&gyro);
+        if (ii == 0) {
+            EXPECT_LE(debug[0], 10);
+        }
+    }
+
+    // The worst case of the last second
+    EXPECT_EQ(worst, debug[1]);
+    EXPECT_GE(debug[2], 500);
+}
+
+// STUBS
+
+extern "C" {
+
+int32_t debug[DEBUG32_VALUE_COUNT];
+uint8_t debugMode;
+
+bool spiInitDevice(SPIDevice device, bool leadingEdge)
+{
+    UNUSED(device);
+    UNUSED(leadingEdge);
+    return true;
+}
+
+SPI_TypeDef * spiInstanceByDevice(SPIDevice device)
+{
+    UNUSED(device);
+    return &fakeInstance;
+}
+
+void spiSetSpeed(SPI_TypeDef *instance, SPIClockSpeed_e speed)
+{
+    UNUSED(instance);
+    UNUSED(speed);
+}
+
+bool spiIsBusBusy(SPI_TypeDef *instance)
+{
+    UNUSED(instance);
+    return false;
+}
+
+uint8_t spiTransferByte(SPI_TypeDef *instance, uint8_t in)
+{
+    UNUSED(instance);
+    fakeNanos += NS_PER_BYTE;
+    return in;
+}
+
+bool spiTransfer(SPI_TypeDef *instance, uint8_t *rxData, const uint8_t *txData, int len)
+{
+    UNUSED(instance);
+    UNUSED(txData);
+    if (rxData) {
+        memset(rxData, 0, len);
+    }
+    fakeNanos += (uint64_t)len * NS_PER_BYTE;
+    return true;
+}
+
+void IOHi(IO_t io)
+{
+    UNUSED(io);
+}
+
+void IOLo(IO_t io)
+{
+    UNUSED(io);
+}
+
+void delayNanos(timeDelta_t ns)
+{
+    fakeNanos += ns;
+}
+
+timeUs_t micros(void)
+{
+    return fakeNanos / 1000;
+}
+
+}
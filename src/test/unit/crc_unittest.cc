@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <cstring>
+
+#ifdef UNIT_BENCHMARK
+#include <chrono>
+#include <cstdio>
+#endif
+
+extern "C" {
+#include "common/crc.h"
+#include "common/streambuf.h"
+}
+
+#include "gtest/gtest.h"
+
+// Bitwise reference implementations, as used before the table driven versions
+
+static uint16_t crc16_ccitt_ref(uint16_t crc, uint8_t a)
+{
+    crc ^= (uint16_t)a << 8;
+    for (int ii = 0; ii < 8; ++ii) {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+static uint8_t crc8_poly_ref(uint8_t crc, uint8_t a, uint8_t poly)
+{
+    crc ^= a;
+    for (int ii = 0; ii < 8; ++ii) {
+        crc = (crc & 0x80) ? (crc << 1) ^ poly : crc << 1;
+    }
+    return crc;
+}
+
+static uint8_t crc8_dvb_s2_ref(uint8_t crc, uint8_t a)
+{
+    return crc8_poly_ref(crc, a, 0xD5);
+}
+
+static uint8_t crc8_ref(uint8_t crc, uint8_t a)
+{
+    return crc8_poly_ref(crc, a, 0x07);
+}
+
+static const uint8_t checkString[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+TEST(CrcTest, TestCheckValues)
+{
+    EXPECT_EQ(0x31C3, crc16_ccitt_update(0, checkString, sizeof(checkString)));
+    EXPECT_EQ(0xBC, crc8_dvb_s2_update(0, checkString, sizeof(checkString)));
+    EXPECT_EQ(0xF4, crc8_update(0, checkString, sizeof(checkString)));
+}
+
+TEST(CrcTest, TestAllBytesAndSeeds)
+{
+    for (int crc = 0; crc < 0x10000; crc += 0x0101) {
+        for (int a = 0; a < 256; a++) {
+            EXPECT_EQ(crc16_ccitt_ref(crc, a), crc16_ccitt(crc, a));
+        }
+    }
+
+    for (int crc = 0; crc < 256; crc++) {
+        for (int a = 0; a < 256; a++) {
+            EXPECT_EQ(crc8_dvb_s2_ref(crc, a), crc8_dvb_s2(crc, a));
+            EXPECT_EQ(crc8_ref(crc, a), crc8(crc, a));
+        }
+    }
+}
+
+TEST(CrcTest, TestUpdateMatchesReference)
+{
+    uint8_t data[300];
+    uint32_t seed = 12345;
+    for (unsigned ii = 0; ii < sizeof(data); ii++) {
+        seed = seed * 1103515245 + 12345;
+        data[ii] = seed >> 16;
+    }
+
+    for (unsigned length = 0; length <= sizeof(data); length += 23) {
+        uint16_t crc16 = 0xFFFF;
+        uint8_t dvb = 0;
+        uint8_t crc8v = 0;
+        for (unsigned ii = 0; ii < length; ii++) {
+            crc16 = crc16_ccitt_ref(crc16, data[ii]);
+            dvb = crc8_dvb_s2_ref(dvb, data[ii]);
+            crc8v = crc8_ref(crc8v, data[ii]);
+        }
+        EXPECT_EQ(crc16, crc16_ccitt_update(0xFFFF, data, length));
+        EXPECT_EQ(dvb, crc8_dvb_s2_update(0, data, length));
+        EXPECT_EQ(crc8v, crc8_update(0, data, length));
+    }
+}
+
+TEST(CrcTest, TestSbufAppend)
+{
+    // CRSF style frame: CRC8 DVB-S2 over type and payload
+    uint8_t buf[16];
+    sbuf_t sbuf = { .ptr = buf, .end = buf + sizeof(buf) };
+    sbufWriteData(&sbuf, checkString, sizeof(checkString));
+    crc8_dvb_s2_sbuf_append(&sbuf, buf);
+    EXPECT_EQ(sizeof(checkString) + 1, (size_t)(sbuf.ptr - buf));
+    EXPECT_EQ(0xBC, buf[sizeof(checkString)]);
+
+    sbuf.ptr = buf;
+    sbufWriteData(&sbuf, checkString, sizeof(checkString));
+    crc16_ccitt_sbuf_append(&sbuf, buf);
+    EXPECT_EQ(sizeof(checkString) + 2, (size_t)(sbuf.ptr - buf));
+    // sbufWriteU16() is little endian
+    EXPECT_EQ(0xC3, buf[sizeof(checkString)]);
+    EXPECT_EQ(0x31, buf[sizeof(checkString) + 1]);
+}
+
+#ifdef UNIT_BENCHMARK
+// Not a pass/fail test, prints the speedup of the tables over the bitwise loops
+TEST(CrcTest, BenchmarkThroughput)
+{
+    static uint8_t data[64 * 1024];
+    for (unsigned ii = 0; ii < sizeof(data); ii++) {
+        data[ii] = ii * 7;
+    }
+
+    typedef std::chrono::steady_clock clock;
+
+    clock::time_point start = clock::now();
+    uint16_t ref16 = 0;
+    uint8_t ref8 = 0;
+    for (unsigned ii = 0; ii < sizeof(data); ii++) {
+        ref16 = crc16_ccitt_ref(ref16, data[ii]);
+        ref8 = crc8_dvb_s2_ref(ref8, data[ii]);
+    }
+    const double refUs = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+    start = clock::now();
+    const uint16_t tbl16 = crc16_ccitt_update(0, data, sizeof(data));
+    const uint8_t tbl8 = crc8_dvb_s2_update(0, data, sizeof(data));
+    const double tblUs = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+    EXPECT_EQ(ref16, tbl16);
+    EXPECT_EQ(ref8, tbl8);
+
+    printf("crc16_ccitt + crc8_dvb_s2 over %u bytes: bitwise %.0fus, table %.0fus\n",
+        (unsigned)sizeof(data), refUs, tblUs);
+}
+#endif
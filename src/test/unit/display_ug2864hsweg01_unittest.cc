@@ -0,0 +1,370 @@
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+#include "platform.h"
+#include "common/utils.h"
+#include "drivers/bus.h"
+#include "drivers/display_ug2864hsweg01.h"
+}
+
+#include "gtest/gtest.h"
+
+#define PAGES               (SCREEN_HEIGHT / 8)
+#define I2C_OVERHEAD        3       // Address, control byte and stop
+
+// Emulates the SSD1306 RAM as seen through the I2C control bytes
+static struct {
+    uint8_t ram[PAGES][SCREEN_WIDTH];
+    uint8_t page;
+    uint8_t column;
+} oled;
+
+static unsigned i2cBytes;
+static unsigned i2cTransfers;
+static unsigned maxDataLength;
+
+// Transactions kept in flight until released, to emulate a busy bus
+static bool holdTransactions;
+static busI2CTransaction_t *heldTransactions[2];
+static unsigned heldCount;
+
+static void oledCommand(uint8_t cmd)
+{
+    if (cmd >= 0xb0 && cmd <= 0xb7) {
+        oled.page = cmd - 0xb0;
+    } else if (cmd <= 0x0f) {
+        oled.column = (oled.column & 0xf0) | cmd;
+    } else if (cmd <= 0x1f) {
+        oled.column = (oled.column & 0x0f) | ((cmd & 0x0f) << 4);
+    }
+}
+
+static void oledData(uint8_t data)
+{
+    oled.ram[oled.page][oled.column] = data;
+    if (++oled.column == SCREEN_WIDTH) {
+        oled.column = 0;
+        oled.page = (oled.page + 1) % PAGES;
+    }
+}
+
+// The legacy driver sent every command and data byte in its own transfer
+static unsigned legacyCost(unsigned chars)
+{
+    return 3 * (I2C_OVERHEAD + 1) + chars * CHARACTER_WIDTH_TOTAL * (I2C_OVERHEAD + 1);
+}
+
+// Calls the driver until it has sent everything, returns the I2C bytes used
+static unsigned flush(unsigned *calls = NULL)
+{
+    const unsigned start = i2cBytes;
+    unsigned count = 0;
+    while (i2c_OLED_update()) {
+        if (++count > PAGES) {
+            ADD_FAILURE() << "display never finished updating";
+            break;
+        }
+    }
+    EXPECT_FALSE(i2c_OLED_is_dirty());
+    if (calls) {
+        *calls = count;
+    }
+    return i2cBytes - start;
+}
+
+// Renders text the way the driver does, for comparing against the display
+static void expectText(uint8_t col, uint8_t row, const char *s)
+{
+    for (unsigned ii = 0; s[ii]; ii++) {
+        i2c_OLED_set_xy(col + ii, row);
+        i2c_OLED_send_char(s[ii]);
+    }
+    // The framebuffer must not change by rendering the same text again
+    EXPECT_FALSE(i2c_OLED_is_dirty());
+}
+
+static void expectBlankPage(uint8_t page)
+{
+    for (unsigned ii = 0; ii < SCREEN_WIDTH; ii++) {
+        EXPECT_EQ(0, oled.ram[page][ii]) << "page " << (int)page << " column " << ii;
+    }
+}
+
+static void completeTransaction(busI2CTransaction_t *txn, bool ok)
+{
+    if (ok) {
+        busWriteBuf(txn->dev, txn->reg, txn->buf, txn->length);
+    }
+    txn->state = ok ? I2C_TXN_DONE : I2C_TXN_FAILED;
+    if (txn->callback) {
+        txn->callback(txn);
+    }
+}
+
+// Completes the oldest held transaction, the callback might submit the next one
+static void releaseTransaction(bool ok)
+{
+    ASSERT_GT(heldCount, 0u);
+    busI2CTransaction_t *txn = heldTransactions[0];
+    memmove(&heldTransactions[0], &heldTransactions[1], (--heldCount) * sizeof(heldTransactions[0]));
+    completeTransaction(txn, ok);
+}
+
+static void releaseTransactions(bool ok)
+{
+    while (heldCount > 0) {
+        releaseTransaction(ok);
+    }
+}
+
+class Ug2864hsweg01Test : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        memset(oled.ram, 0xAA, sizeof(oled.ram));
+        ASSERT_TRUE(ug2864hsweg01InitI2C());
+        for (unsigned page = 0; page < PAGES; page++) {
+            expectBlankPage(page);
+        }
+        i2cBytes = 0;
+        i2cTransfers = 0;
+        maxDataLength = 0;
+        holdTransactions = false;
+        heldCount = 0;
+    }
+};
+
+TEST_F(Ug2864hsweg01Test, TestTextIsSentPerPage)
+{
+    i2c_OLED_set_line(1);
+    i2c_OLED_send_string("V: 16.80");
+    i2c_OLED_set_xy(10, 3);
+    i2c_OLED_send_string("SATS: 12");
+
+    // Nothing is sent until the display is updated
+    EXPECT_EQ(0u, i2cBytes);
+    EXPECT_TRUE(i2c_OLED_is_dirty());
+
+    unsigned calls;
+    const unsigned bytes = flush(&calls);
+    EXPECT_EQ(2u, calls);
+    EXPECT_LT(bytes * 3, legacyCost(16));
+
+    expectText(0, 1, "V: 16.80");
+    expectText(10, 3, "SATS: 12");
+    expectBlankPage(0);
+    expectBlankPage(2);
+}
+
+TEST_F(Ug2864hsweg01Test, TestUnchangedTextIsNotSent)
+{
+    i2c_OLED_set_line(2);
+    i2c_OLED_send_string("ALT: 123");
+    flush();
+
+    i2c_OLED_set_line(2);
+    i2c_OLED_send_string("ALT: 123");
+    EXPECT_FALSE(i2c_OLED_is_dirty());
+    EXPECT_EQ(0u, flush());
+
+    // Only the changed character is sent
+    maxDataLength = 0;
+    i2c_OLED_set_line(2);
+    i2c_OLED_send_string("ALT: 124");
+    const unsigned bytes = flush();
+    EXPECT_LE(maxDataLength, (unsigned)CHARACTER_WIDTH_TOTAL);
+    EXPECT_LT(bytes, legacyCost(1));
+    expectText(0, 2, "ALT: 124");
+}
+
+TEST_F(Ug2864hsweg01Test, TestTransfersAreBoundedByPage)
+{
+    // A full screen bitmap wraps around the pages like the display does
+    i2c_OLED_set_line(2);
+    for (unsigned ii = 0; ii < PAGES * SCREEN_WIDTH; ii++) {
+        i2c_OLED_send_byte(ii & 0xFF ? ii : 1);
+    }
+
+    unsigned calls;
+    flush(&calls);
+    EXPECT_EQ((unsigned)PAGES, calls);
+    EXPECT_LE(maxDataLength, (unsigned)SCREEN_WIDTH);
+    EXPECT_EQ(1, oled.ram[2][0]);
+    EXPECT_EQ((PAGES * SCREEN_WIDTH - 1) & 0xFF, oled.ram[1][SCREEN_WIDTH - 1]);
+}
+
+TEST_F(Ug2864hsweg01Test, TestClearQuick)
+{
+    i2c_OLED_set_line(4);
+    i2c_OLED_send_string("STATUS");
+    flush();
+
+    i2c_OLED_clear_display_quick();
+    unsigned calls;
+    flush(&calls);
+    EXPECT_EQ(1u, calls);
+    expectBlankPage(4);
+}
+
+TEST_F(Ug2864hsweg01Test, TestInvalidate)
+{
+    i2c_OLED_set_line(5);
+    i2c_OLED_send_string("RESYNC");
+    flush();
+
+    memset(oled.ram, 0x55, sizeof(oled.ram));
+    i2c_OLED_invalidate();
+    flush();
+    expectText(0, 5, "RESYNC");
+    expectBlankPage(0);
+}
+
+TEST_F(Ug2864hsweg01Test, TestUpdateWaitsForTransfer)
+{
+    i2c_OLED_set_line(3);
+    i2c_OLED_send_string("GPS");
+    i2c_OLED_set_line(6);
+    i2c_OLED_send_string("RSSI");
+
+    holdTransactions = true;
+    EXPECT_TRUE(i2c_OLED_update());
+    EXPECT_EQ(1u, heldCount);
+
+    // The data follows the address
+    releaseTransaction(true);
+    EXPECT_EQ(1u, heldCount);
+    EXPECT_EQ(0x40, heldTransactions[0]->reg);
+
+    // Nothing else is queued while the page is on the bus
+    EXPECT_FALSE(i2c_OLED_update());
+    EXPECT_EQ(1u, heldCount);
+    EXPECT_TRUE(i2c_OLED_is_dirty());
+
+    // Drawing while the page is being sent marks it dirty again
+    i2c_OLED_set_line(3);
+    i2c_OLED_send_string("GPS FIX");
+
+    holdTransactions = false;
+    releaseTransactions(true);
+    flush();
+    expectText(0, 3, "GPS FIX");
+    expectText(0, 6, "RSSI");
+}
+
+TEST_F(Ug2864hsweg01Test, TestFailedTransferIsResent)
+{
+    i2c_OLED_set_line(7);
+    i2c_OLED_send_string("ARMED");
+
+    // The address is written, the data isn't
+    holdTransactions = true;
+    EXPECT_TRUE(i2c_OLED_update());
+    releaseTransaction(true);
+    releaseTransaction(false);
+    EXPECT_TRUE(i2c_OLED_is_dirty());
+    expectBlankPage(7);
+
+    holdTransactions = false;
+    flush();
+    expectText(0, 7, "ARMED");
+}
+
+TEST_F(Ug2864hsweg01Test, TestDataIsNotSentAfterFailedAddress)
+{
+    i2c_OLED_set_line(2);
+    i2c_OLED_send_string("LOW BATT");
+
+    holdTransactions = true;
+    EXPECT_TRUE(i2c_OLED_update());
+    releaseTransaction(false);
+
+    // The data would have gone to whatever the display pointed at
+    EXPECT_EQ(0u, heldCount);
+    EXPECT_EQ(0u, i2cTransfers);
+    EXPECT_TRUE(i2c_OLED_is_dirty());
+
+    holdTransactions = false;
+    flush();
+    expectText(0, 2, "LOW BATT");
+    for (unsigned page = 0; page < PAGES; page++) {
+        if (page != 2) {
+            expectBlankPage(page);
+        }
+    }
+}
+
+// STUBS
+
+extern "C" {
+
+static busDevice_t fakeDevice;
+
+busDevice_t * busDeviceInit(busType_e bus, devHardwareType_e hw, uint8_t tag, resourceOwner_e owner)
+{
+    UNUSED(bus);
+    UNUSED(hw);
+    UNUSED(tag);
+    UNUSED(owner);
+    return &fakeDevice;
+}
+
+bool busWriteBuf(const busDevice_t * busdev, uint8_t reg, const uint8_t * data, uint8_t length)
+{
+    UNUSED(busdev);
+    EXPECT_GT(length, 0);
+    for (unsigned ii = 0; ii < length; ii++) {
+        switch (reg) {
+        case 0x00:
+            oledCommand(data[ii]);
+            break;
+        case 0x40:
+            oledData(data[ii]);
+            break;
+        default:
+            ADD_FAILURE() << "unexpected control byte " << (int)reg;
+            break;
+        }
+    }
+    if (reg == 0x40 && length > maxDataLength) {
+        maxDataLength = length;
+    }
+    i2cBytes += I2C_OVERHEAD + length;
+    i2cTransfers++;
+    return true;
+}
+
+bool busWrite(const busDevice_t * busdev, uint8_t reg, uint8_t data)
+{
+    UNUSED(busdev);
+    if (reg == 0x80) {
+        oledCommand(data);
+        i2cBytes += I2C_OVERHEAD + 1;
+        i2cTransfers++;
+        return true;
+    }
+    return busWriteBuf(busdev, reg, &data, 1);
+}
+
+bool i2cBusSubmit(busI2CTransaction_t * txn)
+{
+    EXPECT_FALSE(i2cBusIsTransactionPending(txn));
+    EXPECT_FALSE(txn->read);
+    if (holdTransactions) {
+        if (heldCount == ARRAYLEN(heldTransactions)) {
+            ADD_FAILURE() << "too many transactions in flight";
+            return false;
+        }
+        txn->state = I2C_TXN_QUEUED;
+        heldTransactions[heldCount++] = txn;
+        return true;
+    }
+    completeTransaction(txn, true);
+    return true;
+}
+
+bool i2cBusIsTransactionPending(const busI2CTransaction_t * txn)
+{
+    return txn->state == I2C_TXN_QUEUED || txn->state == I2C_TXN_ACTIVE;
+}
+
+}
@@ -0,0 +1,287 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+#include "platform.h"
+#include "common/maths.h"
+#include "drivers/display.h"
+#include "drivers/time.h"
+#include "io/displayport_msp.h"
+#include "msp/msp_protocol.h"
+}
+
+#include "gtest/gtest.h"
+
+#define ROWS                13
+#define COLS                30
+#define MSP_FRAME_OVERHEAD  6
+
+// Emulates the display on the other end of the MSP link
+static struct {
+    char screen[ROWS][COLS];
+    unsigned draws;
+    unsigned heartbeats;
+    unsigned clears;
+} remote;
+
+static unsigned wireBytes;
+static unsigned legacyBytes;
+static uint32_t txBytesFree;
+static timeMs_t fakeMillis;
+
+static void remoteReset(char c)
+{
+    memset(remote.screen, c, sizeof(remote.screen));
+}
+
+// What the OSD expects the display to show
+static char expected[ROWS][COLS];
+
+static displayPort_t *dp;
+
+// The legacy driver sent every call straight to the wire
+static void write(int col, int row, const char *s)
+{
+    displayWrite(dp, col, row, s);
+    int len = strlen(s);
+    memcpy(&expected[row][col], s, MIN(len, COLS - col));
+    legacyBytes += MSP_FRAME_OVERHEAD + 4 + MIN(len, 30);
+}
+
+static void clear(void)
+{
+    displayClearScreen(dp);
+    memset(expected, ' ', sizeof(expected));
+    legacyBytes += MSP_FRAME_OVERHEAD + 1;
+}
+
+static void draw(void)
+{
+    displayDrawScreen(dp);
+    legacyBytes += MSP_FRAME_OVERHEAD + 1;
+}
+
+static void expectRemoteMatches(void)
+{
+    for (int row = 0; row < ROWS; row++) {
+        EXPECT_EQ(0, memcmp(expected[row], remote.screen[row], COLS))
+            << "row " << row << ": '" << std::string(expected[row], COLS)
+            << "' vs '" << std::string(remote.screen[row], COLS) << "'";
+    }
+}
+
+// A typical layout: a few static labels and values changing every frame
+static void drawLayout(int frame)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%3d%%", 99 - frame % 100);
+    write(1, 0, buf);
+    snprintf(buf, sizeof(buf), "%2d.%02dV", 16, 80 - frame % 20);
+    write(23, 0, buf);
+    write(12, 1, "ANGL");
+    snprintf(buf, sizeof(buf), "%02d:%02d", frame / 60 % 60, frame % 60);
+    write(24, 1, buf);
+    snprintf(buf, sizeof(buf), "ALT %4dM", 100 + frame % 7);
+    write(1, 6, buf);
+    snprintf(buf, sizeof(buf), "%3dKM/H", 40 + frame % 13);
+    write(22, 6, buf);
+    write(13, 7, "-+-");
+    snprintf(buf, sizeof(buf), "HOME %5dM  %3d", 1200 + frame, frame % 360);
+    write(1, 11, buf);
+    snprintf(buf, sizeof(buf), "%2d SATS", 14);
+    write(22, 11, buf);
+    snprintf(buf, sizeof(buf), "%4.1fA  %5dMAH", 12.5 + (frame % 10) / 10.0, 250 + frame * 3);
+    write(1, 12, buf);
+}
+
+class DisplayPortMspTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        static bool initialized = false;
+        if (!initialized) {
+            dp = displayPortMspInit();
+            initialized = true;
+        }
+        txBytesFree = UINT32_MAX;
+        fakeMillis += 1000;
+        remoteReset('?');
+        displayResync(dp);
+        clear();
+        draw();
+        expectRemoteMatches();
+        wireBytes = 0;
+        legacyBytes = 0;
+        remote.draws = 0;
+        remote.heartbeats = 0;
+        remote.clears = 0;
+    }
+};
+
+TEST_F(DisplayPortMspTest, TestStandardLayout)
+{
+    // Redrawn at 50Hz, values change every 100ms
+    for (int frame = 0; frame < 200; frame++) {
+        drawLayout(frame / 5);
+        draw();
+        fakeMillis += 20;
+        expectRemoteMatches();
+    }
+    EXPECT_LT(wireBytes * 4, legacyBytes);
+}
+
+TEST_F(DisplayPortMspTest, TestValuesChangingEveryFrame)
+{
+    for (int frame = 0; frame < 200; frame++) {
+        drawLayout(frame);
+        draw();
+        fakeMillis += 20;
+        expectRemoteMatches();
+    }
+    EXPECT_LT(wireBytes * 3, legacyBytes * 2);
+}
+
+TEST_F(DisplayPortMspTest, TestStaticLayout)
+{
+    drawLayout(0);
+    draw();
+    const unsigned firstFrame = wireBytes;
+    for (int frame = 0; frame < 50; frame++) {
+        drawLayout(0);
+        draw();
+        fakeMillis += 5;
+    }
+    expectRemoteMatches();
+    // Only the row refresh is sent while nothing changes
+    EXPECT_LE(wireBytes - firstFrame, 2u * (MSP_FRAME_OVERHEAD + 4 + COLS + MSP_FRAME_OVERHEAD + 1));
+}
+
+TEST_F(DisplayPortMspTest, TestFullRedraw)
+{
+    drawLayout(10);
+    draw();
+    const unsigned start = wireBytes;
+
+    // The OSD clears the screen and redraws everything on layout changes
+    clear();
+    drawLayout(10);
+    draw();
+    expectRemoteMatches();
+    EXPECT_EQ(0u, remote.clears);
+    EXPECT_LE(wireBytes - start, (unsigned)(MSP_FRAME_OVERHEAD + 4 + COLS + MSP_FRAME_OVERHEAD + 1));
+
+    // Clearing all of it is cheaper with a clear command
+    clear();
+    write(10, 5, "BYE");
+    draw();
+    expectRemoteMatches();
+    EXPECT_EQ(1u, remote.clears);
+}
+
+TEST_F(DisplayPortMspTest, TestResync)
+{
+    drawLayout(3);
+    draw();
+
+    // The display lost its contents, resync() sends all of it again
+    remoteReset('#');
+    displayResync(dp);
+    draw();
+    expectRemoteMatches();
+    EXPECT_EQ(1u, remote.clears);
+}
+
+TEST_F(DisplayPortMspTest, TestLateConnect)
+{
+    drawLayout(5);
+    draw();
+
+    // A display which connects later catches up from the row refresh
+    remoteReset('#');
+    for (int ii = 0; ii < ROWS; ii++) {
+        fakeMillis += 250;
+        draw();
+    }
+    expectRemoteMatches();
+}
+
+TEST_F(DisplayPortMspTest, TestTxBudget)
+{
+    txBytesFree = 64;
+    for (int frame = 0; frame < 3; frame++) {
+        const unsigned start = wireBytes;
+        drawLayout(frame * 17);
+        draw();
+        EXPECT_LE(wireBytes - start, txBytesFree);
+    }
+
+    // Whatever didn't fit goes out in the following updates
+    for (int ii = 0; ii < 20; ii++) {
+        draw();
+    }
+    expectRemoteMatches();
+}
+
+TEST_F(DisplayPortMspTest, TestNoDrawWithoutChanges)
+{
+    drawLayout(0);
+    draw();
+    remote.draws = 0;
+    for (int ii = 0; ii < 10; ii++) {
+        draw();
+    }
+    EXPECT_EQ(0u, remote.draws);
+}
+
+TEST_F(DisplayPortMspTest, TestHeartbeatRate)
+{
+    for (int ii = 0; ii < 100; ii++) {
+        displayHeartbeat(dp);
+        fakeMillis += 10;
+    }
+    EXPECT_EQ(2u, remote.heartbeats);
+}
+
+// STUBS
+
+extern "C" {
+
+uint8_t cliMode;
+
+int mspSerialPush(uint8_t cmd, const uint8_t *data, int datalen)
+{
+    EXPECT_EQ(MSP_DISPLAYPORT, cmd);
+    EXPECT_GE(datalen, 1);
+    wireBytes += MSP_FRAME_OVERHEAD + datalen;
+    switch (data[0]) {
+    case 0:
+        remote.heartbeats++;
+        break;
+    case 2:
+        remoteReset(' ');
+        remote.clears++;
+        break;
+    case 3:
+        EXPECT_GE(datalen, 4);
+        EXPECT_LT(data[1], ROWS);
+        EXPECT_LE(data[2] + datalen - 4, COLS);
+        memcpy(&remote.screen[data[1]][data[2]], &data[4], datalen - 4);
+        break;
+    case 4:
+        remote.draws++;
+        break;
+    }
+    return MSP_FRAME_OVERHEAD + datalen;
+}
+
+uint32_t mspSerialTxBytesFree(void)
+{
+    return txBytesFree;
+}
+
+timeMs_t millis(void)
+{
+    return fakeMillis;
+}
+
+}
@@ -0,0 +1,387 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "platform.h"
+#include "build/debug.h"
+#include "drivers/osd.h"
+#include "drivers/serial.h"
+#include "drivers/time.h"
+#include "io/frsky_osd.h"
+#include "io/serial.h"
+}
+
+#include "gtest/gtest.h"
+
+#define CMD_TRANSACTION_BEGIN       16
+#define CMD_TRANSACTION_COMMIT      17
+#define CMD_SET_STROKE_COLOR        22
+#define CMD_SET_FILL_COLOR          23
+#define CMD_SET_STROKE_AND_FILL     24
+#define CMD_SET_STROKE_WIDTH        29
+#define CMD_SET_LINE_OUTLINE_TYPE   30
+#define CMD_RESET                   43
+#define CMD_MOVE_TO_POINT           50
+#define CMD_STROKE_LINE_TO_POINT    51
+#define CMD_FILL_RECT               56
+#define CMD_CONTEXT_PUSH            100
+#define CMD_CONTEXT_POP             101
+
+typedef struct {
+    uint8_t cmd;
+    int x;
+    int y;
+} command_t;
+
+static std::vector<uint8_t> wire;
+
+// Splits the bytes sent into frames and the frames into commands
+static std::vector<command_t> decode(unsigned *frames)
+{
+    std::vector<command_t> cmds;
+    size_t pos = 0;
+    *frames = 0;
+    while (pos < wire.size()) {
+        EXPECT_EQ('$', wire[pos]);
+        EXPECT_EQ('A', wire[pos + 1]);
+        size_t len = 0;
+        int shift = 0;
+        pos += 2;
+        while (wire[pos] & 0x80) {
+            len |= (wire[pos++] & 0x7F) << shift;
+            shift += 7;
+        }
+        len |= wire[pos++] << shift;
+        const size_t end = pos + len;
+        while (pos < end) {
+            command_t c = { wire[pos++], 0, 0 };
+            size_t size = 0;
+            switch (c.cmd) {
+            case CMD_SET_STROKE_COLOR:
+            case CMD_SET_FILL_COLOR:
+            case CMD_SET_STROKE_AND_FILL:
+            case CMD_SET_STROKE_WIDTH:
+            case CMD_SET_LINE_OUTLINE_TYPE:
+                c.x = wire[pos];
+                size = 1;
+                break;
+            case CMD_MOVE_TO_POINT:
+            case CMD_STROKE_LINE_TO_POINT:
+                {
+                    frskyOSDPoint_t p;
+                    memcpy(&p, &wire[pos], sizeof(p));
+                    c.x = p.x;
+                    c.y = p.y;
+                    size = sizeof(p);
+                }
+                break;
+            case CMD_FILL_RECT:
+                size = sizeof(frskyOSDRect_t);
+                break;
+            case CMD_TRANSACTION_BEGIN:
+            case CMD_TRANSACTION_COMMIT:
+            case CMD_RESET:
+            case CMD_CONTEXT_PUSH:
+            case CMD_CONTEXT_POP:
+                break;
+            default:
+                ADD_FAILURE() << "unexpected command " << (unsigned)c.cmd;
+                return cmds;
+            }
+            pos += size;
+            cmds.push_back(c);
+        }
+        EXPECT_EQ(end, pos);
+        pos++;  // CRC
+        (*frames)++;
+    }
+    return cmds;
+}
+
+static std::vector<command_t> sent(void)
+{
+    unsigned frames;
+    return decode(&frames);
+}
+
+static unsigned countCommands(const std::vector<command_t> &cmds, uint8_t cmd)
+{
+    unsigned count = 0;
+    for (const command_t &c : cmds) {
+        if (c.cmd == cmd) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static void expectPath(const std::vector<command_t> &cmds, const std::vector<command_t> &expected)
+{
+    std::vector<command_t> path;
+    for (const command_t &c : cmds) {
+        if (c.cmd == CMD_MOVE_TO_POINT || c.cmd == CMD_STROKE_LINE_TO_POINT) {
+            path.push_back(c);
+        }
+    }
+    ASSERT_EQ(expected.size(), path.size());
+    for (size_t ii = 0; ii < path.size(); ii++) {
+        EXPECT_EQ(expected[ii].cmd, path[ii].cmd) << "at " << ii;
+        EXPECT_EQ(expected[ii].x, path[ii].x) << "at " << ii;
+        EXPECT_EQ(expected[ii].y, path[ii].y) << "at " << ii;
+    }
+}
+
+class FrSkyOSDTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        static bool initialized = false;
+        if (!initialized) {
+            frskyOSDInit(VIDEO_SYSTEM_AUTO);
+            initialized = true;
+        }
+        frskyOSDBeginTransaction(FRSKY_OSD_TRANSACTION_OPT_RESET_DRAWING);
+        frskyOSDCommitTransaction();
+        wire.clear();
+    }
+};
+
+TEST_F(FrSkyOSDTest, TestRedundantStateIsDropped)
+{
+    frskyOSDBeginTransaction((frskyOSDTransactionOptions_e)0);
+    for (int ii = 0; ii < 5; ii++) {
+        frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+        frskyOSDSetStrokeWidth(2);
+        frskyOSDSetLineOutlineType(FRSKY_OSD_OUTLINE_TYPE_BOTTOM);
+        frskyOSDFillRect(ii, 0, 4, 4);
+    }
+    frskyOSDSetFillColor(FRSKY_OSD_COLOR_WHITE);
+    // Both are already white
+    frskyOSDSetStrokeAndFillColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_BLACK);
+    frskyOSDCommitTransaction();
+
+    std::vector<command_t> cmds = sent();
+    EXPECT_EQ(2u, countCommands(cmds, CMD_SET_STROKE_COLOR));
+    EXPECT_EQ(1u, countCommands(cmds, CMD_SET_FILL_COLOR));
+    EXPECT_EQ(0u, countCommands(cmds, CMD_SET_STROKE_AND_FILL));
+    EXPECT_EQ(1u, countCommands(cmds, CMD_SET_STROKE_WIDTH));
+    EXPECT_EQ(1u, countCommands(cmds, CMD_SET_LINE_OUTLINE_TYPE));
+    EXPECT_EQ(5u, countCommands(cmds, CMD_FILL_RECT));
+
+    frskyOSDTransactionStats_t stats;
+    frskyOSDGetTransactionStats(&stats);
+    EXPECT_EQ(13u, stats.elided);
+}
+
+TEST_F(FrSkyOSDTest, TestStateIsResentWhenUnknown)
+{
+    frskyOSDBeginTransaction((frskyOSDTransactionOptions_e)0);
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDContextPush();
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_BLACK);
+    frskyOSDContextPop();
+    // Back to white on the OSD, but we don't track the stack
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDResetDrawingState();
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDCommitTransaction();
+
+    // A new transaction doesn't rely on the previous one
+    frskyOSDBeginTransaction((frskyOSDTransactionOptions_e)0);
+    frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+    frskyOSDCommitTransaction();
+
+    EXPECT_EQ(5u, countCommands(sent(), CMD_SET_STROKE_COLOR));
+}
+
+TEST_F(FrSkyOSDTest, TestCollinearLinesAreMerged)
+{
+    frskyOSDBeginTransaction((frskyOSDTransactionOptions_e)0);
+    frskyOSDMoveToPoint(0, 0);
+    frskyOSDStrokeLineToPoint(10, 0);
+    frskyOSDStrokeLineToPoint(20, 0);
+    frskyOSDStrokeLineToPoint(35, 0);
+    // Turns
+    frskyOSDStrokeLineToPoint(35, 10);
+    frskyOSDStrokeLineToPoint(40, 20);
+    frskyOSDStrokeLineToPoint(45, 30);
+    // Goes back over the same line, has to be kept
+    frskyOSDStrokeLineToPoint(42, 24);
+    frskyOSDCommitTransaction();
+
+    expectPath(sent(), {
+        { CMD_MOVE_TO_POINT, 0, 0 },
+        { CMD_STROKE_LINE_TO_POINT, 35, 0 },
+        { CMD_STROKE_LINE_TO_POINT, 35, 10 },
+        { CMD_STROKE_LINE_TO_POINT, 45, 30 },
+        { CMD_STROKE_LINE_TO_POINT, 42, 24 },
+    });
+}
+
+TEST_F(FrSkyOSDTest, TestRedundantMovesAreDropped)
+{
+    frskyOSDBeginTransaction((frskyOSDTransactionOptions_e)0);
+    frskyOSDMoveToPoint(0, 0);
+    frskyOSDMoveToPoint(-5, 7);
+    frskyOSDStrokeLineToPoint(10, 7);
+    // Already there
+    frskyOSDMoveToPoint(10, 7);
+    frskyOSDStrokeLineToPoint(10, 20);
+    // Something else was drawn, the line can't be merged anymore
+    frskyOSDFillRect(0, 0, 2, 2);
+    frskyOSDStrokeLineToPoint(10, 30);
+    frskyOSDCommitTransaction();
+
+    expectPath(sent(), {
+        { CMD_MOVE_TO_POINT, -5, 7 },
+        { CMD_STROKE_LINE_TO_POINT, 10, 7 },
+        { CMD_STROKE_LINE_TO_POINT, 10, 20 },
+        { CMD_STROKE_LINE_TO_POINT, 10, 30 },
+    });
+}
+
+TEST_F(FrSkyOSDTest, TestNoMergeAcrossFrames)
+{
+    frskyOSDBeginTransaction((frskyOSDTransactionOptions_e)0);
+    frskyOSDMoveToPoint(0, 0);
+    frskyOSDStrokeLineToPoint(1, 0);
+    // Fill up the send buffer until it's flushed
+    unsigned frames = 0;
+    while (frames == 0) {
+        frskyOSDFillRect(0, 0, 1, 1);
+        decode(&frames);
+    }
+    frskyOSDMoveToPoint(0, 5);
+    frskyOSDStrokeLineToPoint(5, 5);
+    frskyOSDFlushSendBuffer();
+    frskyOSDStrokeLineToPoint(10, 5);
+    frskyOSDCommitTransaction();
+
+    expectPath(sent(), {
+        { CMD_MOVE_TO_POINT, 0, 0 },
+        { CMD_STROKE_LINE_TO_POINT, 1, 0 },
+        { CMD_MOVE_TO_POINT, 0, 5 },
+        { CMD_STROKE_LINE_TO_POINT, 5, 5 },
+        { CMD_STROKE_LINE_TO_POINT, 10, 5 },
+    });
+}
+
+TEST_F(FrSkyOSDTest, TestHudFrameStats)
+{
+    // Something like a pitch ladder: every line sets up its own state
+    // and is stroked in segments
+    unsigned calls = 0;
+    frskyOSDBeginTransaction((frskyOSDTransactionOptions_e)0);
+    calls++;
+    for (int ii = -4; ii <= 4; ii++) {
+        const int y = ii * 20;
+        frskyOSDSetStrokeColor(FRSKY_OSD_COLOR_WHITE);
+        frskyOSDSetLineOutlineType(FRSKY_OSD_OUTLINE_TYPE_BOTTOM);
+        frskyOSDSetStrokeWidth(1);
+        frskyOSDMoveToPoint(-60, y + 5);
+        frskyOSDStrokeLineToPoint(-60, y);
+        for (int x = -50; x <= -20; x += 10) {
+            frskyOSDStrokeLineToPoint(x, y);
+        }
+        frskyOSDMoveToPoint(20, y);
+        for (int x = 30; x <= 60; x += 10) {
+            frskyOSDStrokeLineToPoint(x, y);
+        }
+        frskyOSDStrokeLineToPoint(60, y + 5);
+        calls += 3 + 2 + 4 + 1 + 4 + 1;
+    }
+    frskyOSDCommitTransaction();
+    calls++;
+
+    unsigned frames;
+    const std::vector<command_t> cmds = decode(&frames);
+    frskyOSDTransactionStats_t stats;
+    frskyOSDGetTransactionStats(&stats);
+    EXPECT_EQ(wire.size(), stats.bytes);
+    EXPECT_EQ(frames, stats.frames);
+    EXPECT_EQ(cmds.size(), stats.commands);
+    EXPECT_EQ(calls, stats.commands + stats.elided);
+    EXPECT_LT(stats.commands * 2, calls);
+}
+
+// STUBS
+
+extern "C" {
+
+int32_t debug[DEBUG32_VALUE_COUNT];
+uint8_t debugMode;
+
+const uint32_t baudRates[] = { 0, 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 230400, 250000,
+        460800, 921600, 1000000, 1500000, 2000000, 2470000 };
+
+static serialPort_t fakePort;
+static serialPortConfig_t fakePortConfig;
+
+serialPortConfig_t *findSerialPortConfig(serialPortFunction_e function)
+{
+    UNUSED(function);
+    return &fakePortConfig;
+}
+
+serialPort_t *openSerialPort(serialPortIdentifier_e identifier, serialPortFunction_e function,
+    serialReceiveCallbackPtr callback, void *rxCallbackData, uint32_t baudrate, portMode_t mode, portOptions_t options)
+{
+    UNUSED(identifier);
+    UNUSED(function);
+    UNUSED(callback);
+    UNUSED(rxCallbackData);
+    UNUSED(baudrate);
+    UNUSED(mode);
+    UNUSED(options);
+    return &fakePort;
+}
+
+void serialWrite(serialPort_t *instance, uint8_t ch)
+{
+    UNUSED(instance);
+    wire.push_back(ch);
+}
+
+uint32_t serialTxBytesFree(const serialPort_t *instance)
+{
+    UNUSED(instance);
+    return 256;
+}
+
+uint32_t serialRxBytesWaiting(const serialPort_t *instance)
+{
+    UNUSED(instance);
+    return 0;
+}
+
+uint8_t serialRead(serialPort_t *instance)
+{
+    UNUSED(instance);
+    return 0;
+}
+
+void serialSetBaudRate(serialPort_t *instance, uint32_t baudRate)
+{
+    UNUSED(instance);
+    UNUSED(baudRate);
+}
+
+void osdCharacterGridBufferClear(void)
+{
+}
+
+uint16_t *osdCharacterGridBufferGetEntryPtr(unsigned x, unsigned y)
+{
+    static uint16_t entry;
+    UNUSED(x);
+    UNUSED(y);
+    return &entry;
+}
+
+timeMs_t millis(void)
+{
+    return 0;
+}
+
+}
@@ -0,0 +1,370 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "platform.h"
+#include "drivers/bus.h"
+#include "drivers/max7456.h"
+#include "drivers/osd.h"
+#include "drivers/time.h"
+}
+
+#include "gtest/gtest.h"
+
+#define REG_VM0     0x00
+#define REG_DMM     0x04
+#define REG_DMAH    0x05
+#define REG_DMAL    0x06
+#define REG_DMDI    0x07
+#define REG_STAT    0xA0
+#define REG_READ    0x80
+
+#define DMM_AUTOINCREMENT   (1 << 0)
+#define DMM_CLEAR_DISPLAY   (1 << 2)
+#define DMM_8BIT_MODE       (1 << 6)
+#define DMAH_ATTR           (1 << 1)
+
+#define SCREEN_CHARS        MAX7456_BUFFER_CHARS_PAL
+#define MODE_EXT            (1 << 2)
+
+// Emulates the MAX7456 display memory as seen through the SPI registers
+static struct {
+    uint8_t vm0;
+    uint8_t dmm;
+    uint16_t address;
+    bool attrSelected;
+    uint8_t chr[SCREEN_CHARS];
+    uint8_t attr[SCREEN_CHARS];     // In DMDI format, bits [7:4]
+} chip;
+
+static unsigned spiBytes;
+static unsigned spiTransfers;
+static unsigned maxTransferLength;
+static int32_t transferBudget;
+static timeMs_t fakeMillis;
+
+static void chipWriteReg(uint8_t reg, uint8_t data)
+{
+    switch (reg) {
+    case REG_VM0:
+        chip.vm0 = data & ~0x02;    // Reset completes immediately
+        break;
+    case REG_DMM:
+        chip.dmm = data;
+        if (data & DMM_CLEAR_DISPLAY) {
+            memset(chip.chr, 0, sizeof(chip.chr));
+            memset(chip.attr, 0, sizeof(chip.attr));
+            chip.dmm &= ~DMM_CLEAR_DISPLAY;
+        }
+        break;
+    case REG_DMAH:
+        chip.address = (chip.address & 0xFF) | ((data & 1) << 8);
+        chip.attrSelected = data & DMAH_ATTR;
+        break;
+    case REG_DMAL:
+        chip.address = (chip.address & 0x100) | data;
+        break;
+    case REG_DMDI:
+        if ((chip.dmm & DMM_AUTOINCREMENT) && data == 0xFF) {
+            chip.dmm &= ~DMM_AUTOINCREMENT;
+            break;
+        }
+        ASSERT_LT(chip.address, SCREEN_CHARS);
+        if (!(chip.dmm & DMM_8BIT_MODE)) {
+            chip.chr[chip.address] = data;
+            chip.attr[chip.address] = (chip.dmm & 0x38) << 2;
+        } else if (chip.attrSelected) {
+            chip.attr[chip.address] = data;
+        } else {
+            chip.chr[chip.address] = data;
+        }
+        if (chip.dmm & DMM_AUTOINCREMENT) {
+            chip.address++;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Bytes the per character encoding used before auto-increment runs needs
+// to send the given cells, starting from the given DMM value
+static unsigned legacyCost(const std::vector<unsigned> &cells, uint8_t dmm)
+{
+    unsigned bytes = 0;
+    for (unsigned pos : cells) {
+        const uint8_t mode = osdCharacterGridBuffer[pos] & 0xFF;
+        if (mode & MODE_EXT) {
+            if (!(dmm & DMM_8BIT_MODE)) {
+                dmm |= DMM_8BIT_MODE;
+                bytes += 2;
+            }
+            bytes += 12;
+        } else {
+            if ((dmm & DMM_8BIT_MODE) || (dmm & 0x38) != mode) {
+                dmm = (dmm & ~(DMM_8BIT_MODE | 0x38)) | mode;
+                bytes += 2;
+            }
+            bytes += 6;
+        }
+    }
+    return bytes;
+}
+
+static bool cellMatches(unsigned pos)
+{
+    const uint16_t val = osdCharacterGridBuffer[pos];
+    if (chip.chr[pos] == (val >> 8) && chip.attr[pos] == ((val << 2) & 0xF0)) {
+        return true;
+    }
+    // Clearing the display fills it with char 0, which the driver treats as blank
+    return val == (' ' << 8) && chip.chr[pos] == 0 && chip.attr[pos] == 0;
+}
+
+static std::vector<unsigned> staleCells(void)
+{
+    std::vector<unsigned> cells;
+    for (unsigned ii = 0; ii < SCREEN_CHARS; ii++) {
+        if (!cellMatches(ii)) {
+            cells.push_back(ii);
+        }
+    }
+    return cells;
+}
+
+// Runs the driver until the screen is in sync, returns the SPI bytes used
+static unsigned flush(void)
+{
+    const unsigned startBytes = spiBytes;
+    unsigned lastTransfers;
+    do {
+        lastTransfers = spiTransfers;
+        max7456Update();
+    } while (spiTransfers != lastTransfers);
+    return spiBytes - startBytes;
+}
+
+static void expectScreenMatches(void)
+{
+    for (unsigned ii = 0; ii < SCREEN_CHARS; ii++) {
+        EXPECT_TRUE(cellMatches(ii)) << "at " << ii << ": " << std::hex << osdCharacterGridBuffer[ii]
+            << " vs " << (unsigned)chip.chr[ii] << "/" << (unsigned)chip.attr[ii];
+    }
+    // Auto-increment mode must always be left
+    EXPECT_EQ(0, chip.dmm & DMM_AUTOINCREMENT);
+}
+
+class Max7456Test : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        // The driver can only be initialized once, later tests start from a cleared screen
+        static bool initialized = false;
+        if (!initialized) {
+            max7456Init(VIDEO_SYSTEM_PAL);
+            initialized = true;
+        }
+        max7456ClearScreen();
+        flush();
+        expectScreenMatches();
+        spiBytes = 0;
+        spiTransfers = 0;
+        maxTransferLength = 0;
+        transferBudget = BUS_TRANSFER_BUDGET_UNLIMITED;
+    }
+
+    unsigned legacy;
+
+    // Flushes the changes and compares against the legacy encoding
+    unsigned compare(const char *name) {
+        const std::vector<unsigned> cells = staleCells();
+        legacy = legacyCost(cells, chip.dmm);
+        const unsigned bytes = flush();
+        expectScreenMatches();
+        EXPECT_LE(bytes, legacy) << name;
+        return bytes;
+    }
+};
+
+TEST_F(Max7456Test, TestTextRows)
+{
+    char line[MAX7456_CHARS_PER_LINE + 1];
+    for (int row = 0; row < MAX7456_LINES_PAL; row++) {
+        snprintf(line, sizeof(line), "ROW %02d ALT %4dM SPD %3dKM/H", row, row * 17, row * 3);
+        max7456Write(0, row, line, 0);
+    }
+    const unsigned bytes = compare("full screen of text");
+    EXPECT_LT(bytes * 3, legacy * 2);
+}
+
+TEST_F(Max7456Test, TestChangingValues)
+{
+    char line[16];
+    for (int row = 2; row < 12; row += 2) {
+        max7456Write(1, row, "VALUE 1234.5", 0);
+    }
+    flush();
+
+    for (int row = 2; row < 12; row += 2) {
+        snprintf(line, sizeof(line), "VALUE %4d.%d", 4321 + row, row);
+        max7456Write(1, row, line, 0);
+    }
+    const unsigned bytes = compare("changed numeric fields");
+    EXPECT_LT(bytes, legacy);
+}
+
+TEST_F(Max7456Test, TestScatteredChanges)
+{
+    for (unsigned ii = 0; ii < 20; ii++) {
+        max7456WriteChar((ii * 7) % MAX7456_CHARS_PER_LINE, ii % MAX7456_LINES_PAL, 'A' + ii, 0);
+    }
+    compare("scattered single chars");
+}
+
+TEST_F(Max7456Test, TestGapsAreBridged)
+{
+    max7456Write(0, 3, "A B C D E F G H", 0);
+    compare("chars with single gaps");
+}
+
+TEST_F(Max7456Test, TestExtendedAndAttributes)
+{
+    for (unsigned ii = 0; ii < 12; ii++) {
+        max7456WriteChar(2 + ii, 5, 0x100 + ii * 13, 0);
+    }
+    max7456Write(2, 6, "BLINKING", MAX7456_MODE_BLINK);
+    max7456Write(10, 6, "INVERT", MAX7456_MODE_INVERT);
+    max7456Write(16, 6, "PLAIN", 0);
+    for (unsigned ii = 0; ii < 6; ii++) {
+        max7456WriteChar(2 + ii, 7, 0x180 + ii, MAX7456_MODE_SOLID_BG);
+    }
+    compare("extended chars and attributes");
+}
+
+TEST_F(Max7456Test, TestEndMarkerChars)
+{
+    // 0xFF terminates auto-increment writes, it has to be sent on its own
+    for (unsigned ii = 0; ii < 10; ii++) {
+        max7456WriteChar(ii, 8, (ii % 3) ? 'X' : 0xFF, 0);
+        max7456WriteChar(ii, 9, (ii % 3) ? 0x1F0 : 0x1FF, 0);
+    }
+    compare("runs split by 0xFF");
+}
+
+TEST_F(Max7456Test, TestTransferSize)
+{
+    // A large change is spread over several updates of bounded size
+    char line[MAX7456_CHARS_PER_LINE + 1];
+    memset(line, 'Z', MAX7456_CHARS_PER_LINE);
+    line[MAX7456_CHARS_PER_LINE] = '\0';
+    for (int row = 0; row < MAX7456_LINES_PAL; row++) {
+        max7456Write(0, row, line, row & 1 ? MAX7456_MODE_BLINK : 0);
+    }
+    const unsigned start = spiTransfers;
+    compare("full screen, alternating attributes");
+    EXPECT_LE(maxTransferLength, 10u * 14u);
+    EXPECT_GT(spiTransfers - start, 1u);
+}
+
+TEST_F(Max7456Test, TestTransferBudget)
+{
+    // The bus is shared with the gyro, which is due to be read soon
+    transferBudget = 32;
+    max7456Write(0, 10, "ALT 1234M  SPD 56KM/H  HDG 270", 0);
+    for (unsigned ii = 0; ii < 8; ii++) {
+        max7456WriteChar(2 + ii * 3, 11, 0x140 + ii, MAX7456_MODE_BLINK);
+    }
+    flush();
+    expectScreenMatches();
+    EXPECT_LE(maxTransferLength, (unsigned)transferBudget);
+}
+
+TEST_F(Max7456Test, TestRefreshAll)
+{
+    max7456Write(4, 4, "REFRESH", 0);
+    max7456WriteChar(12, 4, 0x1AB, MAX7456_MODE_BLINK);
+    flush();
+    memset(chip.chr, 0xAA, sizeof(chip.chr));
+    max7456RefreshAll();
+    expectScreenMatches();
+}
+
+// STUBS
+
+extern "C" {
+
+uint16_t osdCharacterGridBuffer[OSD_CHARACTER_GRID_BUFFER_SIZE] ALIGNED(4);
+
+static busDevice_t fakeDevice;
+
+busDevice_t * busDeviceInit(busType_e bus, devHardwareType_e hw, uint8_t tag, resourceOwner_e owner)
+{
+    UNUSED(bus);
+    UNUSED(hw);
+    UNUSED(tag);
+    UNUSED(owner);
+    return &fakeDevice;
+}
+
+void busSetSpeed(const busDevice_t * dev, busSpeed_e speed)
+{
+    UNUSED(dev);
+    UNUSED(speed);
+}
+
+int32_t busGetTransferBudget(const busDevice_t * dev)
+{
+    UNUSED(dev);
+    return transferBudget;
+}
+
+bool busWrite(const busDevice_t * busdev, uint8_t reg, uint8_t data)
+{
+    UNUSED(busdev);
+    chipWriteReg(reg, data);
+    return true;
+}
+
+bool busRead(const busDevice_t * busdev, uint8_t reg, uint8_t * data)
+{
+    UNUSED(busdev);
+    switch (reg) {
+    case REG_VM0 | REG_READ:
+        *data = chip.vm0;
+        break;
+    case REG_DMM | REG_READ:
+        *data = chip.dmm;
+        break;
+    case REG_STAT:
+        *data = 0x01;   // PAL signal present
+        break;
+    default:
+        *data = 0;
+        break;
+    }
+    return true;
+}
+
+bool busTransfer(const busDevice_t * dev, uint8_t * rxBuf, const uint8_t * txBuf, int length)
+{
+    UNUSED(dev);
+    UNUSED(rxBuf);
+    EXPECT_EQ(0, length % 2);
+    for (int ii = 0; ii + 1 < length; ii += 2) {
+        chipWriteReg(txBuf[ii], txBuf[ii + 1]);
+    }
+    spiBytes += length;
+    spiTransfers++;
+    if ((unsigned)length > maxTransferLength) {
+        maxTransferLength = length;
+    }
+    return true;
+}
+
+timeMs_t millis(void)
+{
+    return fakeMillis++;
+}
+
+}
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+extern "C" {
+#include "common/maths.h"
+#include "common/median_filter.h"
+}
+
+#include "gtest/gtest.h"
+
+static int16_t referenceMedian(const int16_t *history, int count, int window)
+{
+    int16_t buf[MEDIAN_FILTER_MAX_WINDOW];
+    std::copy(history + count - window, history + count, buf);
+    std::sort(buf, buf + window);
+    return buf[window / 2];
+}
+
+TEST(MedianFilterTest, TestMatchesQuickMedian5)
+{
+    medianFilter_t filter;
+    medianFilterInit(&filter, 5);
+
+    int16_t window[5];
+    srand(1);
+    for (int i = 0; i < 1000; i++) {
+        const int16_t sample = 1000 + rand() % 1000;
+        const int16_t filtered = medianFilterApply(&filter, sample);
+        window[i % 5] = sample;
+        if (i < 4) {
+            EXPECT_EQ(sample, filtered);
+        } else {
+            EXPECT_EQ(quickMedianFilter5_16(window), filtered);
+        }
+    }
+}
+
+TEST(MedianFilterTest, TestWindowSizes)
+{
+    for (int window = 3; window <= MEDIAN_FILTER_MAX_WINDOW; window += 2) {
+        medianFilter_t filter;
+        medianFilterInit(&filter, window);
+
+        int16_t history[500];
+        srand(window);
+        for (int i = 0; i < 500; i++) {
+            // Mostly steady values with bursts of noise to exercise both paths
+            history[i] = (i / 50) % 2 ? 1000 + rand() % 1000 : 1500;
+            const int16_t filtered = medianFilterApply(&filter, history[i]);
+            if (i + 1 >= window) {
+                EXPECT_EQ(referenceMedian(history, i + 1, window), filtered);
+            }
+        }
+    }
+}
+
+TEST(MedianFilterTest, TestRejectsOutliers)
+{
+    medianFilter_t filter;
+    medianFilterInit(&filter, 5);
+
+    const int16_t input[] = { 1000, 1000, 1000, 1000, 1000, 2000, 1000, 2000, 1000, 1000 };
+    for (unsigned i = 0; i < sizeof(input) / sizeof(input[0]); i++) {
+        EXPECT_EQ(1000, medianFilterApply(&filter, input[i]));
+    }
+}
+
+TEST(MedianFilterTest, TestDisabled)
+{
+    medianFilter_t filter;
+    medianFilterInit(&filter, 1);
+
+    EXPECT_EQ(1000, medianFilterApply(&filter, 1000));
+    EXPECT_EQ(2000, medianFilterApply(&filter, 2000));
+    EXPECT_EQ(1000, medianFilterApply(&filter, 1000));
+}
@@ -0,0 +1,357 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifdef UNIT_BENCHMARK
+#include <chrono>
+#include <cstdio>
+#endif
+
+extern "C" {
+#include "platform.h"
+#include "common/maths.h"
+#include "common/utils.h"
+#include "drivers/display.h"
+#include "drivers/display_font_metadata.h"
+#include "drivers/osd_symbols.h"
+#include "io/osd.h"
+#include "io/osd_common.h"
+#include "io/osd_grid.h"
+#include "io/gps.h"
+
+osdConfig_t osdConfig_System;
+gpsSolutionData_t gpsSol;
+uint32_t GPS_distanceToHome;
+}
+
+#include "gtest/gtest.h"
+
+#define SCREEN_COLS 30
+#define SCREEN_ROWS 16
+
+// Display backed by a character grid, counting the writes which reach it
+typedef struct fakeDisplay_s {
+    uint16_t screen[SCREEN_ROWS][SCREEN_COLS];
+    unsigned writes;
+} fakeDisplay_t;
+
+static int fakeClearScreen(displayPort_t *displayPort)
+{
+    fakeDisplay_t *fake = (fakeDisplay_t *)displayPort->device;
+    for (int y = 0; y < SCREEN_ROWS; y++) {
+        for (int x = 0; x < SCREEN_COLS; x++) {
+            fake->screen[y][x] = SYM_BLANK;
+        }
+    }
+    return 0;
+}
+
+static int fakeWriteChar(displayPort_t *displayPort, uint8_t x, uint8_t y, uint16_t c, textAttributes_t attr)
+{
+    UNUSED(attr);
+    fakeDisplay_t *fake = (fakeDisplay_t *)displayPort->device;
+    if (x < SCREEN_COLS && y < SCREEN_ROWS) {
+        fake->screen[y][x] = c;
+    }
+    fake->writes++;
+    return 0;
+}
+
+static int fakeWriteString(displayPort_t *displayPort, uint8_t x, uint8_t y, const char *text, textAttributes_t attr)
+{
+    for (; *text; text++, x++) {
+        fakeWriteChar(displayPort, x, y, (uint8_t)*text, attr);
+    }
+    return 0;
+}
+
+static bool fakeReadChar(displayPort_t *displayPort, uint8_t x, uint8_t y, uint16_t *c, textAttributes_t *attr)
+{
+    fakeDisplay_t *fake = (fakeDisplay_t *)displayPort->device;
+    if (x >= SCREEN_COLS || y >= SCREEN_ROWS) {
+        return false;
+    }
+    *c = fake->screen[y][x];
+    *attr = TEXT_ATTRIBUTES_NONE;
+    return true;
+}
+
+static bool fakeIsReady(displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+    return true;
+}
+
+static bool fakeGetFontMetadata(displayFontMetadata_t *metadata, const displayPort_t *displayPort)
+{
+    UNUSED(displayPort);
+    metadata->charCount = 512;
+    metadata->version = 0;
+    return true;
+}
+
+static const displayPortVTable_t fakeVTable = {
+    .grab = NULL,
+    .release = NULL,
+    .clearScreen = fakeClearScreen,
+    .drawScreen = NULL,
+    .screenSize = NULL,
+    .writeString = fakeWriteString,
+    .writeChar = fakeWriteChar,
+    .readChar = fakeReadChar,
+    .isTransferInProgress = NULL,
+    .heartbeat = NULL,
+    .resync = NULL,
+    .txBytesFree = NULL,
+    .supportedTextAttributes = NULL,
+    .getFontMetadata = fakeGetFontMetadata,
+    .writeFontCharacter = NULL,
+    .isReady = fakeIsReady,
+    .beginTransaction = NULL,
+    .commitTransaction = NULL,
+    .getCanvas = NULL,
+};
+
+static void fakeDisplayInit(displayPort_t *display, fakeDisplay_t *fake)
+{
+    memset(display, 0, sizeof(*display));
+    memset(fake, 0, sizeof(*fake));
+    osdConfigMutable()->ahi_max_pitch = 20;
+    display->device = fake;
+    display->rows = SCREEN_ROWS;
+    display->cols = SCREEN_COLS;
+    displayInit(display, &fakeVTable);
+    fake->writes = 0;
+}
+
+// Previous implementation: float math for every cell, erases and redraws
+// the whole line on each call
+static void legacyDrawArtificialHorizon(displayPort_t *display, float pitchAngle, float rollAngle)
+{
+    uint8_t elemPosX;
+    uint8_t elemPosY;
+
+    osdCrosshairPosition(&elemPosX, &elemPosY);
+
+    static int8_t previous_written[OSD_AHI_PREV_SIZE];
+    static int8_t previous_orient = -1;
+
+    const float pitch_rad_to_char = (float)(OSD_AHI_HEIGHT / 2 + 0.5) / DEGREES_TO_RADIANS(osdConfig()->ahi_max_pitch);
+
+    const float ky = sin_approx(rollAngle);
+    const float kx = cos_approx(rollAngle);
+    const float ratio = 12.0f/15.0f;
+
+    if (previous_orient != -1) {
+        for (int i = 0; i < OSD_AHI_PREV_SIZE; ++i) {
+            if (previous_written[i] > -1) {
+                int8_t dx = (previous_orient ? previous_written[i] : i) - OSD_AHI_PREV_SIZE / 2;
+                int8_t dy = (previous_orient ? i : previous_written[i]) - OSD_AHI_PREV_SIZE / 2;
+                displayWriteChar(display, elemPosX + dx, elemPosY - dy, SYM_BLANK);
+                previous_written[i] = -1;
+            }
+        }
+    }
+
+    if (fabsf(ky) < fabsf(kx)) {
+        previous_orient = 0;
+        for (int8_t dx = -OSD_AHI_WIDTH / 2; dx <= OSD_AHI_WIDTH / 2; dx++) {
+            float fy = (ratio * dx) * (ky / kx) + pitchAngle * pitch_rad_to_char + 0.49f;
+            int8_t dy = floorf(fy);
+            const uint8_t chX = elemPosX + dx, chY = elemPosY - dy;
+            uint16_t c;
+
+            if ((dy >= -OSD_AHI_HEIGHT / 2) && (dy <= OSD_AHI_HEIGHT / 2) && displayReadCharWithAttr(display, chX, chY, &c, NULL) && (c == SYM_BLANK)) {
+                c = SYM_AH_H_START + ((OSD_AHI_H_SYM_COUNT - 1) - (uint8_t)((fy - dy) * OSD_AHI_H_SYM_COUNT));
+                displayWriteChar(display, elemPosX + dx, elemPosY - dy, c);
+                previous_written[dx + OSD_AHI_PREV_SIZE / 2] = dy + OSD_AHI_PREV_SIZE / 2;
+            }
+        }
+    } else {
+        previous_orient = 1;
+        for (int8_t dy = -OSD_AHI_HEIGHT / 2; dy <= OSD_AHI_HEIGHT / 2; dy++) {
+            const float fx = ((dy / ratio) - pitchAngle * pitch_rad_to_char) * (kx / ky) + 0.5f;
+            const int8_t dx = floorf(fx);
+            const uint8_t chX = elemPosX + dx, chY = elemPosY - dy;
+            uint16_t c;
+
+            if ((dx >= -OSD_AHI_WIDTH / 2) && (dx <= OSD_AHI_WIDTH / 2) && displayReadCharWithAttr(display, chX, chY, &c, NULL) && (c == SYM_BLANK)) {
+                c = SYM_AH_V_START + (fx - dx) * OSD_AHI_V_SYM_COUNT;
+                displayWriteChar(display, chX, chY, c);
+                previous_written[dy + OSD_AHI_PREV_SIZE / 2] = dx + OSD_AHI_PREV_SIZE / 2;
+            }
+        }
+    }
+}
+
+// Attitude at frame n of a flight: level hover, gentle turns, then
+// aggressive rolls through the vertical orientation
+static void attitudeAt(int frame, float *roll, float *pitch)
+{
+    if (frame < 200) {
+        *roll = 0;
+        *pitch = DEGREES_TO_RADIANS(2);
+    } else if (frame < 600) {
+        *roll = DEGREES_TO_RADIANS(25 * sinf(frame * 0.02f));
+        *pitch = DEGREES_TO_RADIANS(5 * sinf(frame * 0.013f));
+    } else {
+        *roll = DEGREES_TO_RADIANS(170 * sinf(frame * 0.05f));
+        *pitch = DEGREES_TO_RADIANS(15 * sinf(frame * 0.031f));
+    }
+}
+
+#define FLIGHT_FRAMES 1000
+
+static unsigned countDifferences(const fakeDisplay_t *a, const fakeDisplay_t *b)
+{
+    unsigned diff = 0;
+    for (int y = 0; y < SCREEN_ROWS; y++) {
+        for (int x = 0; x < SCREEN_COLS; x++) {
+            diff += a->screen[y][x] != b->screen[y][x];
+        }
+    }
+    return diff;
+}
+
+TEST(OsdGridTest, TestMatchesLegacyRendering)
+{
+    displayPort_t legacyDisplay, display;
+    fakeDisplay_t legacyFake, fake;
+    fakeDisplayInit(&legacyDisplay, &legacyFake);
+    fakeDisplayInit(&display, &fake);
+
+    unsigned differentFrames = 0;
+    for (int frame = 0; frame < FLIGHT_FRAMES; frame++) {
+        float roll, pitch;
+        attitudeAt(frame, &roll, &pitch);
+        legacyDrawArtificialHorizon(&legacyDisplay, pitch, roll);
+        osdGridDrawArtificialHorizon(&display, 0, 0, pitch, roll);
+        const unsigned diff = countDifferences(&legacyFake, &fake);
+        // Fixed point rounding might pick the neighbouring glyph in a cell
+        EXPECT_LE(diff, 2u) << "frame " << frame;
+        differentFrames += diff > 0;
+    }
+    EXPECT_LE(differentFrames, FLIGHT_FRAMES / 100);
+
+    // Only the cells that changed are written
+    EXPECT_LT(fake.writes * 2, legacyFake.writes);
+}
+
+TEST(OsdGridTest, TestLevelHorizonNeedsNoWrites)
+{
+    displayPort_t display;
+    fakeDisplay_t fake;
+    fakeDisplayInit(&display, &fake);
+
+    osdGridDrawArtificialHorizon(&display, 0, 0, 0, 0);
+    const unsigned firstWrites = fake.writes;
+    EXPECT_GT(firstWrites, 0u);
+    osdGridDrawArtificialHorizon(&display, 0, 0, 0, 0);
+    EXPECT_EQ(firstWrites, fake.writes);
+}
+
+TEST(OsdGridTest, TestOtherElementsAreKept)
+{
+    displayPort_t display;
+    fakeDisplay_t fake;
+    fakeDisplayInit(&display, &fake);
+
+    uint8_t cx, cy;
+    osdCrosshairPosition(&cx, &cy);
+
+    osdGridDrawArtificialHorizon(&display, 0, 0, 0, 0);
+    // Another element draws over the line, then the horizon moves away
+    displayWriteChar(&display, cx + 3, cy, 'X');
+    osdGridDrawArtificialHorizon(&display, 0, 0, DEGREES_TO_RADIANS(10), 0);
+    uint16_t c;
+    displayReadCharWithAttr(&display, cx + 3, cy, &c, NULL);
+    EXPECT_EQ('X', c);
+
+    // After clearing the screen everything is drawn again
+    displayClearScreen(&display);
+    osdGridDrawArtificialHorizon(&display, 0, 0, DEGREES_TO_RADIANS(10), 0);
+    unsigned drawn = 0;
+    for (int y = 0; y < SCREEN_ROWS; y++) {
+        for (int x = 0; x < SCREEN_COLS; x++) {
+            drawn += fake.screen[y][x] != SYM_BLANK;
+        }
+    }
+    EXPECT_EQ((unsigned)OSD_AHI_WIDTH, drawn);
+}
+
+#ifdef UNIT_BENCHMARK
+// Not a pass/fail test, prints the time spent rendering a flight
+TEST(OsdGridTest, BenchmarkArtificialHorizon)
+{
+    displayPort_t legacyDisplay, display;
+    fakeDisplay_t legacyFake, fake;
+    fakeDisplayInit(&legacyDisplay, &legacyFake);
+    fakeDisplayInit(&display, &fake);
+
+    typedef std::chrono::steady_clock clock;
+    const int repeats = 20;
+
+    clock::time_point start = clock::now();
+    for (int ii = 0; ii < repeats; ii++) {
+        for (int frame = 0; frame < FLIGHT_FRAMES; frame++) {
+            float roll, pitch;
+            attitudeAt(frame, &roll, &pitch);
+            legacyDrawArtificialHorizon(&legacyDisplay, pitch, roll);
+        }
+    }
+    const double legacyUs = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+    start = clock::now();
+    for (int ii = 0; ii < repeats; ii++) {
+        for (int frame = 0; frame < FLIGHT_FRAMES; frame++) {
+            float roll, pitch;
+            attitudeAt(frame, &roll, &pitch);
+            osdGridDrawArtificialHorizon(&display, 0, 0, pitch, roll);
+        }
+    }
+    const double us = std::chrono::duration<double, std::micro>(clock::now() - start).count();
+
+    printf("AHI render of %d frames: %.0fus (%u writes), was %.0fus (%u writes)\n",
+        repeats * FLIGHT_FRAMES, us, fake.writes, legacyUs, legacyFake.writes);
+}
+#endif
+
+// STUBS
+
+extern "C" {
+
+static timeMs_t fakeMillis;
+
+timeMs_t millis(void)
+{
+    return fakeMillis++;
+}
+
+void osdCrosshairPosition(uint8_t *x, uint8_t *y)
+{
+    *x = SCREEN_COLS / 2;
+    *y = SCREEN_ROWS / 2;
+}
+
+bool osdDisplayIsPAL(void)
+{
+    return true;
+}
+
+int32_t osdGetAltitude(void)
+{
+    return 0;
+}
+
+int osdGetHeadingAngle(int angle)
+{
+    while (angle < 0) {
+        angle += 360;
+    }
+    while (angle >= 360) {
+        angle -= 360;
+    }
+    return angle;
+}
+
+}
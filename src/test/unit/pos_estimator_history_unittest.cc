@@ -0,0 +1,426 @@
+#include <cmath>
+#include <cstdint>
+
+extern "C" {
+#include "common/time.h"
+#include "common/vector.h"
+#include "navigation/navigation_pos_estimator_history.h"
+}
+
+#include "gtest/gtest.h"
+
+static fpVector3_t vec(float x, float y, float z)
+{
+    fpVector3_t v;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    return v;
+}
+
+TEST(PosEstimatorHistoryTest, TestEmpty)
+{
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    const fpVector3_t est = vec(1, 2, 3);
+    fpVector3_t pos, vel;
+    EXPECT_FALSE(posEstimatorHistoryGet(&history, 1000, &est, &est, 2000, &pos, &vel));
+
+    // Not delayed, the current estimate
+    ASSERT_TRUE(posEstimatorHistoryGet(&history, 2000, &est, &est, 2000, &pos, &vel));
+    EXPECT_FLOAT_EQ(2.0f, pos.y);
+}
+
+TEST(PosEstimatorHistoryTest, TestStoreRateLimited)
+{
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    const fpVector3_t zero = vec(0, 0, 0);
+    for (timeUs_t t = 0; t < 100 * POS_ESTIMATOR_HISTORY_INTERVAL_US; t += 1000) {
+        posEstimatorHistoryStore(&history, t, &zero, &zero);
+    }
+
+    EXPECT_EQ(POS_ESTIMATOR_HISTORY_SIZE, history.count);
+}
+
+TEST(PosEstimatorHistoryTest, TestInterpolation)
+{
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    // Position ramps at 100cm/s, one sample every interval
+    for (int i = 0; i < 10; i++) {
+        const timeUs_t t = i * POS_ESTIMATOR_HISTORY_INTERVAL_US;
+        const fpVector3_t pos = vec(US2S(t) * 100.0f, 0, i);
+        const fpVector3_t vel = vec(100.0f, 0, 0);
+        posEstimatorHistoryStore(&history, t, &pos, &vel);
+    }
+
+    // The current estimate, half an interval after the last sample
+    const timeUs_t now = 19 * POS_ESTIMATOR_HISTORY_INTERVAL_US / 2;
+    const fpVector3_t estPos = vec(US2S(now) * 100.0f, 0, 9.5f);
+    const fpVector3_t estVel = vec(100.0f, 0, 0);
+    fpVector3_t pos, vel;
+
+    ASSERT_TRUE(posEstimatorHistoryGet(&history, 7 * POS_ESTIMATOR_HISTORY_INTERVAL_US / 2, &estPos, &estVel, now, &pos, &vel));
+    EXPECT_FLOAT_EQ(US2S(7 * POS_ESTIMATOR_HISTORY_INTERVAL_US / 2) * 100.0f, pos.x);
+    EXPECT_FLOAT_EQ(3.5f, pos.z);
+    EXPECT_FLOAT_EQ(100.0f, vel.x);
+
+    ASSERT_TRUE(posEstimatorHistoryGet(&history, 0, &estPos, &estVel, now, &pos, &vel));
+    EXPECT_FLOAT_EQ(0.0f, pos.x);
+
+    // Between the last sample and the current estimate
+    const timeUs_t t = 9 * POS_ESTIMATOR_HISTORY_INTERVAL_US + POS_ESTIMATOR_HISTORY_INTERVAL_US / 4;
+    ASSERT_TRUE(posEstimatorHistoryGet(&history, t, &estPos, &estVel, now, &pos, &vel));
+    EXPECT_FLOAT_EQ(US2S(t) * 100.0f, pos.x);
+    EXPECT_FLOAT_EQ(9.25f, pos.z);
+    EXPECT_FLOAT_EQ(100.0f, vel.x);
+
+    // Not older than the current estimate returns it
+    ASSERT_TRUE(posEstimatorHistoryGet(&history, 100 * POS_ESTIMATOR_HISTORY_INTERVAL_US, &estPos, &estVel, now, &pos, &vel));
+    EXPECT_FLOAT_EQ(estPos.x, pos.x);
+}
+
+TEST(PosEstimatorHistoryTest, TestTooOld)
+{
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    const fpVector3_t zero = vec(0, 0, 0);
+    for (int i = 1; i <= 2 * POS_ESTIMATOR_HISTORY_SIZE; i++) {
+        posEstimatorHistoryStore(&history, i * POS_ESTIMATOR_HISTORY_INTERVAL_US, &zero, &zero);
+    }
+
+    fpVector3_t pos, vel;
+    const timeUs_t now = (2 * POS_ESTIMATOR_HISTORY_SIZE + 1) * POS_ESTIMATOR_HISTORY_INTERVAL_US;
+    const timeUs_t oldest = (POS_ESTIMATOR_HISTORY_SIZE + 1) * POS_ESTIMATOR_HISTORY_INTERVAL_US;
+    EXPECT_TRUE(posEstimatorHistoryGet(&history, oldest, &zero, &zero, now, &pos, &vel));
+    EXPECT_FALSE(posEstimatorHistoryGet(&history, oldest - 1, &zero, &zero, now, &pos, &vel));
+
+    // Falls back to the current estimate
+    const fpVector3_t estPos = vec(7, 8, 9);
+    EXPECT_FALSE(posEstimatorHistoryGet(&history, oldest - 1, &estPos, &zero, now, &pos, &vel));
+    EXPECT_FLOAT_EQ(8.0f, pos.y);
+}
+
+TEST(PosEstimatorHistoryTest, TestCorrectionShiftsPastStates)
+{
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    fpVector3_t pos = vec(0, 0, 0);
+    fpVector3_t vel = vec(0, 0, 0);
+    const fpVector3_t posCorr = vec(1, 2, 3);
+    const fpVector3_t velCorr = vec(-1, 0, 0);
+
+    // Apply a correction on every step, across several ring wraps
+    for (int i = 0; i < 5 * POS_ESTIMATOR_HISTORY_SIZE; i++) {
+        vectorAdd(&pos, &pos, &posCorr);
+        vectorAdd(&vel, &vel, &velCorr);
+        posEstimatorHistoryApplyCorrection(&history, &posCorr, &velCorr);
+        posEstimatorHistoryStore(&history, i * POS_ESTIMATOR_HISTORY_INTERVAL_US, &pos, &vel);
+    }
+
+    // All past states have been moved along with the estimate
+    fpVector3_t histPos, histVel;
+    for (int age = 0; age < POS_ESTIMATOR_HISTORY_SIZE; age++) {
+        const timeUs_t t = (5 * POS_ESTIMATOR_HISTORY_SIZE - 1 - age) * POS_ESTIMATOR_HISTORY_INTERVAL_US;
+        ASSERT_TRUE(posEstimatorHistoryGet(&history, t, &pos, &vel, 5 * POS_ESTIMATOR_HISTORY_SIZE * POS_ESTIMATOR_HISTORY_INTERVAL_US, &histPos, &histVel));
+        EXPECT_NEAR(pos.x, histPos.x, 1e-3f);
+        EXPECT_NEAR(pos.y, histPos.y, 1e-3f);
+        EXPECT_NEAR(pos.z, histPos.z, 1e-3f);
+        EXPECT_NEAR(vel.x, histVel.x, 1e-3f);
+    }
+}
+
+/*
+ * Replay a synthetic trajectory along X through the estimator's XY correction, with
+ * position measurements that arrive late. The measurements are either stamped with
+ * the time they were taken or, as if there was no delay, with their arrival time.
+ * Returns the RMS position error.
+ */
+static float replayDelayedMeasurements(bool stampMeasurementTime, timeUs_t delayUs)
+{
+    const timeUs_t loopUs = 1000;
+    const timeUs_t measIntervalUs = 100000;
+    const float w_p = 2.0f;
+    const float accBias = 20.0f;            // cm/s/s
+    const float amplitude = 500.0f;         // cm
+    const float omega = 2.0f * M_PIf * 0.5f;
+
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    fpVector3_t estPos = vec(0, 0, 0);
+    fpVector3_t estVel = vec(amplitude * omega, 0, 0);
+
+    posEstimatorDelayedMeasurement_t meas;
+    meas.pos = vec(0, 0, 0);
+    meas.vel = vec(0, 0, 0);
+    meas.velValid = false;
+    meas.time = 0;
+    timeUs_t lastMeasArrival = 0;
+
+    double errSq = 0;
+    int errCount = 0;
+
+    for (timeUs_t t = loopUs; t < 20000000; t += loopUs) {
+        const float dt = US2S(loopUs);
+        const float ts = US2S(t);
+
+        // New measurement of the position as it was delayUs ago
+        if (t >= delayUs && t - lastMeasArrival >= measIntervalUs) {
+            const timeUs_t measTime = t - delayUs;
+            meas.pos.x = amplitude * sinf(omega * US2S(measTime));
+            meas.time = stampMeasurementTime ? measTime : t;
+            lastMeasArrival = t;
+        }
+
+        // Prediction
+        const float acc = -amplitude * omega * omega * sinf(omega * ts) + accBias;
+        estPos.x += estVel.x * dt + acc * dt * dt / 2.0f;
+        estVel.x += acc * dt;
+
+        // Correction
+        fpVector3_t posCorr = vec(0, 0, 0);
+        fpVector3_t velCorr = vec(0, 0, 0);
+        fpVector3_t accBiasCorr = vec(0, 0, 0);
+        posEstimatorHistoryCorrectXY(&history, &meas, &estPos, &estVel, t, w_p, 0.0f, dt, &posCorr, &velCorr, &accBiasCorr);
+
+        vectorAdd(&estPos, &estPos, &posCorr);
+        vectorAdd(&estVel, &estVel, &velCorr);
+        posEstimatorHistoryApplyCorrection(&history, &posCorr, &velCorr);
+        posEstimatorHistoryStore(&history, t, &estPos, &estVel);
+
+        // Skip the initial convergence
+        if (t > 5000000) {
+            errSq += sq(estPos.x - amplitude * sinf(omega * ts));
+            errCount++;
+        }
+    }
+
+    return sqrtf(errSq / errCount);
+}
+
+TEST(PosEstimatorHistoryTest, TestDelayedMeasurementReplay)
+{
+    const timeUs_t delays[] = { 50000, 100000, 200000 };
+
+    for (unsigned i = 0; i < sizeof(delays) / sizeof(delays[0]); i++) {
+        const float errArrival = replayDelayedMeasurements(false, delays[i]);
+        const float errMeasurement = replayDelayedMeasurements(true, delays[i]);
+
+        EXPECT_LT(errMeasurement, errArrival * 0.5f) << "delay " << delays[i] << "us";
+    }
+}
+
+TEST(PosEstimatorHistoryTest, TestCorrectXYWithoutHistory)
+{
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    posEstimatorDelayedMeasurement_t meas;
+    meas.pos = vec(300, -400, 1000);
+    meas.vel = vec(10, 0, 0);
+    meas.velValid = true;
+    meas.time = 1000000;
+
+    const fpVector3_t estPos = vec(0, 0, 0);
+    const fpVector3_t estVel = vec(0, 0, 0);
+    fpVector3_t posCorr = vec(0, 0, 0);
+    fpVector3_t velCorr = vec(0, 0, 0);
+    fpVector3_t accBiasCorr = vec(0, 0, 0);
+
+    // Nothing stored, the residuals are taken against the current estimate
+    const float residual = posEstimatorHistoryCorrectXY(&history, &meas, &estPos, &estVel, meas.time, 1.0f, 2.0f, 0.01f, &posCorr, &velCorr, &accBiasCorr);
+    EXPECT_NEAR(500.0f, residual, 1.0f);
+    EXPECT_FLOAT_EQ(3.0f, posCorr.x);
+    EXPECT_FLOAT_EQ(-4.0f, posCorr.y);
+    EXPECT_FLOAT_EQ(0.0f, posCorr.z);
+    EXPECT_FLOAT_EQ(3.0f + 0.2f, velCorr.x);
+    EXPECT_FLOAT_EQ(-4.0f, velCorr.y);
+    EXPECT_FLOAT_EQ(-300.0f, accBiasCorr.x);
+    EXPECT_FLOAT_EQ(400.0f, accBiasCorr.y);
+}
+
+/*
+ * Fixed wing turning at 20m/s on a 60m radius with a 5Hz GPS that reports position
+ * and velocity fixDelayUs late, fused through the estimator's XY correction
+ * (inav_w_xy_gps_p = 1, inav_w_xy_gps_v = 2) with a biased accelerometer. The fixes
+ * are either stamped with the time they were taken or with their arrival time.
+ * Returns the RMS position error.
+ */
+static float replayGpsTurn(bool stampFixTime, timeUs_t fixDelayUs)
+{
+    const timeUs_t loopUs = 1000;
+    const timeUs_t fixIntervalUs = 200000;
+    const float w_p = 1.0f;
+    const float w_v = 2.0f;
+    const float radius = 6000.0f;
+    const float omega = 2000.0f / radius;
+    const float accBias = 30.0f;            // cm/s/s
+
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    fpVector3_t estPos = vec(radius, 0, 0);
+    fpVector3_t estVel = vec(0, radius * omega, 0);
+
+    posEstimatorDelayedMeasurement_t fix;
+    fix.pos = estPos;
+    fix.vel = estVel;
+    fix.velValid = true;
+    fix.time = 0;
+    timeUs_t lastFixArrival = 0;
+
+    double errSq = 0;
+    int errCount = 0;
+
+    for (timeUs_t t = loopUs; t < 30000000; t += loopUs) {
+        const float dt = US2S(loopUs);
+        const float ts = US2S(t);
+
+        if (t >= fixDelayUs && t - lastFixArrival >= fixIntervalUs) {
+            const timeUs_t fixTime = t - fixDelayUs;
+            const float a = omega * US2S(fixTime);
+            fix.pos = vec(radius * cosf(a), radius * sinf(a), 0);
+            fix.vel = vec(-radius * omega * sinf(a), radius * omega * cosf(a), 0);
+            fix.time = stampFixTime ? fixTime : t;
+            lastFixArrival = t;
+        }
+
+        // Prediction with centripetal acceleration
+        const fpVector3_t acc = vec(-radius * omega * omega * cosf(omega * ts) + accBias, -radius * omega * omega * sinf(omega * ts) - accBias, 0);
+        for (int axis = 0; axis < 2; axis++) {
+            estPos.v[axis] += estVel.v[axis] * dt + acc.v[axis] * dt * dt / 2.0f;
+            estVel.v[axis] += acc.v[axis] * dt;
+        }
+
+        fpVector3_t posCorr = vec(0, 0, 0);
+        fpVector3_t velCorr = vec(0, 0, 0);
+        fpVector3_t accBiasCorr = vec(0, 0, 0);
+        posEstimatorHistoryCorrectXY(&history, &fix, &estPos, &estVel, t, w_p, w_v, dt, &posCorr, &velCorr, &accBiasCorr);
+
+        vectorAdd(&estPos, &estPos, &posCorr);
+        vectorAdd(&estVel, &estVel, &velCorr);
+        posEstimatorHistoryApplyCorrection(&history, &posCorr, &velCorr);
+        posEstimatorHistoryStore(&history, t, &estPos, &estVel);
+
+        if (t > 5000000) {
+            errSq += sq(estPos.x - radius * cosf(omega * ts)) + sq(estPos.y - radius * sinf(omega * ts));
+            errCount++;
+        }
+    }
+
+    return sqrtf(errSq / errCount);
+}
+
+TEST(PosEstimatorHistoryTest, TestDelayedGpsTurnReplay)
+{
+    const timeUs_t delays[] = { 100000, 150000, 200000 };
+
+    for (unsigned i = 0; i < sizeof(delays) / sizeof(delays[0]); i++) {
+        const float errArrival = replayGpsTurn(false, delays[i]);
+        const float errFixTime = replayGpsTurn(true, delays[i]);
+
+        EXPECT_LT(errFixTime, errArrival * 0.1f) << "delay " << delays[i] << "us";
+    }
+}
+
+TEST(PosEstimatorHistoryTest, TestCorrectionIsRepropagated)
+{
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    // Standing still at the origin
+    const fpVector3_t zero = vec(0, 0, 0);
+    for (int i = 0; i < 10; i++) {
+        posEstimatorHistoryStore(&history, i * POS_ESTIMATOR_HISTORY_INTERVAL_US, &zero, &zero);
+    }
+
+    // A fix from 100ms ago says we were moving
+    posEstimatorDelayedMeasurement_t fix;
+    fix.pos = zero;
+    fix.vel = vec(100, 0, 0);
+    fix.velValid = true;
+    fix.time = 4 * POS_ESTIMATOR_HISTORY_INTERVAL_US;
+
+    const timeUs_t now = 9 * POS_ESTIMATOR_HISTORY_INTERVAL_US;
+    fpVector3_t posCorr = zero;
+    fpVector3_t velCorr = zero;
+    fpVector3_t accBiasCorr = zero;
+    EXPECT_FLOAT_EQ(0.0f, posEstimatorHistoryCorrectXY(&history, &fix, &zero, &zero, now, 1.0f, 2.0f, 0.01f, &posCorr, &velCorr, &accBiasCorr));
+
+    // The velocity correction, carried over the 100ms since the fix
+    EXPECT_FLOAT_EQ(2.0f, velCorr.x);
+    EXPECT_FLOAT_EQ(2.0f * 0.1f, posCorr.x);
+    EXPECT_FLOAT_EQ(0.0f, accBiasCorr.x);
+
+    // Not further than the history reaches back
+    EXPECT_FLOAT_EQ(POS_ESTIMATOR_HISTORY_SIZE * US2S(POS_ESTIMATOR_HISTORY_INTERVAL_US), posEstimatorHistoryMeasurementAge(now + 10000000, now));
+    EXPECT_FLOAT_EQ(0.0f, posEstimatorHistoryMeasurementAge(now, now + 1000));
+}
+
+TEST(PosEstimatorHistoryTest, TestUndelayedMeasurement)
+{
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    // Moving at 100cm/s, the last sample is 15ms old
+    const fpVector3_t vel = vec(100, 0, 0);
+    for (int i = 0; i < 10; i++) {
+        const timeUs_t t = i * POS_ESTIMATOR_HISTORY_INTERVAL_US;
+        const fpVector3_t pos = vec(US2S(t) * 100.0f, 0, 0);
+        posEstimatorHistoryStore(&history, t, &pos, &vel);
+    }
+    const timeUs_t now = 9 * POS_ESTIMATOR_HISTORY_INTERVAL_US + 15000;
+    const fpVector3_t estPos = vec(US2S(now) * 100.0f, 0, 0);
+
+    // A fix taken now which agrees with the estimate doesn't correct anything
+    posEstimatorDelayedMeasurement_t fix;
+    fix.pos = estPos;
+    fix.vel = vel;
+    fix.velValid = true;
+    fix.time = now;
+
+    fpVector3_t posCorr = vec(0, 0, 0);
+    fpVector3_t velCorr = vec(0, 0, 0);
+    fpVector3_t accBiasCorr = vec(0, 0, 0);
+    EXPECT_FLOAT_EQ(0.0f, posEstimatorHistoryCorrectXY(&history, &fix, &estPos, &vel, now, 1.0f, 2.0f, 0.01f, &posCorr, &velCorr, &accBiasCorr));
+    EXPECT_FLOAT_EQ(0.0f, posCorr.x);
+    EXPECT_FLOAT_EQ(0.0f, velCorr.x);
+
+    // Neither does one taken between the last sample and now
+    fix.time = now - 5000;
+    fix.pos = vec(US2S(fix.time) * 100.0f, 0, 0);
+    EXPECT_NEAR(0.0f, posEstimatorHistoryCorrectXY(&history, &fix, &estPos, &vel, now, 1.0f, 2.0f, 0.01f, &posCorr, &velCorr, &accBiasCorr), 1e-3f);
+    EXPECT_NEAR(0.0f, posCorr.x, 1e-5f);
+}
+
+TEST(PosEstimatorHistoryTest, TestTooOldMeasurementIsNotRepropagated)
+{
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    const fpVector3_t zero = vec(0, 0, 0);
+    for (int i = 10; i < 20; i++) {
+        posEstimatorHistoryStore(&history, i * POS_ESTIMATOR_HISTORY_INTERVAL_US, &zero, &zero);
+    }
+
+    // Older than the history, taken against the current estimate as it is
+    posEstimatorDelayedMeasurement_t fix;
+    fix.pos = zero;
+    fix.vel = vec(100, 0, 0);
+    fix.velValid = true;
+    fix.time = POS_ESTIMATOR_HISTORY_INTERVAL_US;
+
+    fpVector3_t posCorr = zero;
+    fpVector3_t velCorr = zero;
+    fpVector3_t accBiasCorr = zero;
+    posEstimatorHistoryCorrectXY(&history, &fix, &zero, &zero, 20 * POS_ESTIMATOR_HISTORY_INTERVAL_US, 1.0f, 2.0f, 0.01f, &posCorr, &velCorr, &accBiasCorr);
+    EXPECT_FLOAT_EQ(2.0f, velCorr.x);
+    EXPECT_FLOAT_EQ(0.0f, posCorr.x);
+}
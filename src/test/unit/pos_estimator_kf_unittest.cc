@@ -0,0 +1,254 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+extern "C" {
+#include "common/maths.h"
+#include "common/time.h"
+#include "common/vector.h"
+#include "navigation/navigation_pos_estimator_history.h"
+#include "navigation/navigation_pos_estimator_kf.h"
+}
+
+#include "gtest/gtest.h"
+
+#define N POS_EST_KF_STATE_COUNT
+
+// Dense reference: P = F * P * F' + Q
+static void densePredict(float P[N][N], float dt, float accNoise, float accBiasNoise)
+{
+    const float F[N][N] = {
+        { 1, dt, -dt * dt / 2 },
+        { 0, 1, -dt },
+        { 0, 0, 1 },
+    };
+    const float q = accNoise * accNoise;
+    const float Q[N][N] = {
+        { q * dt * dt * dt / 3, q * dt * dt / 2, 0 },
+        { q * dt * dt / 2, q * dt, 0 },
+        { 0, 0, accBiasNoise * accBiasNoise * dt },
+    };
+
+    float A[N][N] = { { 0 } };
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++)
+            for (int k = 0; k < N; k++)
+                A[i][j] += F[i][k] * P[k][j];
+
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < N; j++) {
+            float sum = Q[i][j];
+            for (int k = 0; k < N; k++)
+                sum += A[i][k] * F[j][k];
+            P[i][j] = sum;
+        }
+}
+
+static float randn(uint32_t * seed)
+{
+    // Box-Muller on a LCG, deterministic across runs
+    *seed = *seed * 1103515245 + 12345;
+    const float u1 = ((*seed >> 8) + 1.0f) / 16777217.0f;
+    *seed = *seed * 1103515245 + 12345;
+    const float u2 = (*seed >> 8) / 16777216.0f;
+    return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * M_PIf * u2);
+}
+
+TEST(PosEstimatorKFTest, TestPredictMatchesDense)
+{
+    posEstimatorKFAxis_t kf;
+    posEstimatorKFAxisReset(&kf, 100.0f, 25.0f, 4.0f);
+    kf.P[0][1] = kf.P[1][0] = 10.0f;
+    kf.P[1][2] = kf.P[2][1] = -2.0f;
+
+    float P[N][N];
+    memcpy(P, kf.P, sizeof(P));
+
+    for (int i = 0; i < 1000; i++) {
+        posEstimatorKFAxisPredict(&kf, 0.001f, 50.0f, 2.0f, 1e9f);
+        densePredict(P, 0.001f, 50.0f, 2.0f);
+    }
+
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            EXPECT_NEAR(P[i][j], kf.P[i][j], 1e-3f * fabsf(P[i][j]) + 1e-4f);
+            EXPECT_FLOAT_EQ(kf.P[i][j], kf.P[j][i]);
+        }
+    }
+}
+
+TEST(PosEstimatorKFTest, TestPositionVarianceCap)
+{
+    posEstimatorKFAxis_t kf;
+    posEstimatorKFAxisReset(&kf, 100.0f, 100.0f, 1.0f);
+
+    for (int i = 0; i < 100000; i++) {
+        posEstimatorKFAxisPredict(&kf, 0.01f, 100.0f, 1.0f, 1e6f);
+    }
+
+    EXPECT_FLOAT_EQ(1e6f, kf.P[0][0]);
+    // Still a valid covariance
+    EXPECT_LE(sq(kf.P[0][1]), kf.P[0][0] * kf.P[1][1]);
+    EXPECT_LE(sq(kf.P[0][2]), kf.P[0][0] * kf.P[2][2]);
+}
+
+TEST(PosEstimatorKFTest, TestCorrection)
+{
+    posEstimatorKFAxis_t kf;
+    posEstimatorKFAxisReset(&kf, 100.0f, 25.0f, 4.0f);
+
+    float corr[N];
+    posEstimatorKFAxisCorrect(&kf, POS_EST_KF_POS, 10.0f, 100.0f, corr);
+
+    // Equal prior and measurement variance - half way
+    EXPECT_FLOAT_EQ(5.0f, corr[POS_EST_KF_POS]);
+    EXPECT_FLOAT_EQ(0.0f, corr[POS_EST_KF_VEL]);
+    EXPECT_FLOAT_EQ(50.0f, kf.P[0][0]);
+    EXPECT_FLOAT_EQ(25.0f, kf.P[1][1]);
+}
+
+TEST(PosEstimatorKFTest, TestAccelerometerBiasConverges)
+{
+    posEstimatorKFAxis_t kf;
+    posEstimatorKFAxisReset(&kf, 100.0f, 100.0f, 100.0f);
+    kf.accBias = 0;
+
+    // Stationary, accelerometer reads 15cm/s/s, position measured at 10Hz
+    const float dt = 0.001f;
+    float pos = 0, vel = 0;
+    for (int i = 0; i < 60000; i++) {
+        const float acc = 15.0f - kf.accBias;
+        pos += vel * dt + acc * dt * dt / 2;
+        vel += acc * dt;
+        posEstimatorKFAxisPredict(&kf, dt, 20.0f, 0.5f, 1e8f);
+
+        if (i % 100 == 0) {
+            float corr[N];
+            posEstimatorKFAxisCorrect(&kf, POS_EST_KF_POS, 0.0f - pos, sq(50.0f), corr);
+            pos += corr[POS_EST_KF_POS];
+            vel += corr[POS_EST_KF_VEL];
+        }
+    }
+
+    EXPECT_NEAR(15.0f, kf.accBias, 1.5f);
+    EXPECT_NEAR(0.0f, vel, 5.0f);
+}
+
+/*
+ * Fixed wing turning at 20m/s on a 60m radius. Accelerometer is noisy and
+ * biased, GPS runs at 5Hz with 150cm/30cm/s noise and arrives 150ms late.
+ * Both estimators use the state history for the delayed fix, the complementary
+ * filter uses the default inav_w_xy_gps_p/v weights and inav_w_acc_bias.
+ * Returns the RMS horizontal position error.
+ */
+static float replayTurn(bool useKalman)
+{
+    const timeUs_t loopUs = 1000;
+    const timeUs_t fixIntervalUs = 200000;
+    const timeUs_t fixDelayUs = 150000;
+    const float radius = 6000.0f;
+    const float omega = 2000.0f / radius;
+    const float accBias[2] = { 30.0f, -20.0f };
+    const float gpsPosStd = 150.0f;
+    const float gpsVelStd = 30.0f;
+
+    uint32_t seed = 42;
+
+    posEstimatorHistory_t history;
+    posEstimatorHistoryReset(&history);
+
+    posEstimatorKFAxis_t kf[2];
+    float cfBias[2] = { 0, 0 };
+    for (int axis = 0; axis < 2; axis++) {
+        posEstimatorKFAxisReset(&kf[axis], sq(gpsPosStd), sq(gpsVelStd), sq(50.0f));
+        kf[axis].accBias = 0;
+    }
+
+    fpVector3_t estPos = { .v = { radius, 0, 0 } };
+    fpVector3_t estVel = { .v = { 0, radius * omega, 0 } };
+    float gpsPos[2] = { radius, 0 };
+    float gpsVel[2] = { 0, radius * omega };
+    timeUs_t gpsTime = 0;
+    timeUs_t lastFixArrival = 0;
+    bool newFix = false;
+
+    double errSq = 0;
+    int errCount = 0;
+
+    for (timeUs_t t = loopUs; t < 60000000; t += loopUs) {
+        const float dt = US2S(loopUs);
+        const float ts = US2S(t);
+
+        if (t >= fixDelayUs && t - lastFixArrival >= fixIntervalUs) {
+            gpsTime = t - fixDelayUs;
+            const float a = omega * US2S(gpsTime);
+            gpsPos[0] = radius * cosf(a) + randn(&seed) * gpsPosStd;
+            gpsPos[1] = radius * sinf(a) + randn(&seed) * gpsPosStd;
+            gpsVel[0] = -radius * omega * sinf(a) + randn(&seed) * gpsVelStd;
+            gpsVel[1] = radius * omega * cosf(a) + randn(&seed) * gpsVelStd;
+            lastFixArrival = t;
+            newFix = true;
+        }
+
+        const float trueAcc[2] = { -radius * omega * omega * cosf(omega * ts), -radius * omega * omega * sinf(omega * ts) };
+
+        fpVector3_t refPos, refVel;
+        if (!posEstimatorHistoryGet(&history, gpsTime, &estPos, &estVel, t - loopUs, &refPos, &refVel)) {
+            refPos = estPos;
+            refVel = estVel;
+        }
+
+        fpVector3_t posCorr = { .v = { 0, 0, 0 } };
+        fpVector3_t velCorr = { .v = { 0, 0, 0 } };
+
+        for (int axis = 0; axis < 2; axis++) {
+            const float acc = trueAcc[axis] + accBias[axis] + randn(&seed) * 50.0f - (useKalman ? kf[axis].accBias : cfBias[axis]);
+            estPos.v[axis] += estVel.v[axis] * dt + acc * dt * dt / 2;
+            estVel.v[axis] += acc * dt;
+
+            if (useKalman) {
+                posEstimatorKFAxisPredict(&kf[axis], dt, 50.0f, 1.0f, 1e8f);
+
+                // Each fix is fused once, sequentially for position and velocity
+                if (newFix) {
+                    float corr[N];
+                    posEstimatorKFAxisCorrect(&kf[axis], POS_EST_KF_POS, gpsPos[axis] - refPos.v[axis], sq(gpsPosStd), corr);
+                    posCorr.v[axis] += corr[POS_EST_KF_POS];
+                    velCorr.v[axis] += corr[POS_EST_KF_VEL];
+
+                    posEstimatorKFAxisCorrect(&kf[axis], POS_EST_KF_VEL, gpsVel[axis] - refVel.v[axis] - velCorr.v[axis], sq(gpsVelStd), corr);
+                    posCorr.v[axis] += corr[POS_EST_KF_POS];
+                    velCorr.v[axis] += corr[POS_EST_KF_VEL];
+                }
+            }
+            else {
+                const float w_p = 1.0f, w_v = 2.0f, w_acc_bias = 0.01f;
+                const float posResidual = gpsPos[axis] - refPos.v[axis];
+                posCorr.v[axis] = posResidual * w_p * dt;
+                velCorr.v[axis] = (posResidual * w_p * w_p + (gpsVel[axis] - refVel.v[axis]) * w_v) * dt;
+                cfBias[axis] -= posResidual * w_p * w_p * w_acc_bias * dt;
+            }
+        }
+        newFix = false;
+
+        vectorAdd(&estPos, &estPos, &posCorr);
+        vectorAdd(&estVel, &estVel, &velCorr);
+        posEstimatorHistoryApplyCorrection(&history, &posCorr, &velCorr);
+        posEstimatorHistoryStore(&history, t, &estPos, &estVel);
+
+        if (t > 20000000) {
+            errSq += sq(estPos.x - radius * cosf(omega * ts)) + sq(estPos.y - radius * sinf(omega * ts));
+            errCount++;
+        }
+    }
+
+    return sqrtf(errSq / errCount);
+}
+
+TEST(PosEstimatorKFTest, TestNoisyTurnReplay)
+{
+    const float errComplementary = replayTurn(false);
+    const float errKalman = replayTurn(true);
+
+    EXPECT_LT(errKalman, errComplementary);
+}
@@ -146,4 +146,5 @@ timeDelta_t getLooptime(void) {return gyro.targetLooptime;}
 timeDelta_t getGyroLooptime(void) {return gyro.targetLooptime;}
 void sensorsSet(uint32_t) {}
 void schedulerResetTaskStatistics(cfTaskId_e) {}
+void busSetPriority(busDevice_t *, busPriority_e, timeDelta_t) {}
 }